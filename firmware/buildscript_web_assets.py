@@ -0,0 +1,80 @@
+import gzip
+import hashlib
+import os
+
+Import("env")
+
+# The web UI served by the ESP32 web server (WEB_SERVER). Each file is gzipped into a generated header; index.html
+# references the others with a content hash in the URL, so they can be cached indefinitely.
+FRONTEND_DIR = os.path.join(env.subst("$PROJECT_DIR"), "software", "chainlink", "frontend", "esp32")
+INDEX = "index.html"
+ASSETS = [
+    ("styles.css", "text/css"),
+    ("app.js", "application/javascript"),
+]
+
+OUTPUT_DIR = os.path.join(env.subst("$BUILD_DIR"), "web_assets")
+OUTPUT_FILE = os.path.join(OUTPUT_DIR, "web_assets_data.h")
+
+
+def content_hash(data):
+    return hashlib.sha256(data).hexdigest()[:16]
+
+
+def c_array(name, data):
+    lines = []
+    for i in range(0, len(data), 20):
+        lines.append("    " + ", ".join("0x{:02x}".format(b) for b in data[i:i + 20]) + ",")
+    return "static const uint8_t {}[] PROGMEM = {{\n{}\n}};\n".format(name, "\n".join(lines))
+
+
+def generate():
+    entries = []
+    index = open(os.path.join(FRONTEND_DIR, INDEX), "rb").read()
+    for (filename, content_type) in ASSETS:
+        data = open(os.path.join(FRONTEND_DIR, filename), "rb").read()
+        digest = content_hash(data)
+        reference = '"{}"'.format(filename).encode()
+        assert reference in index, "{} doesn't reference {}".format(INDEX, filename)
+        index = index.replace(reference, '"{}?v={}"'.format(filename, digest).encode())
+        entries.append(("/" + filename, content_type, digest, True, data))
+    entries.insert(0, ("/", "text/html", content_hash(index), False, index))
+
+    arrays = []
+    table = []
+    raw_size = 0
+    gzip_size = 0
+    for (i, (path, content_type, digest, immutable, data)) in enumerate(entries):
+        # Fixed mtime so identical content always produces the same bytes
+        compressed = gzip.compress(data, compresslevel=9, mtime=0)
+        raw_size += len(data)
+        gzip_size += len(compressed)
+        name = "WEB_ASSET_DATA_{}".format(i)
+        arrays.append(c_array(name, compressed))
+        table.append('    {{"{}", "{}", "\\"{}\\"", {}, {}, sizeof({})}},'.format(
+            path, content_type, digest, "true" if immutable else "false", name, name))
+
+    header = "\n".join([
+        "// Generated by firmware/buildscript_web_assets.py from software/chainlink/frontend/esp32; do not edit",
+        "#pragma once",
+        "",
+        '#include "web_assets.h"',
+        "",
+        "\n".join(arrays),
+        "static const WebAsset WEB_ASSETS[] = {",
+        "\n".join(table),
+        "};",
+        "",
+    ])
+
+    os.makedirs(OUTPUT_DIR, exist_ok=True)
+    # Only touch the header when it changes, so the web server isn't rebuilt every time
+    if not os.path.exists(OUTPUT_FILE) or open(OUTPUT_FILE).read() != header:
+        with open(OUTPUT_FILE, "w") as f:
+            f.write(header)
+    print("Web assets: {} bytes, {} gzipped".format(raw_size, gzip_size))
+
+
+generate()
+
+env.Append(CPPPATH=[OUTPUT_DIR])
@@ -232,7 +232,7 @@ void BaseSupervisorTask::runStateNormal() {
 
     uint8_t moving[NUM_POWER_CHANNELS] = {};
     uint8_t homing[NUM_POWER_CHANNELS] = {};
-    for (uint8_t i = 0; i < NUM_MODULES; i++) {
+    for (uint8_t i = 0; i < splitflap_state_.num_modules; i++) {
         uint8_t power_channel = getPowerChannelForModuleIndex(i);
         if (splitflap_state_.modules[i].moving) {
             if (splitflap_state_.modules[i].state == State::LOOK_FOR_HOME) {
@@ -353,7 +353,16 @@ void BaseSupervisorTask::readPower() {
 }
 
 void BaseSupervisorTask::updateSplitflapState() {
-    splitflap_state_ = splitflap_task_.getState();
+    if (splitflap_state_subscriber_ < 0) {
+        splitflap_state_subscriber_ = splitflap_task_.subscribeState();
+        assert(splitflap_state_subscriber_ >= 0);
+    }
+
+    // Power is sampled every loop regardless, so this only avoids copying the state when it hasn't changed
+    splitflap_task_.takeStateChanges(splitflap_state_subscriber_, splitflap_state_changes_);
+    if (splitflap_state_changes_.any() && splitflap_task_.getStateIfChanged(splitflap_state_version_, splitflap_state_)) {
+        splitflap_state_changes_ = {};
+    }
 }
 
 void BaseSupervisorTask::fault(PB_SupervisorState_FaultInfo_FaultType type, const char* msg) {
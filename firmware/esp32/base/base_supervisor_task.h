@@ -57,7 +57,10 @@ class BaseSupervisorTask : public Task<BaseSupervisorTask> {
         PB_SupervisorState_State state_ = PB_SupervisorState_State_UNKNOWN;
         PB_SupervisorState_FaultInfo fault_info_;
 
-        SplitflapState splitflap_state_;
+        SplitflapState splitflap_state_ = {};
+        uint32_t splitflap_state_version_ = 0;
+        int8_t splitflap_state_subscriber_ = -1;
+        StateChanges splitflap_state_changes_ = {};
         float voltage_volts_[NUM_POWER_CHANNELS] = {};
         float current_amps_[NUM_POWER_CHANNELS] = {};
         bool channel_on_[NUM_POWER_CHANNELS] = {};
@@ -0,0 +1,168 @@
+/*
+   Copyright 2021 Scott Bezek and the splitflap contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "command_mailbox.h"
+
+SubmitResult CommandMailbox::setTarget(uint8_t module, const ModuleTarget& target) {
+    if (module >= NUM_MODULES || (!target.is_config && target.flap_index >= NUM_FLAPS)) {
+        return recordRejected();
+    }
+
+    uint32_t value = SLOT_PENDING
+        | (target.force_full_rotation ? (1UL << 25) : 0)
+        | (target.is_config ? (1UL << 24) : 0)
+        | ((uint32_t)target.reset_nonce << 16)
+        | ((uint32_t)target.movement_nonce << 8)
+        | target.flap_index;
+    uint32_t previous = targets_[module].exchange(value, std::memory_order_acq_rel);
+    return recordSubmit(previous != 0);
+}
+
+SubmitResult CommandMailbox::addActions(uint8_t module, uint32_t flags) {
+    return updateActions(module, flags, 0, 0, false, 0);
+}
+
+SubmitResult CommandMailbox::setLed(uint8_t module, bool on) {
+    return updateActions(module, on ? ACTION_LED_ON : ACTION_LED_OFF, on ? ACTION_LED_OFF : ACTION_LED_ON, 0, false, 0);
+}
+
+SubmitResult CommandMailbox::increaseOffset(uint8_t module, uint8_t tenths) {
+    return updateActions(module, 0, 0, tenths, false, 0);
+}
+
+SubmitResult CommandMailbox::restoreOffset(uint8_t module, uint16_t offset) {
+    return updateActions(module, ACTION_RESTORE_OFFSET, 0, 0, true, offset);
+}
+
+SubmitResult CommandMailbox::setSensorTest(bool sensor_test) {
+    return sensor_test
+        ? updateGlobal(GLOBAL_SENSOR_TEST_SET, GLOBAL_SENSOR_TEST_CLEAR)
+        : updateGlobal(GLOBAL_SENSOR_TEST_CLEAR, GLOBAL_SENSOR_TEST_SET);
+}
+
+SubmitResult CommandMailbox::saveAllOffsets() {
+    return updateGlobal(GLOBAL_SAVE_ALL_OFFSETS, 0);
+}
+
+SubmitResult CommandMailbox::updateActions(uint8_t module, uint32_t set_flags, uint32_t clear_flags, uint8_t add_tenths, bool restore, uint16_t offset) {
+    if (module >= NUM_MODULES) {
+        return recordRejected();
+    }
+
+    uint32_t previous = actions_[module].load(std::memory_order_relaxed);
+    uint32_t value;
+    do {
+        uint32_t flags = ((previous & 0xFF) & ~clear_flags) | set_flags;
+        uint32_t tenths = min((uint32_t)255, ((previous >> 8) & 0xFF) + add_tenths);
+        uint32_t restore_offset = restore ? offset : (previous >> 16);
+        value = (restore_offset << 16) | (tenths << 8) | flags;
+    } while (!actions_[module].compare_exchange_weak(previous, value, std::memory_order_acq_rel, std::memory_order_relaxed));
+
+    return recordSubmit(previous != 0);
+}
+
+SubmitResult CommandMailbox::updateGlobal(uint32_t set_flags, uint32_t clear_flags) {
+    uint32_t previous = global_.load(std::memory_order_relaxed);
+    while (!global_.compare_exchange_weak(previous, (previous & ~clear_flags) | set_flags, std::memory_order_acq_rel, std::memory_order_relaxed)) {}
+    return recordSubmit(previous != 0);
+}
+
+SubmitResult CommandMailbox::recordSubmit(bool was_pending) {
+    submitted_.fetch_add(1, std::memory_order_relaxed);
+    if (was_pending) {
+        coalesced_.fetch_add(1, std::memory_order_relaxed);
+        return SubmitResult::COALESCED;
+    }
+
+    // Publish after the slot is written, so the consumer's hasPending() can't miss it
+    int32_t depth = depth_.fetch_add(1, std::memory_order_release) + 1;
+    uint16_t max_depth = max_depth_.load(std::memory_order_relaxed);
+    while (depth > max_depth && !max_depth_.compare_exchange_weak(max_depth, depth, std::memory_order_relaxed)) {}
+    return SubmitResult::QUEUED;
+}
+
+SubmitResult CommandMailbox::recordRejected() {
+    rejected_.fetch_add(1, std::memory_order_relaxed);
+    return SubmitResult::REJECTED;
+}
+
+uint32_t CommandMailbox::takeGlobal() {
+    if (global_.load(std::memory_order_relaxed) == 0) {
+        return 0;
+    }
+    uint32_t value = global_.exchange(0, std::memory_order_acq_rel);
+    if (value != 0) {
+        depth_.fetch_sub(1, std::memory_order_relaxed);
+    }
+    return value;
+}
+
+bool CommandMailbox::takeActions(uint8_t module, ModuleActions& out) {
+    if (actions_[module].load(std::memory_order_relaxed) == 0) {
+        return false;
+    }
+    uint32_t value = actions_[module].exchange(0, std::memory_order_acq_rel);
+    if (value == 0) {
+        return false;
+    }
+    depth_.fetch_sub(1, std::memory_order_relaxed);
+
+    out.flags = value & 0xFF;
+    out.offset_tenths = (value >> 8) & 0xFF;
+    out.restore_offset = value >> 16;
+    return true;
+}
+
+bool CommandMailbox::takeTarget(uint8_t module, ModuleTarget& out) {
+    if (targets_[module].load(std::memory_order_relaxed) == 0) {
+        return false;
+    }
+    uint32_t value = targets_[module].exchange(0, std::memory_order_acq_rel);
+    if (value == 0) {
+        return false;
+    }
+    depth_.fetch_sub(1, std::memory_order_relaxed);
+
+    out.force_full_rotation = (value >> 25) & 1;
+    out.is_config = (value >> 24) & 1;
+    out.reset_nonce = (value >> 16) & 0xFF;
+    out.movement_nonce = (value >> 8) & 0xFF;
+    out.flap_index = value & 0xFF;
+    return true;
+}
+
+void CommandMailbox::finishDrain(uint16_t batch_size) {
+    if (batch_size == 0) {
+        return;
+    }
+    drains_.fetch_add(1, std::memory_order_relaxed);
+    if (batch_size > max_batch_.load(std::memory_order_relaxed)) {
+        max_batch_.store(batch_size, std::memory_order_relaxed);
+    }
+}
+
+MailboxStats CommandMailbox::getStats() {
+    int32_t depth = depth_.load(std::memory_order_relaxed);
+    return {
+        .submitted = submitted_.load(std::memory_order_relaxed),
+        .coalesced = coalesced_.load(std::memory_order_relaxed),
+        .rejected = rejected_.load(std::memory_order_relaxed),
+        .drains = drains_.load(std::memory_order_relaxed),
+        // May be transiently negative if the consumer drains a slot before its producer has counted it
+        .depth = (uint16_t)(depth < 0 ? 0 : depth),
+        .max_depth = max_depth_.load(std::memory_order_relaxed),
+        .max_batch = max_batch_.load(std::memory_order_relaxed),
+    };
+}
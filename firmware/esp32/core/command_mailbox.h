@@ -0,0 +1,147 @@
+/*
+   Copyright 2021 Scott Bezek and the splitflap contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#pragma once
+
+#include <atomic>
+
+#include "config.h"
+
+enum class SubmitResult {
+    // Accepted; nothing was pending for the affected module(s)
+    QUEUED,
+    // Accepted and merged with command(s) that hadn't been processed yet
+    COALESCED,
+    // Invalid module/flap index; nothing was submitted
+    REJECTED,
+};
+
+// Combines the results of a multi-module submission, keeping the most notable outcome
+inline SubmitResult mergeSubmitResult(SubmitResult a, SubmitResult b) {
+    return (a > b) ? a : b;
+}
+
+struct MailboxStats {
+    // Number of module/global slot updates accepted
+    uint32_t submitted;
+    // Number of those that merged into a slot that was still pending
+    uint32_t coalesced;
+    // Number of submissions rejected as invalid
+    uint32_t rejected;
+    // Number of drain passes that found pending work
+    uint32_t drains;
+    // Slots currently pending, and the high-water marks for pending slots and slots handled in one drain
+    uint16_t depth;
+    uint16_t max_depth;
+    uint16_t max_batch;
+};
+
+/**
+ * Lock-free, multi-producer/single-consumer command mailbox for SplitflapTask.
+ *
+ * Rather than a FIFO of whole-display commands, each module has two slots that producers update with atomic
+ * operations, so submitting never blocks and never runs out of space:
+ *  - a target slot (flap index or SplitflapConfig entry); a newer target replaces a pending one (latest wins)
+ *  - an action slot; action flags are OR'd together and offset increments accumulate
+ * plus a global slot for sensor test mode and saving offsets.
+ *
+ * The consumer (the splitflap task) drains every pending slot in a single pass.
+ */
+class CommandMailbox {
+    public:
+        // Per-module action flags
+        enum : uint32_t {
+            ACTION_RESET_AND_HOME = 1 << 0,
+            ACTION_DISABLE = 1 << 1,
+            ACTION_SET_OFFSET = 1 << 2,
+            ACTION_LED_ON = 1 << 3,
+            ACTION_LED_OFF = 1 << 4,
+            ACTION_RESTORE_OFFSET = 1 << 5,
+        };
+
+        // Global flags
+        enum : uint32_t {
+            GLOBAL_SENSOR_TEST_SET = 1 << 0,
+            GLOBAL_SENSOR_TEST_CLEAR = 1 << 1,
+            GLOBAL_SAVE_ALL_OFFSETS = 1 << 2,
+        };
+
+        struct ModuleTarget {
+            // If true, this is a SplitflapConfig entry (target + nonces); otherwise a plain flap index
+            bool is_config;
+            // For a plain flap index: move even if the module is already headed there
+            bool force_full_rotation;
+            uint8_t flap_index;
+            uint8_t movement_nonce;
+            uint8_t reset_nonce;
+        };
+
+        struct ModuleActions {
+            uint32_t flags;
+            // Accumulated offset increase, in tenths of a flap (saturates at 255)
+            uint8_t offset_tenths;
+            // Valid if flags has ACTION_RESTORE_OFFSET
+            uint16_t restore_offset;
+        };
+
+        CommandMailbox() {}
+        CommandMailbox(CommandMailbox const&)=delete;
+        CommandMailbox& operator=(CommandMailbox const&)=delete;
+
+        // Producer API - safe to call from any task; never blocks.
+        SubmitResult setTarget(uint8_t module, const ModuleTarget& target);
+        SubmitResult addActions(uint8_t module, uint32_t flags);
+        SubmitResult setLed(uint8_t module, bool on);
+        SubmitResult increaseOffset(uint8_t module, uint8_t tenths);
+        SubmitResult restoreOffset(uint8_t module, uint16_t offset);
+        SubmitResult setSensorTest(bool sensor_test);
+        SubmitResult saveAllOffsets();
+
+        MailboxStats getStats();
+
+        // Consumer API - must only be called from the single consumer task.
+        bool hasPending() {
+            return depth_.load(std::memory_order_acquire) != 0;
+        }
+        uint32_t takeGlobal();
+        bool takeActions(uint8_t module, ModuleActions& out);
+        bool takeTarget(uint8_t module, ModuleTarget& out);
+        void finishDrain(uint16_t batch_size);
+
+    private:
+        enum : uint32_t {
+            SLOT_PENDING = 1UL << 31,
+        };
+
+        // Action slot layout: bits 0-7 flags, 8-15 offset tenths, 16-31 restore offset
+        // Target slot layout: bits 0-7 flap index, 8-15 movement nonce, 16-23 reset nonce, 24 is_config,
+        // 25 force_full_rotation, 31 pending
+        std::atomic<uint32_t> actions_[NUM_MODULES] = {};
+        std::atomic<uint32_t> targets_[NUM_MODULES] = {};
+        std::atomic<uint32_t> global_ = {};
+
+        std::atomic<int32_t> depth_ = {};
+        std::atomic<uint32_t> submitted_ = {};
+        std::atomic<uint32_t> coalesced_ = {};
+        std::atomic<uint32_t> rejected_ = {};
+        std::atomic<uint32_t> drains_ = {};
+        std::atomic<uint16_t> max_depth_ = {};
+        std::atomic<uint16_t> max_batch_ = {};
+
+        SubmitResult updateActions(uint8_t module, uint32_t set_flags, uint32_t clear_flags, uint8_t add_tenths, bool restore, uint16_t offset);
+        SubmitResult updateGlobal(uint32_t set_flags, uint32_t clear_flags);
+        SubmitResult recordSubmit(bool was_pending);
+        SubmitResult recordRejected();
+};
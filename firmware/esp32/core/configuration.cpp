@@ -26,6 +26,8 @@
 
 static const char* CONFIG_PATH = "/config.pb";
 
+SemaphoreHandle_t FatGuard::semaphore_ = xSemaphoreCreateMutex();
+
 Configuration::Configuration() {
   mutex_ = xSemaphoreCreateMutex();
   assert(mutex_ != NULL);
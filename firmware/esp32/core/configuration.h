@@ -46,9 +46,12 @@ class Configuration {
 
         void log(const char* msg);
 };
+// Mounts FFat for the guard's lifetime. Only one guard exists at a time (others wait), so nobody unmounts it from under
+// someone else.
 class FatGuard {
     public:
         FatGuard(Logger* logger) : logger_(logger) {
+            xSemaphoreTake(semaphore_, portMAX_DELAY);
             if (!FFat.begin(true)) {
                 if (logger_ != nullptr) {
                     logger_->log("Failed to mount FFat");
@@ -67,6 +70,7 @@ class FatGuard {
                     logger_->log("Unmounted FFat");
                 }
             }
+            xSemaphoreGive(semaphore_);
         }
         FatGuard(FatGuard const&)=delete;
         FatGuard& operator=(FatGuard const&)=delete;
@@ -74,5 +78,6 @@ class FatGuard {
         bool mounted_ = false;
 
     private:
+        static SemaphoreHandle_t semaphore_;
         Logger* logger_;
 };
@@ -0,0 +1,48 @@
+/*
+   Copyright 2024 Scott Bezek and the splitflap contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * Fixed-bucket histogram of durations, cheap enough to record into from the motor loop. The bucket bounds are shared by
+ * every histogram so they can be compared (and exported) directly.
+ *
+ * Not synchronized; publish copies (e.g. with a SnapshotBuffer) to read one from another task.
+ */
+struct MicrosHistogram {
+    enum : uint8_t {
+        NUM_BUCKETS = 12,
+    };
+
+    // Inclusive upper bound of each bucket but the last, which catches everything else
+    static const uint32_t BUCKET_BOUNDS_MICROS[NUM_BUCKETS - 1];
+
+    // Number of durations in each bucket (not cumulative)
+    uint32_t counts[NUM_BUCKETS];
+    uint32_t count;
+    uint64_t sum_micros;
+
+    void record(uint32_t micros) {
+        uint8_t bucket = 0;
+        while (bucket < NUM_BUCKETS - 1 && micros > BUCKET_BOUNDS_MICROS[bucket]) {
+            bucket++;
+        }
+        counts[bucket]++;
+        count++;
+        sum_micros += micros;
+    }
+};
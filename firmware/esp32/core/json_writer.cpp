@@ -0,0 +1,183 @@
+/*
+   Copyright 2024 Scott Bezek and the splitflap contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "json_writer.h"
+
+void JsonWriter::separator() {
+    if (after_key_) {
+        after_key_ = false;
+        return;
+    }
+    if (depth_ == 0) {
+        return;
+    }
+    uint32_t bit = 1UL << (depth_ - 1);
+    if (has_items_ & bit) {
+        out_.write(',');
+    }
+    has_items_ |= bit;
+}
+
+void JsonWriter::begin(char bracket) {
+    separator();
+    out_.write(bracket);
+    assert(depth_ < MAX_DEPTH);
+    depth_++;
+    has_items_ &= ~(1UL << (depth_ - 1));
+}
+
+void JsonWriter::end(char bracket) {
+    assert(depth_ > 0);
+    depth_--;
+    out_.write(bracket);
+}
+
+JsonWriter& JsonWriter::beginObject() {
+    begin('{');
+    return *this;
+}
+
+JsonWriter& JsonWriter::beginObject(const char* key) {
+    this->key(key);
+    return beginObject();
+}
+
+JsonWriter& JsonWriter::endObject() {
+    end('}');
+    return *this;
+}
+
+JsonWriter& JsonWriter::beginArray() {
+    begin('[');
+    return *this;
+}
+
+JsonWriter& JsonWriter::beginArray(const char* key) {
+    this->key(key);
+    return beginArray();
+}
+
+JsonWriter& JsonWriter::endArray() {
+    end(']');
+    return *this;
+}
+
+JsonWriter& JsonWriter::key(const char* key) {
+    separator();
+    writeString(key, strlen(key));
+    out_.write(':');
+    after_key_ = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(const char* str) {
+    return value(str, strlen(str));
+}
+
+JsonWriter& JsonWriter::value(const char* str, size_t length) {
+    separator();
+    writeString(str, length);
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(char c) {
+    return value(&c, 1);
+}
+
+JsonWriter& JsonWriter::value(bool b) {
+    separator();
+    out_.print(b ? "true" : "false");
+    return *this;
+}
+
+JsonWriter& JsonWriter::nullValue() {
+    separator();
+    out_.print("null");
+    return *this;
+}
+
+void JsonWriter::writeString(const char* str, size_t length) {
+    static const char HEX_DIGITS[] = "0123456789abcdef";
+
+    out_.write('"');
+    // Write runs of characters that don't need escaping in one go
+    size_t run_start = 0;
+    for (size_t i = 0; i < length; i++) {
+        uint8_t c = str[i];
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            continue;
+        }
+        out_.write((const uint8_t*)str + run_start, i - run_start);
+        run_start = i + 1;
+        switch (c) {
+            case '"':
+                out_.print("\\\"");
+                break;
+            case '\\':
+                out_.print("\\\\");
+                break;
+            case '\n':
+                out_.print("\\n");
+                break;
+            case '\r':
+                out_.print("\\r");
+                break;
+            case '\t':
+                out_.print("\\t");
+                break;
+            default: {
+                char escaped[] = {'\\', 'u', '0', '0', HEX_DIGITS[c >> 4], HEX_DIGITS[c & 0xF]};
+                out_.write((const uint8_t*)escaped, sizeof(escaped));
+                break;
+            }
+        }
+    }
+    out_.write((const uint8_t*)str + run_start, length - run_start);
+    out_.write('"');
+}
+
+size_t BufferPrint::write(uint8_t b) {
+    return write(&b, 1);
+}
+
+size_t BufferPrint::write(const uint8_t *buffer, size_t size) {
+    size_t count = min(size, size_ - 1 - length_);
+    if (count < size) {
+        overflowed_ = true;
+    }
+    memcpy(buffer_ + length_, buffer, count);
+    length_ += count;
+    buffer_[length_] = '\0';
+    return count;
+}
+
+size_t WindowPrint::write(uint8_t b) {
+    return write(&b, 1);
+}
+
+size_t WindowPrint::write(const uint8_t *buffer, size_t size) {
+    // Everything from the start of the window up to here has been kept, so the next byte to keep is at next
+    size_t start = position_;
+    size_t next = offset_ + length_;
+    position_ += size;
+    if (position_ <= next || length_ == size_) {
+        return size;
+    }
+    size_t skip = next > start ? next - start : 0;
+    size_t count = min(size - skip, size_ - length_);
+    memcpy(buffer_ + length_, buffer + skip, count);
+    length_ += count;
+    return size;
+}
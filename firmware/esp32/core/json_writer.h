@@ -0,0 +1,135 @@
+/*
+   Copyright 2024 Scott Bezek and the splitflap contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#pragma once
+
+#include <Arduino.h>
+#include <type_traits>
+
+/**
+ * Minimal streaming JSON writer. Values go straight to a Print (a serial stream, an HTTP response, or a fixed buffer
+ * via BufferPrint) as they're added, without building a document or any Strings first.
+ *
+ * Commas are inserted automatically; the caller is responsible for balancing begin/end calls and for using key()
+ * (or the key overloads) only inside objects.
+ */
+class JsonWriter {
+    public:
+        explicit JsonWriter(Print& out) : out_(out) {}
+
+        JsonWriter& beginObject();
+        JsonWriter& beginObject(const char* key);
+        JsonWriter& endObject();
+        JsonWriter& beginArray();
+        JsonWriter& beginArray(const char* key);
+        JsonWriter& endArray();
+
+        JsonWriter& key(const char* key);
+
+        JsonWriter& value(const char* str);
+        // String of the given length (which may include nulls)
+        JsonWriter& value(const char* str, size_t length);
+        // Single character string
+        JsonWriter& value(char c);
+        JsonWriter& value(bool b);
+        JsonWriter& nullValue();
+
+        template <typename T>
+        typename std::enable_if<std::is_integral<T>::value, JsonWriter&>::type value(T number) {
+            separator();
+            if (std::is_signed<T>::value) {
+                out_.print((long)number);
+            } else {
+                out_.print((unsigned long)number);
+            }
+            return *this;
+        }
+
+        // Shorthand for key(key).value(value)
+        template <typename T>
+        JsonWriter& field(const char* key, T value) {
+            this->key(key);
+            return this->value(value);
+        }
+
+    private:
+        enum : uint8_t {
+            MAX_DEPTH = 32,
+        };
+
+        Print& out_;
+
+        // Bit per nesting level: whether anything has been written at that level yet (so the next value needs a comma)
+        uint32_t has_items_ = 0;
+        uint8_t depth_ = 0;
+        // A key was just written, so the next value belongs to it
+        bool after_key_ = false;
+
+        void separator();
+        void begin(char bracket);
+        void end(char bracket);
+        void writeString(const char* str, size_t length);
+};
+
+// Print into a fixed-size buffer, always null-terminated. Anything that doesn't fit is dropped and flagged.
+class BufferPrint : public Print {
+    public:
+        BufferPrint(char* buffer, size_t size) : buffer_(buffer), size_(size) {
+            buffer_[0] = '\0';
+        }
+
+        size_t write(uint8_t b) override;
+        size_t write(const uint8_t *buffer, size_t size) override;
+
+        const char* c_str() const {
+            return buffer_;
+        }
+        size_t length() const {
+            return length_;
+        }
+        bool overflowed() const {
+            return overflowed_;
+        }
+
+    private:
+        char* const buffer_;
+        const size_t size_;
+        size_t length_ = 0;
+        bool overflowed_ = false;
+};
+
+// Print that keeps only bytes [offset, offset + size) of everything written to it, in a buffer that isn't
+// null-terminated. Used to stream output in chunks by writing it all again for each chunk, so only one chunk is ever
+// held in memory.
+class WindowPrint : public Print {
+    public:
+        WindowPrint(uint8_t* buffer, size_t size, size_t offset) : buffer_(buffer), size_(size), offset_(offset) {}
+
+        size_t write(uint8_t b) override;
+        size_t write(const uint8_t *buffer, size_t size) override;
+
+        // Bytes kept so far
+        size_t length() const {
+            return length_;
+        }
+
+    private:
+        uint8_t* const buffer_;
+        const size_t size_;
+        const size_t offset_;
+        // Bytes written so far, kept or not
+        size_t position_ = 0;
+        size_t length_ = 0;
+};
@@ -0,0 +1,56 @@
+/*
+   Copyright 2021 Scott Bezek and the splitflap contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "log_ring.h"
+
+LogRing::LogRing() {
+    for (uint32_t i = 0; i < SIZE; i++) {
+        slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+bool LogRing::push(const LogRecord& record) {
+    uint32_t position = head_.load(std::memory_order_relaxed);
+    while (true) {
+        Slot& slot = slots_[position & (SIZE - 1)];
+        int32_t diff = (int32_t)(slot.sequence.load(std::memory_order_acquire) - position);
+        if (diff == 0) {
+            // Free; try to claim it (which fails, updating position, if another producer got there first)
+            if (head_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                slot.record = record;
+                slot.sequence.store(position + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            // Still holds the record from SIZE positions ago, so the ring is full
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        } else {
+            // Another producer already claimed this position
+            position = head_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool LogRing::pop(LogRecord& out) {
+    Slot& slot = slots_[tail_ & (SIZE - 1)];
+    if (slot.sequence.load(std::memory_order_acquire) != tail_ + 1) {
+        return false;
+    }
+    out = slot.record;
+    slot.sequence.store(tail_ + SIZE, std::memory_order_release);
+    tail_++;
+    return true;
+}
@@ -0,0 +1,64 @@
+/*
+   Copyright 2021 Scott Bezek and the splitflap contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#pragma once
+
+#include <atomic>
+
+#include "logger.h"
+
+/**
+ * Fixed-size, lock-free, multi-producer/single-consumer queue of log records.
+ *
+ * Each slot has a sequence number saying whether it's free for the producer claiming that position or holds a record
+ * for the consumer, so producers only contend on claiming a position and never wait for each other or the consumer.
+ * If the ring is full the record is dropped and counted rather than blocking the caller.
+ */
+class LogRing {
+    public:
+        enum : uint8_t {
+            SIZE = 32,
+        };
+
+        LogRing();
+        LogRing(LogRing const&)=delete;
+        LogRing& operator=(LogRing const&)=delete;
+
+        // Producer API - safe to call from any task. Returns false if the record was dropped because the ring is full.
+        bool push(const LogRecord& record);
+
+        // Consumer API - must only be called from a single task.
+        bool pop(LogRecord& out);
+
+        // Total records dropped so far
+        uint32_t dropped() const {
+            return dropped_.load(std::memory_order_relaxed);
+        }
+
+    private:
+        static_assert((SIZE & (SIZE - 1)) == 0, "LogRing size must be a power of 2");
+
+        struct Slot {
+            // Equal to the position when the slot is free for a producer at that position, and position + 1 once
+            // it holds that position's record
+            std::atomic<uint32_t> sequence;
+            LogRecord record;
+        };
+
+        Slot slots_[SIZE];
+        std::atomic<uint32_t> head_ = {};
+        uint32_t tail_ = 0;
+        std::atomic<uint32_t> dropped_ = {};
+};
@@ -15,10 +15,64 @@
 */
 #pragma once
 
+#include <stdint.h>
+#include <stdio.h>
+#include <type_traits>
+
+// A log message that hasn't been formatted yet, so it can be queued without allocating and formatted later by
+// whichever task outputs it
+struct LogRecord {
+    enum : uint8_t {
+        MAX_ARGS = 4,
+        MAX_TEXT_LENGTH = 127,
+    };
+
+    // printf-style format with only integer conversions, which is formatted later (possibly on another task), so it
+    // must be a string literal. If null, the message is already formatted in text.
+    const char* format;
+    uint32_t args[MAX_ARGS];
+    char text[MAX_TEXT_LENGTH + 1];
+
+    void formatTo(char* buffer, size_t size) const {
+        if (format == nullptr) {
+            snprintf(buffer, size, "%s", text);
+        } else {
+            snprintf(buffer, size, format, args[0], args[1], args[2], args[3]);
+        }
+    }
+};
+
 class Logger {
     public:
         Logger() {};
         virtual ~Logger() {};
         virtual void log(const char* msg) = 0;
-    
+
+        // Logs a message with up to LogRecord::MAX_ARGS integer arguments, without formatting it on the calling task
+        // if this logger can defer that. The format must be a string literal.
+        template <typename... Args>
+        void logf(const char* format, Args... args) {
+            static_assert(sizeof...(Args) <= LogRecord::MAX_ARGS, "Too many log arguments");
+            LogRecord record;
+            record.format = format;
+            uint32_t values[LogRecord::MAX_ARGS] = {logArg(args)...};
+            for (uint8_t i = 0; i < LogRecord::MAX_ARGS; i++) {
+                record.args[i] = values[i];
+            }
+            record.text[0] = 0;
+            logRecord(record);
+        }
+
+        virtual void logRecord(const LogRecord& record) {
+            char buffer[LogRecord::MAX_TEXT_LENGTH + 1];
+            record.formatTo(buffer, sizeof(buffer));
+            log(buffer);
+        }
+
+    private:
+        template <typename T>
+        static uint32_t logArg(T value) {
+            static_assert(std::is_integral<T>::value || std::is_enum<T>::value, "Log arguments must be integers");
+            return (uint32_t)value;
+        }
 };
@@ -0,0 +1,181 @@
+/*
+   Copyright 2024 Scott Bezek and the splitflap contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "network_task.h"
+
+#include <lwip/apps/sntp.h>
+#include <time.h>
+
+NetworkTask::NetworkTask(const char* ssid, const char* password, const uint8_t task_core) :
+        Task("Network", 4096, 1, task_core),
+        ssid_(ssid),
+        password_(password),
+        event_group_(xEventGroupCreate()) {
+    assert(event_group_ != NULL);
+}
+
+void NetworkTask::setLogger(Logger* logger) {
+    logger_ = logger;
+}
+
+bool NetworkTask::waitForConnection(TickType_t ticks_to_wait) {
+    return (xEventGroupWaitBits(event_group_, CONNECTED_BIT, pdFALSE, pdTRUE, ticks_to_wait) & CONNECTED_BIT) != 0;
+}
+
+bool NetworkTask::waitForTimeSync(TickType_t ticks_to_wait) {
+    return (xEventGroupWaitBits(event_group_, TIME_SYNCED_BIT, pdFALSE, pdTRUE, ticks_to_wait) & TIME_SYNCED_BIT) != 0;
+}
+
+void NetworkTask::run() {
+    WiFi.mode(WIFI_STA);
+
+    // Disable WiFi sleep as it causes glitches on pin 39; see https://github.com/espressif/arduino-esp32/issues/4903#issuecomment-793187707
+    WiFi.setSleep(WIFI_PS_NONE);
+
+    // Reconnecting is done here (with backoff) rather than by the WiFi driver. Events just wake the task to check the
+    // status, so there's no need to tell them apart.
+    WiFi.setAutoReconnect(false);
+    WiFi.onEvent([this](WiFiEvent_t event, WiFiEventInfo_t info) {
+        xTaskNotifyGive(getHandle());
+    });
+
+    stats_snapshot_.publish(stats_);
+    while (1) {
+        uint32_t now = millis();
+        bool was_connected = stats_.connected;
+        if (WiFi.status() == WL_CONNECTED) {
+            if (!was_connected) {
+                connected();
+            }
+        } else {
+            if (was_connected) {
+                disconnected(now);
+            }
+            if (attempting_ && now - attempt_millis_ >= CONNECT_TIMEOUT_MILLIS) {
+                attemptTimedOut(now);
+            }
+            if (!attempting_ && (int32_t)(now - next_attempt_millis_) >= 0) {
+                startAttempt(now);
+            }
+        }
+
+        if (time_sync_started_ && !stats_.time_synced) {
+            checkTimeSync();
+        }
+
+        ulTaskNotifyTake(pdTRUE, ticksUntilNextCheck(now));
+    }
+}
+
+void NetworkTask::connected() {
+    attempting_ = false;
+    retry_millis_ = RETRY_MIN_MILLIS;
+    stats_.connected = true;
+    stats_.connects++;
+    stats_snapshot_.publish(stats_);
+    xEventGroupSetBits(event_group_, CONNECTED_BIT);
+
+    char buf[100];
+    snprintf(buf, sizeof(buf), "Connected to network %s, IP address %s", ssid_, WiFi.localIP().toString().c_str());
+    log(buf);
+
+    // SNTP keeps polling (and retrying) on its own once started, across reconnects
+    if (!time_sync_started_) {
+        startTimeSync();
+    }
+}
+
+void NetworkTask::disconnected(uint32_t now) {
+    stats_.connected = false;
+    stats_.disconnects++;
+    stats_snapshot_.publish(stats_);
+    xEventGroupClearBits(event_group_, CONNECTED_BIT);
+    log("WiFi connection lost; reconnecting");
+
+    // Try again straight away; backoff only kicks in if that fails
+    attempting_ = false;
+    next_attempt_millis_ = now;
+}
+
+void NetworkTask::startAttempt(uint32_t now) {
+    if (stats_.connect_attempts == 0) {
+        char buf[100];
+        snprintf(buf, sizeof(buf), "Connecting to network %s...", ssid_);
+        log(buf);
+    } else {
+        // Drop whatever's left of the previous attempt
+        WiFi.disconnect();
+    }
+    WiFi.begin(ssid_, password_);
+    attempting_ = true;
+    attempt_millis_ = now;
+    stats_.connect_attempts++;
+    stats_snapshot_.publish(stats_);
+}
+
+void NetworkTask::attemptTimedOut(uint32_t now) {
+    attempting_ = false;
+    next_attempt_millis_ = now + retry_millis_;
+
+    char buf[100];
+    snprintf(buf, sizeof(buf), "Failed to connect to network %s; retrying in %u seconds", ssid_, (unsigned)(retry_millis_ / 1000));
+    log(buf);
+
+    retry_millis_ = retry_millis_ * 2 > RETRY_MAX_MILLIS ? RETRY_MAX_MILLIS : retry_millis_ * 2;
+}
+
+void NetworkTask::startTimeSync() {
+    sntp_setoperatingmode(SNTP_OPMODE_POLL);
+
+    char server[] = "time.nist.gov"; // sntp_setservername takes a non-const char*, so use a non-const variable to avoid warning
+    sntp_setservername(0, server);
+    sntp_init();
+    time_sync_started_ = true;
+
+    log("Waiting for NTP time sync...");
+}
+
+void NetworkTask::checkTimeSync() {
+    time_t now;
+    if (time(&now), !isValidTime(now)) {
+        return;
+    }
+    stats_.time_synced = true;
+    stats_snapshot_.publish(stats_);
+    xEventGroupSetBits(event_group_, TIME_SYNCED_BIT);
+
+    char buf[100];
+    strftime(buf, sizeof(buf), "Got time: %Y-%m-%d %H:%M:%S UTC", gmtime(&now));
+    log(buf);
+}
+
+TickType_t NetworkTask::ticksUntilNextCheck(uint32_t now) {
+    bool waiting_for_time = time_sync_started_ && !stats_.time_synced;
+    if (stats_.connected) {
+        return waiting_for_time ? pdMS_TO_TICKS(TIME_SYNC_CHECK_MILLIS) : portMAX_DELAY;
+    }
+    uint32_t deadline = attempting_ ? attempt_millis_ + CONNECT_TIMEOUT_MILLIS : next_attempt_millis_;
+    uint32_t wait_millis = (int32_t)(deadline - now) > 0 ? deadline - now : 0;
+    if (waiting_for_time && wait_millis > TIME_SYNC_CHECK_MILLIS) {
+        wait_millis = TIME_SYNC_CHECK_MILLIS;
+    }
+    return pdMS_TO_TICKS(wait_millis);
+}
+
+void NetworkTask::log(const char* msg) {
+    if (logger_ != nullptr) {
+        logger_->log(msg);
+    }
+}
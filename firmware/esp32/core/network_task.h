@@ -0,0 +1,117 @@
+/*
+   Copyright 2024 Scott Bezek and the splitflap contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#pragma once
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include <time.h>
+
+#include "logger.h"
+#include "snapshot_buffer.h"
+#include "task.h"
+
+struct NetworkStats {
+    bool connected;
+    bool time_synced;
+    // Calls to WiFi.begin(), successful connections, and connections lost
+    uint32_t connect_attempts;
+    uint32_t connects;
+    uint32_t disconnects;
+};
+
+/**
+ * Owns the WiFi connection and SNTP time sync, so tasks that need the network don't each bring it up (and handle it
+ * dropping) their own way.
+ *
+ * Connects in the background as soon as the task starts, and reconnects whenever the connection is lost, backing off
+ * between failed attempts. Other tasks block in waitForConnection()/waitForTimeSync() (backed by an event group)
+ * rather than polling WiFi.status(), so they start as soon as the network is up and can wait again after it drops.
+ */
+class NetworkTask : public Task<NetworkTask> {
+    friend class Task<NetworkTask>; // Allow base Task to invoke protected run()
+
+    public:
+        NetworkTask(const char* ssid, const char* password, const uint8_t task_core);
+        NetworkTask(NetworkTask const&)=delete;
+        NetworkTask& operator=(NetworkTask const&)=delete;
+
+        // Must be called before begin()
+        void setLogger(Logger* logger);
+
+        // Safe to call from any task. Each returns whether the condition holds, waiting up to ticks_to_wait for it.
+        bool waitForConnection(TickType_t ticks_to_wait = portMAX_DELAY);
+        bool waitForTimeSync(TickType_t ticks_to_wait = portMAX_DELAY);
+
+        bool isConnected() {
+            return waitForConnection(0);
+        }
+
+        NetworkStats getStats() {
+            return stats_snapshot_.read();
+        }
+
+        // Whether a time from the system clock is real, rather than counting up from the epoch because SNTP hasn't set
+        // the clock yet
+        static bool isValidTime(time_t time) {
+            return time >= MIN_VALID_TIME;
+        }
+
+    protected:
+        void run();
+
+    private:
+        static const time_t MIN_VALID_TIME = 1625099485;
+
+        enum : EventBits_t {
+            CONNECTED_BIT = 1 << 0,
+            TIME_SYNCED_BIT = 1 << 1,
+        };
+
+        enum : uint32_t {
+            // How long a connection attempt gets before it's given up on
+            CONNECT_TIMEOUT_MILLIS = 15000,
+
+            // Delay before retrying after a failed attempt, doubling with each failure (reset once connected)
+            RETRY_MIN_MILLIS = 1000,
+            RETRY_MAX_MILLIS = 60000,
+
+            // How often to check whether SNTP has set the clock yet
+            TIME_SYNC_CHECK_MILLIS = 1000,
+        };
+
+        const char* const ssid_;
+        const char* const password_;
+        Logger* logger_ = nullptr;
+        EventGroupHandle_t event_group_;
+
+        NetworkStats stats_ = {};
+        SnapshotBuffer<NetworkStats> stats_snapshot_;
+
+        bool attempting_ = false;
+        uint32_t attempt_millis_ = 0;
+        uint32_t next_attempt_millis_ = 0;
+        uint32_t retry_millis_ = RETRY_MIN_MILLIS;
+        bool time_sync_started_ = false;
+
+        void connected();
+        void disconnected(uint32_t now);
+        void startAttempt(uint32_t now);
+        void attemptTimedOut(uint32_t now);
+        void startTimeSync();
+        void checkTimeSync();
+        TickType_t ticksUntilNextCheck(uint32_t now);
+        void log(const char* msg);
+};
@@ -0,0 +1,88 @@
+/*
+   Copyright 2024 Scott Bezek and the splitflap contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "prometheus_writer.h"
+
+const char* const PrometheusWriter::CONTENT_TYPE = "text/plain; version=0.0.4";
+
+PrometheusWriter& PrometheusWriter::family(const char* name, const char* type, const char* help) {
+    name_ = name;
+    out_.print("# HELP ");
+    out_.print(name);
+    out_.write(' ');
+    out_.print(help);
+    out_.print("\n# TYPE ");
+    out_.print(name);
+    out_.write(' ');
+    out_.print(type);
+    out_.write('\n');
+    return *this;
+}
+
+PrometheusWriter& PrometheusWriter::sampleSeconds(uint64_t micros) {
+    out_.print(name_);
+    out_.write(' ');
+    writeSeconds(micros);
+    out_.write('\n');
+    return *this;
+}
+
+PrometheusWriter& PrometheusWriter::histogram(const char* name, const char* help, const MicrosHistogram& histogram) {
+    family(name, "histogram", help);
+    uint32_t cumulative = 0;
+    for (uint8_t i = 0; i < MicrosHistogram::NUM_BUCKETS; i++) {
+        cumulative += histogram.counts[i];
+        out_.print(name);
+        out_.print("_bucket{le=\"");
+        if (i < MicrosHistogram::NUM_BUCKETS - 1) {
+            writeSeconds(MicrosHistogram::BUCKET_BOUNDS_MICROS[i]);
+        } else {
+            out_.print("+Inf");
+        }
+        out_.print("\"}");
+        writeValue(cumulative);
+    }
+    out_.print(name);
+    out_.print("_sum ");
+    writeSeconds(histogram.sum_micros);
+    out_.write('\n');
+    out_.print(name);
+    out_.print("_count");
+    writeValue(histogram.count);
+    return *this;
+}
+
+void PrometheusWriter::beginLabel(const char* label) {
+    out_.print(name_);
+    out_.write('{');
+    out_.print(label);
+    out_.print("=\"");
+}
+
+void PrometheusWriter::endLabel() {
+    out_.print("\"}");
+}
+
+void PrometheusWriter::writeSeconds(uint64_t micros) {
+    char buf[24];
+    snprintf(buf, sizeof(buf), "%lu.%06lu", (unsigned long)(micros / 1000000), (unsigned long)(micros % 1000000));
+    out_.print(buf);
+}
+
+void PrometheusWriter::writeValue(float number) {
+    out_.write(' ');
+    out_.print(number, 3);
+    out_.write('\n');
+}
@@ -0,0 +1,89 @@
+/*
+   Copyright 2024 Scott Bezek and the splitflap contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#pragma once
+
+#include <Arduino.h>
+#include <type_traits>
+
+#include "histogram.h"
+
+/**
+ * Minimal streaming writer for the Prometheus text exposition format. As with JsonWriter, everything goes straight to
+ * a Print as it's added.
+ *
+ * Start each metric family with family(), then add its samples, each with at most one label. Label values aren't
+ * escaped, so they must not contain quotes, backslashes or newlines.
+ */
+class PrometheusWriter {
+    public:
+        static const char* const CONTENT_TYPE;
+
+        explicit PrometheusWriter(Print& out) : out_(out) {}
+
+        PrometheusWriter& family(const char* name, const char* type, const char* help);
+
+        template <typename T>
+        PrometheusWriter& sample(T value) {
+            out_.print(name_);
+            writeValue(value);
+            return *this;
+        }
+
+        template <typename T>
+        PrometheusWriter& sample(const char* label, const char* label_value, T value) {
+            beginLabel(label);
+            out_.print(label_value);
+            endLabel();
+            writeValue(value);
+            return *this;
+        }
+
+        template <typename T>
+        PrometheusWriter& sample(const char* label, uint32_t label_value, T value) {
+            beginLabel(label);
+            out_.print((unsigned long)label_value);
+            endLabel();
+            writeValue(value);
+            return *this;
+        }
+
+        // A sample of a duration, in seconds (to the microsecond)
+        PrometheusWriter& sampleSeconds(uint64_t micros);
+
+        // A whole histogram family, in seconds
+        PrometheusWriter& histogram(const char* name, const char* help, const MicrosHistogram& histogram);
+
+    private:
+        Print& out_;
+        const char* name_ = "";
+
+        void beginLabel(const char* label);
+        void endLabel();
+        void writeSeconds(uint64_t micros);
+
+        template <typename T>
+        typename std::enable_if<std::is_integral<T>::value>::type writeValue(T number) {
+            out_.write(' ');
+            if (std::is_signed<T>::value) {
+                out_.print((long)number);
+            } else {
+                out_.print((unsigned long)number);
+            }
+            out_.write('\n');
+        }
+
+        void writeValue(float number);
+};
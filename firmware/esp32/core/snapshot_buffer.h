@@ -0,0 +1,91 @@
+/*
+   Copyright 2021 Scott Bezek and the splitflap contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#pragma once
+
+#include <atomic>
+#include <string.h>
+#include <type_traits>
+
+/**
+ * Single-writer/multi-reader snapshot of a trivially-copyable value, as a double-buffered seqlock.
+ *
+ * The writer always writes into the buffer that isn't holding the latest published value, so it never waits for
+ * readers and readers never wait for an in-progress write. A reader only has to retry if the writer publishes once
+ * and starts on the next version while the reader is still copying.
+ *
+ * Each published value gets a new version number, so readers can cheaply skip versions they've already seen without
+ * copying anything.
+ */
+template <typename T>
+class SnapshotBuffer {
+    static_assert(std::is_trivially_copyable<T>::value, "SnapshotBuffer values are copied with memcpy");
+
+    public:
+        SnapshotBuffer() {}
+        SnapshotBuffer(SnapshotBuffer const&)=delete;
+        SnapshotBuffer& operator=(SnapshotBuffer const&)=delete;
+
+        // Writer API - must only be called from a single task.
+        void publish(const T& value) {
+            uint32_t sequence = sequence_.load(std::memory_order_relaxed);
+            sequence_.store(sequence + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            memcpy(&buffers_[((sequence >> 1) + 1) & 1], &value, sizeof(T));
+            sequence_.store(sequence + 2, std::memory_order_release);
+        }
+
+        // The most recently published value. Only safe to call from the writer.
+        const T& latest() const {
+            return buffers_[(sequence_.load(std::memory_order_relaxed) >> 1) & 1];
+        }
+
+        // Reader API - safe to call from any task.
+        uint32_t version() const {
+            return sequence_.load(std::memory_order_acquire) >> 1;
+        }
+
+        // Copies the latest value into out and updates version, unless version is already the latest; returns whether
+        // a new value was copied.
+        bool readIfChanged(uint32_t& version, T& out) const {
+            while (true) {
+                // If a write is in progress, read the last completed version instead
+                uint32_t completed = sequence_.load(std::memory_order_acquire) & ~1UL;
+                if ((completed >> 1) == version) {
+                    return false;
+                }
+                memcpy(&out, &buffers_[(completed >> 1) & 1], sizeof(T));
+                std::atomic_thread_fence(std::memory_order_acquire);
+
+                // Our buffer is only overwritten once the writer has finished the next version and started another
+                if (sequence_.load(std::memory_order_relaxed) - completed <= 2) {
+                    version = completed >> 1;
+                    return true;
+                }
+            }
+        }
+
+        T read() const {
+            uint32_t version = this->version() - 1;
+            T out;
+            readIfChanged(version, out);
+            return out;
+        }
+
+    private:
+        // Twice the number of values published, plus one while a write is in progress
+        std::atomic<uint32_t> sequence_ = {};
+        T buffers_[2] = {};
+};
@@ -28,23 +28,17 @@
 
 static_assert(QCMD_FLAP + NUM_FLAPS <= 255, "Too many flaps to fit in uint8_t command structure");
 
-SplitflapTask::SplitflapTask(const uint8_t task_core, const LedMode led_mode) : Task("Splitflap", 4096, 1, task_core), led_mode_(led_mode), state_semaphore_(xSemaphoreCreateMutex()), configuration_semaphore_(xSemaphoreCreateMutex()) {
-  assert(state_semaphore_ != NULL);
-  xSemaphoreGive(state_semaphore_);
+SplitflapTask::SplitflapTask(const uint8_t task_core, const LedMode led_mode) : Task("Splitflap", 4096, 1, task_core), led_mode_(led_mode), configuration_semaphore_(xSemaphoreCreateMutex()),
+        trace_request_queue_(xQueueCreate(1, sizeof(CommandTrace))), trace_done_queue_(xQueueCreate(TRACE_QUEUE_SIZE, sizeof(CommandTrace))),
+        trace_collect_semaphore_(xSemaphoreCreateMutex()) {
   assert(configuration_semaphore_ != NULL);
+  assert(trace_request_queue_ != NULL);
+  assert(trace_done_queue_ != NULL);
+  assert(trace_collect_semaphore_ != NULL);
   xSemaphoreGive(configuration_semaphore_);
-
-  queue_ = xQueueCreate(5, sizeof(Command));
-  assert(queue_ != NULL);
 }
 
 SplitflapTask::~SplitflapTask() {
-  if (queue_ != NULL) {
-    vQueueDelete(queue_);
-  }
-  if (state_semaphore_ != NULL) {
-    vSemaphoreDelete(state_semaphore_);
-  }
   if (configuration_semaphore_ != NULL) {
     vSemaphoreDelete(configuration_semaphore_);
   }
@@ -67,25 +61,32 @@ void SplitflapTask::run() {
 
 #if (defined(CHAINLINK) && !defined(CHAINLINK_DRIVER_TESTER))
 #if CHAINLINK_ENFORCE_LOOPBACKS
+    uint8_t num_drivers = chainlink_detect_num_drivers();
+    if (num_drivers == 0) {
+      logf("ERROR: no Chainlink Drivers detected. Assuming the maximum of %u", MAX_CHAINLINK_DRIVERS);
+      num_drivers = MAX_CHAINLINK_DRIVERS;
+    } else {
+      logf("Detected %u Chainlink Driver(s) (%u modules)", num_drivers, num_drivers * 6);
+    }
+    chainlink_set_num_drivers(num_drivers);
+    num_modules_ = num_drivers * 6;
+    const uint8_t num_loopbacks = chainlink_num_loopbacks();
+
     bool loopback_result[NUM_LOOPBACKS][NUM_LOOPBACKS];
     bool loopback_off_result[NUM_LOOPBACKS];
     bool loopback_success = chainlink_test_all_loopbacks(loopback_result, loopback_off_result);
 
     if (!loopback_success) {
-      for (uint8_t i = 0; i < NUM_LOOPBACKS; i++) {
-        for (uint8_t j = 0; j < NUM_LOOPBACKS; j++) {
+      for (uint8_t i = 0; i < num_loopbacks; i++) {
+        for (uint8_t j = 0; j < num_loopbacks; j++) {
           if (!loopback_result[i][j]) {
-            char buffer[200] = {};
-            snprintf(buffer, sizeof(buffer), "Loopback ERROR. Set output %u but read incorrect value at input %u", i, j);
-            log(buffer);
+            logf("Loopback ERROR. Set output %u but read incorrect value at input %u", i, j);
           }
         }
       }
-      for (uint8_t j = 0; j < NUM_LOOPBACKS; j++) {
+      for (uint8_t j = 0; j < num_loopbacks; j++) {
         if (!loopback_off_result[j]) {
-            char buffer[200] = {};
-            snprintf(buffer, sizeof(buffer), "Loopback ERROR. Loopback %u was set when all outputs off - should have been 0", j);
-            log(buffer);
+            logf("Loopback ERROR. Loopback %u was set when all outputs off - should have been 0", j);
         }
       }
 
@@ -96,7 +97,7 @@ void SplitflapTask::run() {
 #endif
 
     if (led_mode_ == LedMode::AUTO) {
-        for (uint8_t i = 0; i < NUM_MODULES; i++) {
+        for (uint8_t i = 0; i < num_modules_; i++) {
             chainlink_set_led(i, 1);
             motor_sensor_io();
             delay(10);
@@ -111,11 +112,14 @@ void SplitflapTask::run() {
     for (uint8_t i = 0; i < NUM_MODULES; i++) {
         modules[i]->Init();
 #if !defined(CHAINLINK_DRIVER_TESTER) && !defined(CHAINLINK_BASE)
-        modules[i]->FindAndRecalibrateHome();
+        if (i < num_modules_) {
+            modules[i]->FindAndRecalibrateHome();
+        }
 #endif
     }
 
     while(1) {
+        handlePriorityRequests();
         processQueue();
         runUpdate();
         result = esp_task_wdt_reset();
@@ -123,129 +127,230 @@ void SplitflapTask::run() {
     }
 }
 
+void SplitflapTask::requestPriority(uint32_t request) {
+    // The time is truncated to make room for the flags, and never 0 so it always marks a request as waiting
+    uint32_t now = micros() & ~(uint32_t)PRIORITY_FLAGS_MASK;
+    if (now == 0) {
+        now = PRIORITY_FLAGS_MASK + 1;
+    }
+    uint32_t current = priority_requests_.load(std::memory_order_relaxed);
+    uint32_t desired;
+    do {
+        // Keep the time of the oldest waiting request
+        uint32_t requested_micros = current & ~(uint32_t)PRIORITY_FLAGS_MASK;
+        uint32_t flags = current & PRIORITY_FLAGS_MASK;
+        // Pause and resume cancel each other out, so the latest one wins
+        if (request & PRIORITY_PAUSE) {
+            flags &= ~(uint32_t)PRIORITY_RESUME;
+        }
+        if (request & PRIORITY_RESUME) {
+            flags &= ~(uint32_t)PRIORITY_PAUSE;
+        }
+        desired = (requested_micros != 0 ? requested_micros : now) | flags | request;
+    } while (!priority_requests_.compare_exchange_weak(current, desired, std::memory_order_release, std::memory_order_relaxed));
+}
+
+void SplitflapTask::handlePriorityRequests() {
+    // Called before every module update, so keep the common (nothing requested) case to a single load
+    if (priority_requests_.load(std::memory_order_relaxed) == 0) {
+        return;
+    }
+    uint32_t taken = priority_requests_.exchange(0, std::memory_order_acquire);
+    uint32_t requests = taken & PRIORITY_FLAGS_MASK;
+    uint32_t requested_micros = taken & ~(uint32_t)PRIORITY_FLAGS_MASK;
+    if (requests == 0) {
+        return;
+    }
+
+    if (requests & PRIORITY_DISABLE) {
+        for (uint8_t i = 0; i < NUM_MODULES; i++) {
+            modules[i]->Disable();
+        }
+    }
+    if (requests & PRIORITY_PAUSE) {
+        for (uint8_t i = 0; i < NUM_MODULES; i++) {
+            modules[i]->Hold();
+        }
+        paused_ = true;
+    } else if (requests & PRIORITY_RESUME) {
+        paused_ = false;
+    }
+
+    // Push the motor outputs out now rather than waiting for the end of the current update pass
+    motor_sensor_io();
+
+    uint32_t latency = micros() - requested_micros;
+    priority_last_latency_micros_.store(latency, std::memory_order_relaxed);
+    if (latency > priority_max_latency_micros_.load(std::memory_order_relaxed)) {
+        priority_max_latency_micros_.store(latency, std::memory_order_relaxed);
+    }
+    priority_requests_handled_.fetch_add(1, std::memory_order_relaxed);
+}
+
 void SplitflapTask::processQueue() {
-    if (xQueueReceive(queue_, &queue_receive_buffer_, 0) == pdTRUE) {
-        switch (queue_receive_buffer_.command_type) {
-            case CommandType::MODULES: {
-                uint8_t* data = queue_receive_buffer_.data.module_command;
-                bool any_leds = false;
-                for (uint8_t i = 0; i < NUM_MODULES; i++) {
-                    switch (data[i]) {
-                        case QCMD_NO_OP:
-                            // No-op
-                            break;
-                        case QCMD_RESET_AND_HOME:
-                            modules[i]->ResetState();
-                            modules[i]->FindAndRecalibrateHome();
-                            break;
-                        case QCMD_LED_ON:
-                            any_leds = true;
-    #ifdef CHAINLINK
-                            chainlink_set_led(i, true);
-    #endif
-                            break;
-                        case QCMD_LED_OFF:
-                            any_leds = true;
-    #ifdef CHAINLINK
-                            chainlink_set_led(i, false);
-    #endif
-                            break;
-                        case QCMD_DISABLE:
-                            modules[i]->Disable();
-                            break;
-                        case QCMD_INCR_OFFSET_TENTH:
-                            modules[i]->IncreaseOffset(1);
-                            break;
-                        case QCMD_INCR_OFFSET_HALF:
-                            modules[i]->IncreaseOffset(5);
-                            break;
-                        case QCMD_SET_OFFSET:
-                            modules[i]->SetOffset();
-                            break;
-                        default:
-                            assert(data[i] >= QCMD_FLAP && data[i] < QCMD_FLAP + NUM_FLAPS);
-                            modules[i]->GoToFlapIndex(data[i] - QCMD_FLAP);
-                            break;
-                    }
-                }
-                if (any_leds) {
-                    motor_sensor_io();
-                }
-                break;
+    if (trace_requested_.load(std::memory_order_relaxed)) {
+        trace_requested_.store(false, std::memory_order_relaxed);
+        CommandTrace trace;
+        if (xQueueReceive(trace_request_queue_, &trace, 0) == pdTRUE) {
+            if (trace_pending_) {
+                // Never drained anything; superseded
+                completeTrace(pending_trace_);
             }
-            case CommandType::SENSOR_TEST_SET:
-                sensor_test_ = true;
-                break;
-            case CommandType::SENSOR_TEST_CLEAR:
-                sensor_test_ = false;
-                break;
-            case CommandType::CONFIG: {
-                ModuleConfigs configs = queue_receive_buffer_.data.module_configs;
-                for (uint8_t i = 0; i < NUM_MODULES; i++) {
-                    ModuleConfig config = configs.config[i];
-
-                    if (config.reset_nonce != current_configs_.config[i].reset_nonce) {
-                        modules[i]->ResetErrorCounters();
-                        modules[i]->FindAndRecalibrateHome();
-                    }
+            pending_trace_ = trace;
+            trace_pending_ = true;
+        }
+    }
 
-                    if (config.target_flap_index != current_configs_.config[i].target_flap_index ||
-                            config.target_flap_index != modules[i]->GetTargetFlapIndex() ||
-                            config.movement_nonce != current_configs_.config[i].movement_nonce) {
-                        if (config.target_flap_index >= NUM_FLAPS) {
-                            char buffer[200] = {};
-                            snprintf(buffer, sizeof(buffer), "Invalid flap index (%u) specified for module %u", config.target_flap_index, i);
-                            log(buffer);
-                        } else {
-                            modules[i]->GoToFlapIndex(config.target_flap_index);
-                        }
-                    }
-                }
-                current_configs_ = configs;
-                break;
-            }
-            case CommandType::SAVE_ALL_OFFSETS: {
-                char buffer[200] = {};
-
-                uint16_t offsets[NUM_MODULES];
-                for (uint8_t i = 0; i < NUM_MODULES; i++) {
-                    // Make sure all modules are stopped, since writing to config may take a while
-                    if (modules[i]->current_accel_step != 0) {
-                        snprintf(buffer, sizeof(buffer), "Can't save offsets; module %u isn't idle", i);
-                        log(buffer);
-                        return;
-                    }
+    if (!mailbox_.hasPending()) {
+        if (trace_pending_ && micros() - pending_trace_.posted_micros > TRACE_TIMEOUT_MICROS) {
+            // The command didn't need the splitflap task to do anything
+            completeTrace(pending_trace_);
+            trace_pending_ = false;
+        }
+        return;
+    }
 
-                    offsets[i] = modules[i]->GetOffset();
-                }
+    if (trace_pending_) {
+        if (tracing_) {
+            completeTrace(active_trace_);
+        }
+        active_trace_ = pending_trace_;
+        active_trace_.dequeued_micros = CommandTrace::now();
+        tracing_ = true;
+        trace_pending_ = false;
+    }
 
-                // Write to configuration
-                Configuration* configuration;
-                {
-                    SemaphoreGuard lock(configuration_semaphore_);
-                    configuration = configuration_;
-                }
-                if (configuration != nullptr) {
-                    log("Saving calibration...");
-                    bool success = configuration->setModuleOffsetsAndSave(offsets);
-                    if (success) {
-                        log("SUCCESS - saved calibration!");
-                    } else {
-                        log("ERROR - failed to save calibration");
-                    }
-                }
-                break;
-            }
-            case CommandType::RESTORE_ALL_OFFSETS:
-                for (uint8_t i = 0; i < NUM_MODULES; i++) {
-                    uint16_t offset = queue_receive_buffer_.data.module_offsets[i];
-                    modules[i]->RestoreOffset(offset);
-                }
-                break;
-            default: {
-                log("Unknown command");
-                break;
-            }
+    // Drain everything that's pending in a single pass. Global state first, then per-module actions (so that e.g. a
+    // reset is applied before a new target), then per-module targets, and finally saving offsets (so any offset
+    // adjustments in this batch are included).
+    uint16_t batch_size = 0;
+    uint32_t global = mailbox_.takeGlobal();
+    if (global != 0) {
+        batch_size++;
+    }
+    if (global & CommandMailbox::GLOBAL_SENSOR_TEST_SET) {
+        sensor_test_ = true;
+    } else if (global & CommandMailbox::GLOBAL_SENSOR_TEST_CLEAR) {
+        sensor_test_ = false;
+    }
+
+    bool any_leds = false;
+    for (uint8_t i = 0; i < NUM_MODULES; i++) {
+        CommandMailbox::ModuleActions actions;
+        if (mailbox_.takeActions(i, actions)) {
+            batch_size++;
+            applyModuleActions(i, actions);
+            any_leds |= (actions.flags & (CommandMailbox::ACTION_LED_ON | CommandMailbox::ACTION_LED_OFF)) != 0;
+        }
+
+        CommandMailbox::ModuleTarget target;
+        if (mailbox_.takeTarget(i, target)) {
+            batch_size++;
+            applyModuleTarget(i, target);
+        }
+    }
+    if (any_leds) {
+        motor_sensor_io();
+    }
+
+    if (global & CommandMailbox::GLOBAL_SAVE_ALL_OFFSETS) {
+        saveOffsets();
+    }
+
+    mailbox_.finishDrain(batch_size);
+}
+
+void SplitflapTask::applyModuleActions(uint8_t i, const CommandMailbox::ModuleActions& actions) {
+    // Restored offsets are kept even for modules that aren't connected, so they aren't lost when saving
+    if (actions.flags & CommandMailbox::ACTION_RESTORE_OFFSET) {
+        modules[i]->RestoreOffset(actions.restore_offset);
+    }
+    if (i >= num_modules_) {
+        return;
+    }
+
+    if (actions.flags & CommandMailbox::ACTION_RESET_AND_HOME) {
+        modules[i]->ResetState();
+        modules[i]->FindAndRecalibrateHome();
+    }
+#ifdef CHAINLINK
+    if (actions.flags & CommandMailbox::ACTION_LED_ON) {
+        chainlink_set_led(i, true);
+    } else if (actions.flags & CommandMailbox::ACTION_LED_OFF) {
+        chainlink_set_led(i, false);
+    }
+#endif
+    if (actions.offset_tenths > 0) {
+        modules[i]->IncreaseOffset(actions.offset_tenths);
+    }
+    if (actions.flags & CommandMailbox::ACTION_SET_OFFSET) {
+        modules[i]->SetOffset();
+    }
+    // Always applied last, so a disable can't be undone by other actions in the same batch
+    if (actions.flags & CommandMailbox::ACTION_DISABLE) {
+        modules[i]->Disable();
+    }
+}
+
+void SplitflapTask::applyModuleTarget(uint8_t i, const CommandMailbox::ModuleTarget& target) {
+    if (i >= num_modules_) {
+        return;
+    }
+
+    if (!target.is_config) {
+        // Checked here rather than when submitting, as only this task knows where the module is headed
+        if (target.force_full_rotation || target.flap_index != modules[i]->GetTargetFlapIndex()) {
+            modules[i]->GoToFlapIndex(target.flap_index);
+        }
+        return;
+    }
+
+    ModuleConfig& current_config = current_configs_.config[i];
+    if (target.reset_nonce != current_config.reset_nonce) {
+        modules[i]->ResetErrorCounters();
+        modules[i]->FindAndRecalibrateHome();
+    }
+
+    if (target.flap_index != current_config.target_flap_index ||
+            target.flap_index != modules[i]->GetTargetFlapIndex() ||
+            target.movement_nonce != current_config.movement_nonce) {
+        if (target.flap_index >= NUM_FLAPS) {
+            logf("Invalid flap index (%u) specified for module %u", target.flap_index, i);
+        } else {
+            modules[i]->GoToFlapIndex(target.flap_index);
+        }
+    }
+
+    current_config.target_flap_index = target.flap_index;
+    current_config.movement_nonce = target.movement_nonce;
+    current_config.reset_nonce = target.reset_nonce;
+}
+
+void SplitflapTask::saveOffsets() {
+    uint16_t offsets[NUM_MODULES];
+    for (uint8_t i = 0; i < NUM_MODULES; i++) {
+        // Make sure all modules are stopped, since writing to config may take a while
+        if (modules[i]->current_accel_step != 0) {
+            logf("Can't save offsets; module %u isn't idle", i);
+            return;
+        }
+
+        offsets[i] = modules[i]->GetOffset();
+    }
+
+    // Write to configuration
+    Configuration* configuration;
+    {
+        SemaphoreGuard lock(configuration_semaphore_);
+        configuration = configuration_;
+    }
+    if (configuration != nullptr) {
+        logf("Saving calibration...");
+        bool success = configuration->setModuleOffsetsAndSave(offsets);
+        if (success) {
+            logf("SUCCESS - saved calibration!");
+        } else {
+            logf("ERROR - failed to save calibration");
         }
     }
 }
@@ -253,6 +358,12 @@ void SplitflapTask::processQueue() {
 void SplitflapTask::runUpdate() {
     boolean all_idle = true;
 
+    uint32_t pass_start_micros = micros();
+    if (last_pass_micros_ != 0) {
+        metrics_.loop_period.record(pass_start_micros - last_pass_micros_);
+    }
+    last_pass_micros_ = pass_start_micros;
+
     uint32_t iterationStartMillis = millis();
 
     uint32_t flashStep = iterationStartMillis / 200;
@@ -265,7 +376,7 @@ void SplitflapTask::runUpdate() {
 
 #ifdef CHAINLINK
       if (led_mode_ == LedMode::AUTO) {
-        for (uint8_t i = 0; i < NUM_MODULES; i++) {
+        for (uint8_t i = 0; i < num_modules_; i++) {
           chainlink_set_led(i, modules[i]->GetHomeState());
         }
         // Output LED state
@@ -274,8 +385,11 @@ void SplitflapTask::runUpdate() {
 #endif
     } else {
       all_stopped_ = true;
-      for (uint8_t i = 0; i < NUM_MODULES; i++) {
-        modules[i]->Update();
+      for (uint8_t i = 0; i < num_modules_; i++) {
+        handlePriorityRequests();
+        if (!paused_) {
+          modules[i]->Update();
+        }
         bool is_idle = modules[i]->state == PANIC
           || modules[i]->state == STATE_DISABLED
           || modules[i]->state == LOOK_FOR_HOME
@@ -295,10 +409,14 @@ void SplitflapTask::runUpdate() {
         all_idle &= is_idle;
         all_stopped_ &= is_stopped;
       }
+      uint32_t io_start_micros = micros();
       motor_sensor_io();
+      metrics_.io_transfer.record(micros() - io_start_micros);
     }
 
 
+    updateTrace();
+
 #if defined(CHAINLINK) && CHAINLINK_ENFORCE_LOOPBACKS
     // We test loopbacks iteratively, so as not to waste too many cycles/IO-roundtrips all at once. There are
     // two levels of iteration - loopback_step_index_ tracks the small intermediate steps of testing a single
@@ -313,7 +431,7 @@ void SplitflapTask::runUpdate() {
       if (!ok && loopback_all_ok_) {
         // Publish failures immediately
         loopback_all_ok_ = false;
-        log("Loopback ERROR!");
+        logf("Loopback ERROR!");
         disableAll();
       }
     } else if (loopback_step_index_ == 50) {
@@ -322,9 +440,9 @@ void SplitflapTask::runUpdate() {
 
       // If we've iterated through all loopbacks, save the results of this run and restart
       // from the first loopback again.
-      if (loopback_current_out_index_ >= NUM_LOOPBACKS) {
+      if (loopback_current_out_index_ >= chainlink_num_loopbacks()) {
         if (loopback_current_ok_ && !loopback_all_ok_) {
-            log("Loopback is ok!");
+            logf("Loopback is ok!");
         }
         loopback_all_ok_ = loopback_current_ok_;
         loopback_current_ok_ = true;
@@ -335,6 +453,78 @@ void SplitflapTask::runUpdate() {
 #endif
 
     updateStateCache();
+    publishMetrics();
+}
+
+void SplitflapTask::publishMetrics() {
+    uint32_t now = millis();
+    if (now - metrics_published_millis_ < METRICS_PUBLISH_MILLIS) {
+        return;
+    }
+    metrics_published_millis_ = now;
+    for (uint8_t i = 0; i < NUM_MODULES; i++) {
+        metrics_.module_steps[i] = modules[i]->step_count;
+    }
+    metrics_snapshot_.publish(metrics_);
+}
+
+void SplitflapTask::getMetrics(SplitflapMetrics& out) {
+    uint32_t version = metrics_snapshot_.version() - 1;
+    metrics_snapshot_.readIfChanged(version, out);
+}
+
+void SplitflapTask::updateTrace() {
+    if (!tracing_) {
+        return;
+    }
+    if (active_trace_.first_step_micros == 0 && !all_stopped_) {
+        active_trace_.first_step_micros = CommandTrace::now();
+    } else if (all_stopped_) {
+        // If nothing moved in the first pass after the command was applied, nothing is going to
+        if (active_trace_.first_step_micros != 0) {
+            active_trace_.settled_micros = CommandTrace::now();
+        }
+        completeTrace(active_trace_);
+        tracing_ = false;
+    }
+}
+
+void SplitflapTask::completeTrace(const CommandTrace& trace) {
+    CommandTrace completed = trace;
+    completed.completed_micros = CommandTrace::now();
+    // Dropped if nobody is collecting traces
+    xQueueSend(trace_done_queue_, &completed, 0);
+}
+
+void SplitflapTask::traceNextCommand(const CommandTrace& trace) {
+    xQueueOverwrite(trace_request_queue_, &trace);
+    trace_requested_.store(true, std::memory_order_release);
+}
+
+bool SplitflapTask::takeCompletedTrace(uint32_t source, CommandTrace& trace) {
+    SemaphoreGuard lock(trace_collect_semaphore_);
+    CommandTrace head;
+    while (xQueuePeek(trace_done_queue_, &head, 0) == pdTRUE) {
+        if (head.source == source) {
+            return xQueueReceive(trace_done_queue_, &trace, 0) == pdTRUE;
+        }
+        // Someone else's; leave it for them unless it's been waiting so long that they must have gone away
+        if (micros() - head.completed_micros < TRACE_TIMEOUT_MICROS) {
+            return false;
+        }
+        xQueueReceive(trace_done_queue_, &head, 0);
+    }
+    return false;
+}
+
+void SplitflapTask::logText(const char* text) {
+    if (logger_ == nullptr) {
+        return;
+    }
+    LogRecord record;
+    record.format = nullptr;
+    strlcpy(record.text, text, sizeof(record.text));
+    logger_->logRecord(record);
 }
 
 int8_t SplitflapTask::findFlapIndex(uint8_t character) {
@@ -347,103 +537,129 @@ int8_t SplitflapTask::findFlapIndex(uint8_t character) {
 }
 
 void SplitflapTask::updateStateCache() {
-    SplitflapState new_state;
+    SplitflapState new_state = {};
     new_state.mode = sensor_test_ ? SplitflapMode::MODE_SENSOR_TEST : SplitflapMode::MODE_RUN;
-    for (uint8_t i = 0; i < NUM_MODULES; i++) {
+    new_state.num_modules = num_modules_;
+    new_state.paused = paused_;
+    for (uint8_t i = 0; i < num_modules_; i++) {
       new_state.modules[i].flap_index = modules[i]->GetCurrentFlapIndex();
       new_state.modules[i].state = modules[i]->state;
       new_state.modules[i].moving = modules[i]->current_accel_step > 0;
       new_state.modules[i].home_state = modules[i]->GetHomeState();
-      new_state.modules[i].count_missed_home = modules[i]->count_missed_home;
-      new_state.modules[i].count_unexpected_home = modules[i]->count_unexpected_home;
+      new_state.counters[i].count_missed_home = modules[i]->count_missed_home;
+      new_state.counters[i].count_unexpected_home = modules[i]->count_unexpected_home;
     }
 
 #ifdef CHAINLINK
     new_state.loopbacks_ok = loopback_all_ok_;
 #endif
-    if (memcmp(&state_cache_, &new_state, sizeof(state_cache_))) {
-        SemaphoreGuard lock(state_semaphore_);
-        memcpy(&state_cache_, &new_state, sizeof(state_cache_));
-    }
-}
+    if (memcmp(&state_snapshot_.latest(), &new_state, sizeof(new_state))) {
+        const SplitflapState& old_state = state_snapshot_.latest();
+        StateChanges changes = {};
+        changes.global = old_state.mode != new_state.mode
+            || old_state.num_modules != new_state.num_modules
+            || old_state.paused != new_state.paused
+#ifdef CHAINLINK
+            || old_state.loopbacks_ok != new_state.loopbacks_ok
+#endif
+            ;
+        for (uint8_t i = 0; i < NUM_MODULES; i++) {
+            if (new_state.modules[i] != old_state.modules[i] || new_state.counters[i] != old_state.counters[i]) {
+                changes.modules[i / 32] |= 1UL << (i % 32);
+            }
+            if (new_state.modules[i].moving && !old_state.modules[i].moving) {
+                metrics_.module_moves[i]++;
+            }
+            if (new_state.modules[i].state == PANIC && old_state.modules[i].state != PANIC) {
+                logf("#### PANIC! #### Module %u", i);
+                logText(modules[i]->panic_message);
+            }
+        }
 
-void SplitflapTask::log(const char* msg) {
-    if (logger_ != nullptr) {
-        logger_->log(msg);
+        // Publish the new state before notifying, so subscribers always see (at least) the state they're woken for
+        state_snapshot_.publish(new_state);
+        state_bus_.publish(changes);
     }
 }
 
-void SplitflapTask::showString(const char* str, uint8_t length, bool force_full_rotation) {
-    Command command = {};
-    command.command_type = CommandType::MODULES;
+SubmitResult SplitflapTask::showString(const char* str, uint8_t length, bool force_full_rotation) {
+    SubmitResult result = SubmitResult::QUEUED;
     for (uint8_t i = 0; i < length && i < NUM_MODULES; i++) {
         int8_t index = findFlapIndex(str[i]);
         if (index != -1) {
-            if (force_full_rotation || index != modules[i]->GetTargetFlapIndex()) {
-                command.data.module_command[i] = QCMD_FLAP + index;
-            }
+            result = mergeSubmitResult(result, showFlapIndex(i, index, force_full_rotation));
         }
     }
-    assert(xQueueSendToBack(queue_, &command, portMAX_DELAY) == pdTRUE);
+    return result;
+}
+
+SubmitResult SplitflapTask::showFlapIndex(uint8_t id, uint8_t flap_index, bool force_full_rotation) {
+    // Always submitted (even if it matches where the module is headed), so it replaces any older pending target
+    CommandMailbox::ModuleTarget target = {};
+    target.force_full_rotation = force_full_rotation;
+    target.flap_index = flap_index;
+    return mailbox_.setTarget(id, target);
 }
 
-void SplitflapTask::resetAll() {
-    Command command = {};
-    command.command_type = CommandType::MODULES;
+SubmitResult SplitflapTask::resetAll() {
+    SubmitResult result = SubmitResult::QUEUED;
     for (uint8_t i = 0; i < NUM_MODULES; i++) {
-        command.data.module_command[i] = QCMD_RESET_AND_HOME;
+        result = mergeSubmitResult(result, mailbox_.addActions(i, CommandMailbox::ACTION_RESET_AND_HOME));
     }
-    assert(xQueueSendToBack(queue_, &command, portMAX_DELAY) == pdTRUE);
+    return result;
 }
 
 void SplitflapTask::disableAll() {
-    Command command = {};
-    command.command_type = CommandType::MODULES;
-    for (uint8_t i = 0; i < NUM_MODULES; i++) {
-        command.data.module_command[i] = QCMD_DISABLE;
-    }
-    assert(xQueueSendToBack(queue_, &command, portMAX_DELAY) == pdTRUE);
+    requestPriority(PRIORITY_DISABLE);
 }
 
-void SplitflapTask::setLed(const uint8_t id, const bool on) {
-    assert(led_mode_ == LedMode::MANUAL);
+void SplitflapTask::pause() {
+    requestPriority(PRIORITY_PAUSE);
+}
 
-    Command command = {};
-    command.command_type = CommandType::MODULES;
-    command.data.module_command[id] = on ? QCMD_LED_ON : QCMD_LED_OFF;
-    assert(xQueueSendToBack(queue_, &command, portMAX_DELAY) == pdTRUE);
+void SplitflapTask::resume() {
+    requestPriority(PRIORITY_RESUME);
 }
 
-void SplitflapTask::setSensorTest(bool sensor_test) {
-    Command command = {};
-    command.command_type = sensor_test ? CommandType::SENSOR_TEST_SET : CommandType::SENSOR_TEST_CLEAR;
-    assert(xQueueSendToBack(queue_, &command, portMAX_DELAY) == pdTRUE);
+SubmitResult SplitflapTask::setLed(const uint8_t id, const bool on) {
+    assert(led_mode_ == LedMode::MANUAL);
+    return mailbox_.setLed(id, on);
+}
+
+SubmitResult SplitflapTask::setSensorTest(bool sensor_test) {
+    return mailbox_.setSensorTest(sensor_test);
 }
 
 SplitflapState SplitflapTask::getState() {
-    SemaphoreGuard lock(state_semaphore_);
-    return state_cache_;
+    return state_snapshot_.read();
+}
+
+bool SplitflapTask::getStateIfChanged(uint32_t& version, SplitflapState& out) {
+    return state_snapshot_.readIfChanged(version, out);
+}
+
+int8_t SplitflapTask::subscribeState() {
+    return state_bus_.subscribe();
 }
 
-void SplitflapTask::increaseOffsetTenth(const uint8_t id) {
-    Command command = {};
-    command.command_type = CommandType::MODULES;
-    command.data.module_command[id] = QCMD_INCR_OFFSET_TENTH;
-    assert(xQueueSendToBack(queue_, &command, portMAX_DELAY) == pdTRUE);
+bool SplitflapTask::waitForStateChange(TickType_t timeout) {
+    return state_bus_.wait(timeout);
 }
 
-void SplitflapTask::increaseOffsetHalf(const uint8_t id) {
-    Command command = {};
-    command.command_type = CommandType::MODULES;
-    command.data.module_command[id] = QCMD_INCR_OFFSET_HALF;
-    assert(xQueueSendToBack(queue_, &command, portMAX_DELAY) == pdTRUE);
+void SplitflapTask::takeStateChanges(int8_t subscriber, StateChanges& changes) {
+    state_bus_.take(subscriber, changes);
 }
 
-void SplitflapTask::setOffset(const uint8_t id) {
-    Command command = {};
-    command.command_type = CommandType::MODULES;
-    command.data.module_command[id] = QCMD_SET_OFFSET;
-    assert(xQueueSendToBack(queue_, &command, portMAX_DELAY) == pdTRUE);
+SubmitResult SplitflapTask::increaseOffsetTenth(const uint8_t id) {
+    return mailbox_.increaseOffset(id, 1);
+}
+
+SubmitResult SplitflapTask::increaseOffsetHalf(const uint8_t id) {
+    return mailbox_.increaseOffset(id, 5);
+}
+
+SubmitResult SplitflapTask::setOffset(const uint8_t id) {
+    return mailbox_.addActions(id, CommandMailbox::ACTION_SET_OFFSET);
 }
 
 void SplitflapTask::setConfiguration(Configuration* configuration) {
@@ -455,21 +671,96 @@ void SplitflapTask::setLogger(Logger* logger) {
     logger_ = logger;
 }
 
-void SplitflapTask::postRawCommand(Command command) {
-    assert(xQueueSendToBack(queue_, &command, portMAX_DELAY) == pdTRUE);
+SubmitResult SplitflapTask::postRawCommand(const Command& command) {
+    SubmitResult result = SubmitResult::QUEUED;
+    switch (command.command_type) {
+        case CommandType::MODULES:
+            for (uint8_t i = 0; i < NUM_MODULES; i++) {
+                uint8_t module_command = command.data.module_command[i];
+                switch (module_command) {
+                    case QCMD_NO_OP:
+                        break;
+                    case QCMD_RESET_AND_HOME:
+                        result = mergeSubmitResult(result, mailbox_.addActions(i, CommandMailbox::ACTION_RESET_AND_HOME));
+                        break;
+                    case QCMD_LED_ON:
+                    case QCMD_LED_OFF:
+                        result = mergeSubmitResult(result, mailbox_.setLed(i, module_command == QCMD_LED_ON));
+                        break;
+                    case QCMD_DISABLE:
+                        result = mergeSubmitResult(result, mailbox_.addActions(i, CommandMailbox::ACTION_DISABLE));
+                        break;
+                    case QCMD_INCR_OFFSET_TENTH:
+                        result = mergeSubmitResult(result, mailbox_.increaseOffset(i, 1));
+                        break;
+                    case QCMD_INCR_OFFSET_HALF:
+                        result = mergeSubmitResult(result, mailbox_.increaseOffset(i, 5));
+                        break;
+                    case QCMD_SET_OFFSET:
+                        result = mergeSubmitResult(result, mailbox_.addActions(i, CommandMailbox::ACTION_SET_OFFSET));
+                        break;
+                    default: {
+                        CommandMailbox::ModuleTarget target = {};
+                        if (module_command < QCMD_FLAP) {
+                            result = SubmitResult::REJECTED;
+                            break;
+                        }
+                        target.force_full_rotation = true;
+                        target.flap_index = module_command - QCMD_FLAP;
+                        result = mergeSubmitResult(result, mailbox_.setTarget(i, target));
+                        break;
+                    }
+                }
+            }
+            break;
+        case CommandType::SENSOR_TEST_SET:
+        case CommandType::SENSOR_TEST_CLEAR:
+            result = mailbox_.setSensorTest(command.command_type == CommandType::SENSOR_TEST_SET);
+            break;
+        case CommandType::CONFIG:
+            for (uint8_t i = 0; i < NUM_MODULES; i++) {
+                const ModuleConfig& config = command.data.module_configs.config[i];
+                CommandMailbox::ModuleTarget target = {};
+                target.is_config = true;
+                target.flap_index = config.target_flap_index;
+                target.movement_nonce = config.movement_nonce;
+                target.reset_nonce = config.reset_nonce;
+                result = mergeSubmitResult(result, mailbox_.setTarget(i, target));
+            }
+            break;
+        case CommandType::SAVE_ALL_OFFSETS:
+            result = mailbox_.saveAllOffsets();
+            break;
+        case CommandType::RESTORE_ALL_OFFSETS:
+            result = restoreAllOffsets(command.data.module_offsets);
+            break;
+        default:
+            result = SubmitResult::REJECTED;
+            break;
+    }
+    return result;
 }
 
-void SplitflapTask::saveAllOffsets() {
-    Command command = {};
-    command.command_type = CommandType::SAVE_ALL_OFFSETS;
-    assert(xQueueSendToBack(queue_, &command, portMAX_DELAY) == pdTRUE);
+SubmitResult SplitflapTask::saveAllOffsets() {
+    return mailbox_.saveAllOffsets();
 }
 
-void SplitflapTask::restoreAllOffsets(uint16_t offsets[NUM_MODULES]) {
-    Command command = {};
-    command.command_type = CommandType::RESTORE_ALL_OFFSETS;
+SubmitResult SplitflapTask::restoreAllOffsets(const uint16_t offsets[NUM_MODULES]) {
+    SubmitResult result = SubmitResult::QUEUED;
     for (uint8_t i = 0; i < NUM_MODULES; i++) {
-        command.data.module_offsets[i] = offsets[i];
+        result = mergeSubmitResult(result, mailbox_.restoreOffset(i, offsets[i]));
     }
-    assert(xQueueSendToBack(queue_, &command, portMAX_DELAY) == pdTRUE);
+    return result;
+}
+
+MailboxStats SplitflapTask::getMailboxStats() {
+    return mailbox_.getStats();
+}
+
+PriorityLaneStats SplitflapTask::getPriorityLaneStats() {
+    return {
+        .requests_handled = priority_requests_handled_.load(std::memory_order_relaxed),
+        .last_latency_micros = priority_last_latency_micros_.load(std::memory_order_relaxed),
+        .max_latency_micros = priority_max_latency_micros_.load(std::memory_order_relaxed),
+    };
 }
@@ -15,8 +15,14 @@
 */
 #pragma once
 
+#include <atomic>
+
 #include "config.h"
+#include "command_mailbox.h"
+#include "histogram.h"
 #include "logger.h"
+#include "snapshot_buffer.h"
+#include "state_bus.h"
 #include "splitflap_module_data.h"
 #include "configuration.h"
 
@@ -27,31 +33,55 @@ enum class SplitflapMode {
     MODE_SENSOR_TEST,
 };
 
+// Frequently-changing module state, packed into 16 bits since the whole SplitflapState is copied and compared often
 struct SplitflapModuleState {
-    State state;
-    uint8_t flap_index;
-    bool moving;
-    bool home_state;
-    uint8_t count_unexpected_home;
-    uint8_t count_missed_home;
+    // A State value
+    uint16_t state : 3;
+    uint16_t flap_index : 6;
+    uint16_t moving : 1;
+    uint16_t home_state : 1;
 
-    bool operator==(const SplitflapModuleState& other) {
+    bool operator==(const SplitflapModuleState& other) const {
         return state == other.state
             && flap_index == other.flap_index
             && moving == other.moving
-            && home_state == other.home_state
-            && count_unexpected_home == other.count_unexpected_home
+            && home_state == other.home_state;
+    }
+
+    bool operator!=(const SplitflapModuleState& other) const {
+        return !(*this == other);
+    }
+};
+static_assert(sizeof(SplitflapModuleState) == 2, "SplitflapModuleState should be packed into 16 bits");
+static_assert(STATE_DISABLED < (1 << 3), "State doesn't fit in SplitflapModuleState::state");
+static_assert(NUM_FLAPS <= (1 << 6), "Flap index doesn't fit in SplitflapModuleState::flap_index");
+
+// Error counters, which change rarely; kept separate from SplitflapModuleState so they don't bloat the hot path
+struct SplitflapModuleCounters {
+    uint8_t count_unexpected_home;
+    uint8_t count_missed_home;
+
+    bool operator==(const SplitflapModuleCounters& other) const {
+        return count_unexpected_home == other.count_unexpected_home
             && count_missed_home == other.count_missed_home;
     }
 
-    bool operator!=(const SplitflapModuleState& other) {
+    bool operator!=(const SplitflapModuleCounters& other) const {
         return !(*this == other);
     }
 };
 
 struct SplitflapState {
     SplitflapMode mode;
+
+    // Number of modules actually connected (<= NUM_MODULES); only the first num_modules entries are meaningful.
+    // 0 until the splitflap task has finished starting up.
+    uint8_t num_modules;
     SplitflapModuleState modules[NUM_MODULES];
+    SplitflapModuleCounters counters[NUM_MODULES];
+
+    // All motion is paused (see SplitflapTask::pause)
+    bool paused = false;
 
 #ifdef CHAINLINK
     bool loopbacks_ok = false;
@@ -59,12 +89,14 @@ struct SplitflapState {
 
     bool operator==(const SplitflapState& other) {
         for (uint8_t i = 0; i < NUM_MODULES; i++) {
-            if (modules[i] != other.modules[i]) {
+            if (modules[i] != other.modules[i] || counters[i] != other.counters[i]) {
                 return false;
             }
         }
 
         return mode == other.mode
+            && num_modules == other.num_modules
+            && paused == other.paused
 #ifdef CHAINLINK
             && loopbacks_ok == other.loopbacks_ok
 #endif
@@ -110,6 +142,48 @@ struct Command {
     CommandData data;
 };
 
+// Motor loop and per-module counters, published by the splitflap task every METRICS_PUBLISH_MILLIS
+struct SplitflapMetrics {
+    // Time between the starts of successive module update passes, and taken by each pass's shift register transfer
+    MicrosHistogram loop_period;
+    MicrosHistogram io_transfer;
+    // Number of times each module has started moving, and steps it has taken
+    uint32_t module_moves[NUM_MODULES];
+    uint32_t module_steps[NUM_MODULES];
+};
+
+struct PriorityLaneStats {
+    uint32_t requests_handled;
+    // Time from request to handling by the splitflap task
+    uint32_t last_latency_micros;
+    uint32_t max_latency_micros;
+};
+
+// Timestamps (device micros()) of each stage of handling a traced command, from receiving it to every module settling.
+// A stage that didn't happen (e.g. no module had to move) is 0.
+struct CommandTrace {
+    // Identifies the command to whoever asked for the trace (e.g. the serial protocol's message nonce)
+    uint32_t id;
+    // Identifies whoever asked for the trace, when there are several (e.g. one per protocol session)
+    uint32_t source;
+    uint32_t received_micros;
+    uint32_t posted_micros;
+    // Splitflap task took the command from the mailbox
+    uint32_t dequeued_micros;
+    // End of the first update pass in which a module moved
+    uint32_t first_step_micros;
+    // End of the first update pass after that in which every module was stopped
+    uint32_t settled_micros;
+    // When the trace was handed over for collection
+    uint32_t completed_micros;
+
+    // micros(), but never 0
+    static uint32_t now() {
+        uint32_t micros_now = micros();
+        return micros_now == 0 ? 1 : micros_now;
+    }
+};
+
 #define QCMD_NO_OP              0
 #define QCMD_RESET_AND_HOME     1
 #define QCMD_LED_ON             2
@@ -127,22 +201,54 @@ class SplitflapTask : public Task<SplitflapTask> {
         SplitflapTask(const uint8_t task_core, const LedMode led_mode);
         ~SplitflapTask();
         
+        // State snapshots never block the splitflap task. Use getStateIfChanged to poll without copying unchanged state;
+        // pass a version of 0 to get the first published state.
         SplitflapState getState();
+        bool getStateIfChanged(uint32_t& version, SplitflapState& out);
+
+        // State change notifications. A subscribed task can sleep in waitForStateChange() until the state changes, then
+        // use takeStateChanges() to find out which modules (if any) it needs to look at. Take changes *before* reading the
+        // state, and only clear them once a newer state has actually been read.
+        int8_t subscribeState();
+        bool waitForStateChange(TickType_t timeout);
+        void takeStateChanges(int8_t subscriber, StateChanges& changes);
+
+        // Commands never block; they're merged into the command mailbox and applied on the next loop iteration.
+        SubmitResult showString(const char *str, uint8_t length, bool force_full_rotation = FORCE_FULL_ROTATION);
+        SubmitResult showFlapIndex(uint8_t id, uint8_t flap_index, bool force_full_rotation = FORCE_FULL_ROTATION);
+        SubmitResult resetAll();
+        SubmitResult setLed(uint8_t id, bool on);
+        SubmitResult setSensorTest(bool sensor_test);
+
+        SubmitResult increaseOffsetTenth(uint8_t id);
+        SubmitResult increaseOffsetHalf(uint8_t id);
+        SubmitResult setOffset(uint8_t id);
+        SubmitResult saveAllOffsets();
+        SubmitResult restoreAllOffsets(const uint16_t offsets[NUM_MODULES]);
 
-        void showString(const char *str, uint8_t length, bool force_full_rotation = FORCE_FULL_ROTATION);
-        void resetAll();
-        void disableAll();
-        void setLed(uint8_t id, bool on);
-        void setSensorTest(bool sensor_test);
+        void setLogger(Logger* logger);
+        SubmitResult postRawCommand(const Command& command);
 
-        void increaseOffsetTenth(uint8_t id);
-        void increaseOffsetHalf(uint8_t id);
-        void setOffset(uint8_t id);
-        void saveAllOffsets();
-        void restoreAllOffsets(uint16_t offsets[NUM_MODULES]);
+        MailboxStats getMailboxStats();
 
-        void setLogger(Logger* logger);
-        void postRawCommand(Command command);
+        // Never blocks the splitflap task; up to METRICS_PUBLISH_MILLIS old
+        void getMetrics(SplitflapMetrics& out);
+
+        // Latency tracing. Call traceNextCommand just *before* posting a command; the next mailbox drain is
+        // attributed to it (if nothing is drained within TRACE_TIMEOUT_MICROS, the trace completes without it).
+        // Only one command is traced at a time; a new trace completes the previous one early. Completed traces are
+        // collected by their source with takeCompletedTrace (never blocks); ones nobody collects within
+        // TRACE_TIMEOUT_MICROS (e.g. because the source went away) are discarded.
+        void traceNextCommand(const CommandTrace& trace);
+        bool takeCompletedTrace(uint32_t source, CommandTrace& trace);
+
+        // Out-of-band controls. These bypass the command mailbox and are checked before every module update, so
+        // they're handled within a single module update (plus one shift register transfer) of being requested.
+        // If a pause and resume are both pending, the pause wins.
+        void disableAll();
+        void pause();
+        void resume();
+        PriorityLaneStats getPriorityLaneStats();
 
         void setConfiguration(Configuration* configuration);
 
@@ -150,18 +256,51 @@ class SplitflapTask : public Task<SplitflapTask> {
         void run();
 
     private:
+        enum : uint32_t {
+            PRIORITY_DISABLE = 1 << 0,
+            PRIORITY_PAUSE = 1 << 1,
+            PRIORITY_RESUME = 1 << 2,
+            PRIORITY_FLAGS_MASK = 0x7,
+        };
+
+        enum : uint32_t {
+            TRACE_QUEUE_SIZE = 8,
+            TRACE_TIMEOUT_MICROS = 1000000,
+            METRICS_PUBLISH_MILLIS = 1000,
+        };
+
         const LedMode led_mode_;
-        const SemaphoreHandle_t state_semaphore_;
         const SemaphoreHandle_t configuration_semaphore_;
-        QueueHandle_t queue_;
-        Command queue_receive_buffer_ = {};
+        CommandMailbox mailbox_;
         Logger* logger_;
+
+        // Out-of-band control requests: PRIORITY_* flags in the low bits, and the time (micros) the oldest unhandled one
+        // was made in the rest, so both are taken together. 0 if none are waiting.
+        std::atomic<uint32_t> priority_requests_ = {};
+        std::atomic<uint32_t> priority_requests_handled_ = {};
+        std::atomic<uint32_t> priority_last_latency_micros_ = {};
+        std::atomic<uint32_t> priority_max_latency_micros_ = {};
+        bool paused_ = false;
+
+        // Trace requests (latest wins) and completed traces. trace_requested_ keeps checking for a request to a single load.
+        const QueueHandle_t trace_request_queue_;
+        const QueueHandle_t trace_done_queue_;
+        // Held by collectors while they look at the head of trace_done_queue_ (the splitflap task never takes it)
+        const SemaphoreHandle_t trace_collect_semaphore_;
+        std::atomic<bool> trace_requested_ = {};
+        CommandTrace pending_trace_ = {};
+        bool trace_pending_ = false;
+        CommandTrace active_trace_ = {};
+        bool tracing_ = false;
         
         // Protected by configuration_semaphore_
         Configuration* configuration_;
 
         bool all_stopped_ = true;
 
+        // Number of connected modules; detected at startup for Chainlink, otherwise NUM_MODULES
+        uint8_t num_modules_ = NUM_MODULES;
+
         uint32_t last_sensor_print_millis_ = 0;
         bool sensor_test_ = SENSOR_TEST;
         ModuleConfigs current_configs_ = {};
@@ -173,14 +312,40 @@ class SplitflapTask : public Task<SplitflapTask> {
         bool loopback_all_ok_ = false;
 #endif
 
-        // Cached state. Protected by state_semaphore_
-        SplitflapState state_cache_;
+        // Published state; only written by the splitflap task
+        SnapshotBuffer<SplitflapState> state_snapshot_;
+        StateBus state_bus_;
         void updateStateCache();
 
+        // Metrics are accumulated in metrics_ and published periodically, so the motor loop only pays for the copy
+        // once in a while
+        SplitflapMetrics metrics_ = {};
+        SnapshotBuffer<SplitflapMetrics> metrics_snapshot_;
+        uint32_t last_pass_micros_ = 0;
+        uint32_t metrics_published_millis_ = 0;
+        void publishMetrics();
+
+        void requestPriority(uint32_t request);
+        void handlePriorityRequests();
         void processQueue();
+        void updateTrace();
+        void completeTrace(const CommandTrace& trace);
+        void applyModuleActions(uint8_t i, const CommandMailbox::ModuleActions& actions);
+        void applyModuleTarget(uint8_t i, const CommandMailbox::ModuleTarget& target);
+        void saveOffsets();
         void runUpdate();
         void sensorTestUpdate();
-        void log(const char* msg);
+
+        // Logging from this task must not allocate or wait for the serial port, so messages are only formatted later
+        template <typename... Args>
+        void logf(const char* format, Args... args) {
+            if (logger_ != nullptr) {
+                logger_->logf(format, args...);
+            }
+        }
+
+        // For text that isn't a string literal (so can't be a format); it's copied, truncated if necessary
+        void logText(const char* text);
 
         int8_t findFlapIndex(uint8_t character);
 };
@@ -0,0 +1,66 @@
+/*
+   Copyright 2021 Scott Bezek and the splitflap contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "state_bus.h"
+
+int8_t StateBus::subscribe() {
+    uint8_t id = num_subscribers_.fetch_add(1, std::memory_order_relaxed);
+    if (id >= MAX_SUBSCRIBERS) {
+        num_subscribers_.fetch_sub(1, std::memory_order_relaxed);
+        return -1;
+    }
+
+    Subscriber& subscriber = subscribers_[id];
+    subscriber.task = xTaskGetCurrentTaskHandle();
+    // Everything is dirty to begin with
+    subscriber.global.store(1, std::memory_order_relaxed);
+    for (uint8_t i = 0; i < STATE_DIRTY_WORDS; i++) {
+        subscriber.modules[i].store(UINT32_MAX, std::memory_order_relaxed);
+    }
+    subscriber.ready.store(true, std::memory_order_release);
+    return id;
+}
+
+void StateBus::publish(const StateChanges& changes) {
+    if (!changes.any()) {
+        return;
+    }
+
+    uint8_t count = min((uint8_t)MAX_SUBSCRIBERS, num_subscribers_.load(std::memory_order_relaxed));
+    for (uint8_t s = 0; s < count; s++) {
+        Subscriber& subscriber = subscribers_[s];
+        if (!subscriber.ready.load(std::memory_order_acquire)) {
+            continue;
+        }
+        if (changes.global) {
+            subscriber.global.store(1, std::memory_order_relaxed);
+        }
+        for (uint8_t i = 0; i < STATE_DIRTY_WORDS; i++) {
+            if (changes.modules[i] != 0) {
+                subscriber.modules[i].fetch_or(changes.modules[i], std::memory_order_relaxed);
+            }
+        }
+        xTaskNotifyGive(subscriber.task);
+    }
+}
+
+void StateBus::take(int8_t subscriber_id, StateChanges& out) {
+    assert(subscriber_id >= 0 && subscriber_id < MAX_SUBSCRIBERS);
+    Subscriber& subscriber = subscribers_[subscriber_id];
+    out.global |= subscriber.global.exchange(0, std::memory_order_acquire) != 0;
+    for (uint8_t i = 0; i < STATE_DIRTY_WORDS; i++) {
+        out.modules[i] |= subscriber.modules[i].exchange(0, std::memory_order_acquire);
+    }
+}
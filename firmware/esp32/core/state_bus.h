@@ -0,0 +1,86 @@
+/*
+   Copyright 2021 Scott Bezek and the splitflap contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+
+#include "config.h"
+
+#define STATE_DIRTY_WORDS ((NUM_MODULES + 31) / 32)
+
+// Everything that changed since a subscriber last took its changes
+struct StateChanges {
+    // Mode, module count, pause or loopback status changed
+    bool global;
+    uint32_t modules[STATE_DIRTY_WORDS];
+
+    bool module(uint8_t i) const {
+        return (modules[i / 32] & (1UL << (i % 32))) != 0;
+    }
+
+    bool any() const {
+        for (uint8_t i = 0; i < STATE_DIRTY_WORDS; i++) {
+            if (modules[i] != 0) {
+                return true;
+            }
+        }
+        return global;
+    }
+};
+
+/**
+ * Notifies subscriber tasks of splitflap state changes.
+ *
+ * Each subscriber has its own set of dirty bits (one per module, plus one for the rest of the state), which the
+ * publisher ORs changes into before waking the subscriber with a task notification. Changes accumulate until the
+ * subscriber takes them, so a subscriber that's slow to wake up just sees a larger set of changes rather than missing
+ * any.
+ */
+class StateBus {
+    public:
+        enum : uint8_t {
+            MAX_SUBSCRIBERS = 6,
+        };
+
+        StateBus() {}
+        StateBus(StateBus const&)=delete;
+        StateBus& operator=(StateBus const&)=delete;
+
+        // Subscribes the calling task. Returns the subscriber id, or -1 if there are already MAX_SUBSCRIBERS.
+        int8_t subscribe();
+
+        // Publisher API - must only be called from a single task.
+        void publish(const StateChanges& changes);
+
+        // Subscriber API. Blocks the calling task until there may be new changes, or the timeout expires.
+        bool wait(TickType_t timeout) {
+            return ulTaskNotifyTake(pdTRUE, timeout) > 0;
+        }
+        // Adds the accumulated changes to out and clears them.
+        void take(int8_t subscriber, StateChanges& out);
+
+    private:
+        struct Subscriber {
+            std::atomic<bool> ready;
+            TaskHandle_t task;
+            std::atomic<uint32_t> global;
+            std::atomic<uint32_t> modules[STATE_DIRTY_WORDS];
+        };
+
+        std::atomic<uint8_t> num_subscribers_ = {};
+        Subscriber subscribers_[MAX_SUBSCRIBERS] = {};
+};
@@ -0,0 +1,114 @@
+/*
+   Copyright 2024 Scott Bezek and the splitflap contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include <errno.h>
+#include <lwip/sockets.h>
+
+#include "tcp_stream.h"
+
+TcpStream::TcpStream(int socket) : Stream(), socket_(socket) {
+    int flags = fcntl(socket_, F_GETFL, 0);
+    fcntl(socket_, F_SETFL, flags | O_NONBLOCK);
+
+    // Protocol messages are small and latency matters more than packet count
+    int no_delay = 1;
+    setsockopt(socket_, IPPROTO_TCP, TCP_NODELAY, &no_delay, sizeof(no_delay));
+}
+
+TcpStream::~TcpStream() {
+    ::close(socket_);
+}
+
+bool TcpStream::wouldBlock() {
+    return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+}
+
+bool TcpStream::fillRxBuffer() {
+    if (rx_buffer_start_ < rx_buffer_end_) {
+        return true;
+    }
+    rx_buffer_start_ = 0;
+    rx_buffer_end_ = 0;
+    if (!connected_) {
+        return false;
+    }
+    int count = recv(socket_, rx_buffer_, sizeof(rx_buffer_), MSG_DONTWAIT);
+    if (count > 0) {
+        rx_buffer_end_ = count;
+        return true;
+    }
+    if (count == 0 || !wouldBlock()) {
+        connected_ = false;
+    }
+    return false;
+}
+
+int TcpStream::peek() {
+    return fillRxBuffer() ? rx_buffer_[rx_buffer_start_] : -1;
+}
+
+int TcpStream::available() {
+    int size = 0;
+    if (connected_ && ioctl(socket_, FIONREAD, &size) < 0) {
+        size = 0;
+    }
+    return size + rx_buffer_end_ - rx_buffer_start_;
+}
+
+int TcpStream::read() {
+    return fillRxBuffer() ? rx_buffer_[rx_buffer_start_++] : -1;
+}
+
+void TcpStream::flush() {
+    pump();
+}
+
+bool TcpStream::pump() {
+    while (connected_ && tx_buffer_count_ > 0) {
+        size_t contiguous = min((size_t)tx_buffer_count_, (size_t)(TX_BUFFER_SIZE - tx_buffer_start_));
+        int sent = send(socket_, &tx_buffer_[tx_buffer_start_], contiguous, MSG_DONTWAIT);
+        if (sent < 0) {
+            if (!wouldBlock()) {
+                connected_ = false;
+            }
+            break;
+        }
+        tx_buffer_start_ = (tx_buffer_start_ + sent) % TX_BUFFER_SIZE;
+        tx_buffer_count_ -= sent;
+    }
+    return connected_;
+}
+
+size_t TcpStream::write(uint8_t b) {
+    return write(&b, 1);
+}
+
+size_t TcpStream::write(const uint8_t *buffer, size_t size) {
+    if (!connected_) {
+        // Nobody to send it to
+        return size;
+    }
+    size_t count = min(size, (size_t)(TX_BUFFER_SIZE - tx_buffer_count_));
+    size_t end = (tx_buffer_start_ + tx_buffer_count_) % TX_BUFFER_SIZE;
+    size_t first = min(count, (size_t)(TX_BUFFER_SIZE - end));
+    memcpy(&tx_buffer_[end], buffer, first);
+    memcpy(tx_buffer_, buffer + first, count - first);
+    tx_buffer_count_ += count;
+    return count;
+}
+
+int TcpStream::availableForWrite() {
+    return TX_BUFFER_SIZE - tx_buffer_count_;
+}
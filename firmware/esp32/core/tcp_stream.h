@@ -0,0 +1,78 @@
+/*
+   Copyright 2024 Scott Bezek and the splitflap contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * Arduino Stream over a connected TCP socket (lwip), for running the serial protocols over the network.
+ *
+ * Nothing blocks: reads only return what has already been received, and writes go into a local TX buffer, which
+ * pump() hands to the socket as fast as it will take it. availableForWrite() reports the free space in that buffer,
+ * so the protocols' TX backpressure works the same as it does for the UART.
+ */
+class TcpStream : public Stream {
+    public:
+        // Takes ownership of a connected socket (which is made non-blocking), closing it when destroyed
+        explicit TcpStream(int socket);
+        ~TcpStream();
+
+        int getSocket() {
+            return socket_;
+        }
+
+        // False once the peer has closed the connection or it has failed
+        bool connected() {
+            return connected_;
+        }
+
+        // Sends as much of the TX buffer as the socket will take without blocking. Returns false once disconnected.
+        bool pump();
+
+        // Stream methods
+        int available() override;
+        int read() override;
+        int peek() override;
+        void flush() override;
+
+        // Print methods. Anything that doesn't fit in the TX buffer is dropped (check availableForWrite first).
+        size_t write(uint8_t b) override;
+        size_t write(const uint8_t *buffer, size_t size) override;
+        int availableForWrite() override;
+
+    private:
+        enum : uint32_t {
+            RX_BUFFER_SIZE = 512,
+            // Leaves the protocol room for a full SplitflapState, with logs sent only while it's fairly empty
+            TX_BUFFER_SIZE = 12288,
+        };
+
+        const int socket_;
+        bool connected_ = true;
+
+        uint8_t rx_buffer_[RX_BUFFER_SIZE];
+        uint16_t rx_buffer_start_ = 0;
+        uint16_t rx_buffer_end_ = 0;
+
+        // Ring buffer
+        uint8_t tx_buffer_[TX_BUFFER_SIZE];
+        uint16_t tx_buffer_start_ = 0;
+        uint16_t tx_buffer_count_ = 0;
+
+        bool fillRxBuffer();
+        // Whether a failed socket call just means it would have blocked, rather than that the connection is gone
+        static bool wouldBlock();
+};
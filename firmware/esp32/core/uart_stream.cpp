@@ -15,16 +15,28 @@
 */
 
 #include <driver/uart.h>
+#include <esp_idf_version.h>
 
 #include "config.h"
 #include "uart_stream.h"
 
+// Driver buffers hold well over the serial task's maximum idle time (10ms) worth of data even at the fastest baud rate
+// a host can switch to (about 160ms at 2Mbaud)
+static const int RX_BUFFER_SIZE = 32000;
+static const int TX_BUFFER_SIZE = 32000;
+
+// Interrupt once the 128 byte hardware RX FIFO is half full, rather than the driver's default of nearly full, which
+// leaves too little time to empty it at high baud rates (the remaining 64 bytes take 320us at 2Mbaud)
+static const int RX_FULL_THRESHOLD = 64;
+static const int EVENT_QUEUE_SIZE = 20;
+static const int PATTERN_QUEUE_SIZE = 20;
+
 UartStream::UartStream() : Stream() {
 }
 
 void UartStream::begin() {
     uart_config_t conf;
-    conf.baud_rate           = MONITOR_SPEED;
+    conf.baud_rate           = baud_rate_;
     conf.data_bits           = UART_DATA_8_BITS;
     conf.parity              = UART_PARITY_DISABLE;
     conf.stop_bits           = UART_STOP_BITS_1;
@@ -32,33 +44,129 @@ void UartStream::begin() {
     conf.rx_flow_ctrl_thresh = 0;
     conf.use_ref_tick        = false;
     assert(uart_param_config(uart_port_, &conf) == ESP_OK);
-    assert(uart_driver_install(uart_port_, 32000, 32000, 0, NULL, 0) == ESP_OK);
+    assert(uart_driver_install(uart_port_, RX_BUFFER_SIZE, TX_BUFFER_SIZE, EVENT_QUEUE_SIZE, &event_queue_, 0) == ESP_OK);
+    assert(uart_set_rx_full_threshold(uart_port_, RX_FULL_THRESHOLD) == ESP_OK);
+
+    // Get an event as soon as a COBS delimiter arrives, rather than only once the line has been idle for the RX timeout
+    assert(uart_enable_pattern_det_baud_intr(uart_port_, 0x00, 1, 9, 0, 0) == ESP_OK);
+    assert(uart_pattern_queue_reset(uart_port_, PATTERN_QUEUE_SIZE) == ESP_OK);
+
+    // The driver's events are delivered on a queue, which a task can't wait on along with its other wake-up sources,
+    // so forward them as task notifications
+    notify_task_ = xTaskGetCurrentTaskHandle();
+    BaseType_t result = xTaskCreate(eventTask, "UartEvents", 2048, this, 2, NULL);
+    assert("Failed to create task" && result == pdPASS);
+}
+
+void UartStream::eventTask(void* params) {
+    UartStream* stream = static_cast<UartStream*>(params);
+    uart_event_t event;
+    while (1) {
+        if (xQueueReceive(stream->event_queue_, &event, portMAX_DELAY) != pdTRUE) {
+            continue;
+        }
+        switch (event.type) {
+            case UART_PATTERN_DET:
+                // Delimiter positions aren't needed (the protocol finds them as it reads), but the driver stops
+                // recording them once its queue is full
+                uart_pattern_pop_pos(stream->uart_port_);
+                break;
+            case UART_FIFO_OVF:
+            case UART_BUFFER_FULL:
+                // Whatever was received is incomplete now, so drop it and start again from the next delimiter
+                stream->rx_overflows_.fetch_add(1, std::memory_order_relaxed);
+                uart_flush_input(stream->uart_port_);
+                xQueueReset(stream->event_queue_);
+                break;
+            default:
+                break;
+        }
+        xTaskNotifyGive(stream->notify_task_);
+    }
+}
+
+bool UartStream::fillRxBuffer() {
+    if (rx_buffer_start_ < rx_buffer_end_) {
+        return true;
+    }
+    int count = uart_read_bytes(uart_port_, rx_buffer_, sizeof(rx_buffer_), 0);
+    rx_buffer_start_ = 0;
+    rx_buffer_end_ = count > 0 ? count : 0;
+    return rx_buffer_end_ > 0;
 }
 
 int UartStream::peek() {
-    return -1;
+    return fillRxBuffer() ? rx_buffer_[rx_buffer_start_] : -1;
 }
 
 int UartStream::available() {
     size_t size = 0;
     assert(uart_get_buffered_data_len(uart_port_, &size) == ESP_OK);
-    return size;
+    return size + rx_buffer_end_ - rx_buffer_start_;
 }
 
 int UartStream::read() {
-    uint8_t b;
-    int res = uart_read_bytes(uart_port_, &b, 1, 0);
-    return res != 1 ? -1 : b;
+    return fillRxBuffer() ? rx_buffer_[rx_buffer_start_++] : -1;
+}
+
+size_t UartStream::read(uint8_t* buffer, size_t size) {
+    size_t count = min(size, (size_t)(rx_buffer_end_ - rx_buffer_start_));
+    memcpy(buffer, &rx_buffer_[rx_buffer_start_], count);
+    rx_buffer_start_ += count;
+    if (count < size) {
+        int res = uart_read_bytes(uart_port_, buffer + count, size - count, 0);
+        if (res > 0) {
+            count += res;
+        }
+    }
+    return count;
 }
 
 void UartStream::flush() {
 
 }
 
+void UartStream::setBaudRate(uint32_t baud_rate) {
+    // Everything written so far was meant to go out at the old rate
+    uart_wait_tx_done(uart_port_, pdMS_TO_TICKS(1000));
+    assert(uart_set_baudrate(uart_port_, baud_rate) == ESP_OK);
+    baud_rate_ = baud_rate;
+
+    uart_flush_input(uart_port_);
+    rx_buffer_start_ = 0;
+    rx_buffer_end_ = 0;
+
+    #if ESP_IDF_VERSION < ESP_IDF_VERSION_VAL(5, 2, 0)
+    tx_estimate_bytes_ = 0;
+    tx_estimate_micros_ = micros();
+    #endif
+}
+
 size_t UartStream::write(uint8_t b) {
-    return uart_write_bytes(uart_port_, (char*)&b, 1);
+    return write(&b, 1);
 }
 
 size_t UartStream::write(const uint8_t *buffer, size_t size) {
+    #if ESP_IDF_VERSION < ESP_IDF_VERSION_VAL(5, 2, 0)
+    availableForWrite();
+    tx_estimate_bytes_ += size;
+    #endif
     return uart_write_bytes(uart_port_, (const char*)buffer, size);
 }
+
+int UartStream::availableForWrite() {
+    #if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 2, 0)
+    size_t size = 0;
+    assert(uart_get_tx_buffer_free_size(uart_port_, &size) == ESP_OK);
+    return size;
+    #else
+    // 10 bits per byte (8N1)
+    uint32_t now = micros();
+    uint32_t sent = (uint64_t)(now - tx_estimate_micros_) * baud_rate_ / 10 / 1000000;
+    if (sent > 0) {
+        tx_estimate_bytes_ -= min(sent, tx_estimate_bytes_);
+        tx_estimate_micros_ = now;
+    }
+    return max(0, TX_BUFFER_SIZE - (int)tx_estimate_bytes_);
+    #endif
+}
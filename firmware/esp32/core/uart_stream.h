@@ -17,21 +17,45 @@
 
 #include <Arduino.h>
 
+#include <atomic>
 #include <driver/uart.h>
 
+#include "config.h"
+
 /**
  * Implementation of an Arduino Stream for UART serial communications using the esp uart driver
  * directly, rather than the Arduino HAL which has a small fixed underlying rx FIFO size and
  * potentially other issues that cause dropped bytes at high speeds/bursts.
  * 
  * This is not a full or optimized implementation; just the minimal necessary for this project.
+ *
+ * Received bytes are read from the driver in bulk into a small local buffer, rather than with a uart_read_bytes call
+ * (which takes the driver's lock) per byte. Instead of polling, the reading task can block on its task notification,
+ * which is given when the driver detects a frame delimiter (0x00, which ends every COBS packet) or any other receive
+ * event.
  */
 class UartStream : public Stream {
     public:
         UartStream();
 
+        // Installs the driver. The calling task is the one notified (xTaskNotifyGive) of receive events.
         void begin();
 
+        // Reads up to size bytes that have already been received, without blocking. Returns the number read.
+        size_t read(uint8_t* buffer, size_t size);
+
+        // Changes the baud rate once everything already written has been sent. Anything partially received at the old
+        // rate is discarded.
+        void setBaudRate(uint32_t baud_rate);
+        uint32_t getBaudRate() {
+            return baud_rate_;
+        }
+
+        // Number of times received data was lost because the driver's buffers overflowed
+        uint32_t getRxOverflows() {
+            return rx_overflows_.load(std::memory_order_relaxed);
+        }
+
         // Stream methods
         int available() override;
         int read() override;
@@ -41,7 +65,26 @@ class UartStream : public Stream {
         // Print methods
         size_t write(uint8_t b) override;
         size_t write(const uint8_t *buffer, size_t size) override;
+        // Free space in the TX buffer; writes larger than this block until enough has been sent
+        int availableForWrite() override;
 
     private:
         const uart_port_t uart_port_ = UART_NUM_0;
+        uint32_t baud_rate_ = MONITOR_SPEED;
+
+        QueueHandle_t event_queue_;
+        TaskHandle_t notify_task_;
+        std::atomic<uint32_t> rx_overflows_ = {};
+
+        uint8_t rx_buffer_[256];
+        uint16_t rx_buffer_start_ = 0;
+        uint16_t rx_buffer_end_ = 0;
+
+        static void eventTask(void* params);
+        bool fillRxBuffer();
+
+        // Without uart_get_tx_buffer_free_size, the TX buffer usage is estimated from what's been written and how
+        // much could have been sent since at the configured baud rate
+        uint32_t tx_estimate_bytes_ = 0;
+        uint32_t tx_estimate_micros_ = 0;
 };
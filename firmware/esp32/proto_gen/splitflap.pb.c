@@ -18,6 +18,12 @@ PB_BIND(PB_Log, PB_Log, 2)
 PB_BIND(PB_Ack, PB_Ack, AUTO)
 
 
+PB_BIND(PB_CommandTrace, PB_CommandTrace, AUTO)
+
+
+PB_BIND(PB_ClockSync, PB_ClockSync, AUTO)
+
+
 PB_BIND(PB_SupervisorState, PB_SupervisorState, 2)
 
 
@@ -33,6 +39,9 @@ PB_BIND(PB_GeneralState, PB_GeneralState, AUTO)
 PB_BIND(PB_GeneralState_BuildInfo, PB_GeneralState_BuildInfo, AUTO)
 
 
+PB_BIND(PB_GeneralState_TxClassStats, PB_GeneralState_TxClassStats, AUTO)
+
+
 PB_BIND(PB_FromSplitflap, PB_FromSplitflap, 4)
 
 
@@ -51,6 +60,12 @@ PB_BIND(PB_SplitflapConfig_ModuleConfig, PB_SplitflapConfig_ModuleConfig, AUTO)
 PB_BIND(PB_RequestState, PB_RequestState, AUTO)
 
 
+PB_BIND(PB_SplitflapFrame, PB_SplitflapFrame, AUTO)
+
+
+PB_BIND(PB_SetBaudRate, PB_SetBaudRate, AUTO)
+
+
 PB_BIND(PB_ToSplitflap, PB_ToSplitflap, 2)
 
 
@@ -0,0 +1,89 @@
+/*
+   Copyright 2021 Scott Bezek and the splitflap contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "cobs.h"
+
+size_t cobsDecodeInPlace(uint8_t* buffer, size_t size) {
+    size_t read_index = 0;
+    size_t write_index = 0;
+    while (read_index < size) {
+        uint8_t code = buffer[read_index];
+        if (code == 0 || read_index + code > size) {
+            return 0;
+        }
+        read_index++;
+
+        // The block only ever moves towards the start of the buffer, possibly overlapping where it was
+        memmove(buffer + write_index, buffer + read_index, code - 1);
+        read_index += code - 1;
+        write_index += code - 1;
+        // Every block but the last (and maximum-length ones) ended with a zero
+        if (code != 0xFF && read_index != size) {
+            buffer[write_index++] = 0;
+        }
+    }
+    return write_index;
+}
+
+CobsWriter::CobsWriter(Print& out) :
+        out_(out),
+        buffer_size_(1),
+        code_index_(0),
+        code_(1) {
+}
+
+void CobsWriter::write(const uint8_t* data, size_t size) {
+    // Work on local copies of the block state; as members, every byte stored to buffer_ could alias them, forcing
+    // them to be reloaded for each byte
+    size_t buffer_size = buffer_size_;
+    uint8_t code = code_;
+    for (size_t i = 0; i < size; i++) {
+        if (data[i] != 0) {
+            buffer_[buffer_size++] = data[i];
+            if (++code != 0xFF) {
+                continue;
+            }
+        }
+        buffer_size_ = buffer_size;
+        code_ = code;
+        finishBlock();
+        buffer_size = buffer_size_;
+        code = code_;
+    }
+    buffer_size_ = buffer_size;
+    code_ = code;
+}
+
+void CobsWriter::end() {
+    buffer_[code_index_] = code_;
+    buffer_[buffer_size_++] = 0;
+    out_.write(buffer_, buffer_size_);
+
+    buffer_size_ = 1;
+    code_index_ = 0;
+    code_ = 1;
+}
+
+void CobsWriter::finishBlock() {
+    buffer_[code_index_] = code_;
+
+    // Make sure there's room for a maximum-size block (code byte plus 254 data bytes) and the delimiter
+    if (buffer_size_ + 256 > sizeof(buffer_)) {
+        out_.write(buffer_, buffer_size_);
+        buffer_size_ = 0;
+    }
+    code_index_ = buffer_size_++;
+    code_ = 1;
+}
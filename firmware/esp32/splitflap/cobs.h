@@ -0,0 +1,55 @@
+/*
+   Copyright 2021 Scott Bezek and the splitflap contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#pragma once
+
+#include <Arduino.h>
+
+// Decodes a COBS-encoded packet (without its 0x00 delimiter) in place; the decoded packet is never longer than the
+// encoded one, so it can overwrite it as it goes. Returns the decoded size, or 0 if the packet is malformed.
+size_t cobsDecodeInPlace(uint8_t* buffer, size_t size);
+
+/**
+ * COBS-encodes packets straight to an output stream.
+ *
+ * Packets can be written in several pieces, and are encoded through a small fixed buffer (which holds completed
+ * blocks until there's no longer room for another maximum-size block) instead of a second buffer the size of the
+ * whole encoded packet.
+ */
+class CobsWriter {
+    public:
+        CobsWriter(Print& out);
+        CobsWriter(CobsWriter const&)=delete;
+        CobsWriter& operator=(CobsWriter const&)=delete;
+
+        // Worst-case size of an encoded packet, including the delimiter
+        static size_t maxEncodedSize(size_t size) {
+            return size + size / 254 + 2;
+        }
+
+        void write(const uint8_t* data, size_t size);
+        // Finishes the current packet and writes out the delimiter
+        void end();
+
+    private:
+        Print& out_;
+        uint8_t buffer_[512];
+        size_t buffer_size_;
+        // Where the current block's code byte goes, and its value so far
+        size_t code_index_;
+        uint8_t code_;
+
+        void finishBlock();
+};
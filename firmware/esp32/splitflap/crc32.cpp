@@ -5,17 +5,94 @@
 
 #include "crc32.h"
 
-static uint32_t crc32_for_byte(uint32_t r) {
-  for(int j = 0; j < 8; ++j)
-    r = (r & 1? 0: (uint32_t)0xEDB88320L) ^ r >> 1;
-  return r ^ (uint32_t)0xFF000000L;
+#ifdef ESP32
+#include <esp_idf_version.h>
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(4, 2, 0)
+#include <esp_rom_crc.h>
+#define rom_crc32_le esp_rom_crc32_le
+#else
+#include <rom/crc.h>
+#define rom_crc32_le crc32_le
+#endif
+#endif
+
+/*
+ * Slice-by-8 lookup tables, generated at compile time: table n gives the CRC contribution of a byte followed by n zero
+ * bytes, so 8 bytes can be folded into the CRC per step instead of 1.
+ */
+namespace {
+
+constexpr uint32_t crc32_for_bit_steps(uint32_t r, int steps) {
+  return steps == 0 ? r : crc32_for_bit_steps((r & 1 ? (uint32_t)0xEDB88320L : 0) ^ r >> 1, steps - 1);
+}
+
+constexpr uint32_t crc32_next_slice(uint32_t previous) {
+  return (previous >> 8) ^ crc32_for_bit_steps(previous & 0xFF, 8);
+}
+
+constexpr uint32_t crc32_slice_entry(size_t slice, size_t i) {
+  return slice == 0 ? crc32_for_bit_steps(i, 8) : crc32_next_slice(crc32_slice_entry(slice - 1, i));
+}
+
+// C++11 stand-in for std::index_sequence, built in log(N) template recursion depth
+template <size_t... I> struct IndexSequence {};
+template <typename A, typename B> struct ConcatSequences;
+template <size_t... A, size_t... B> struct ConcatSequences<IndexSequence<A...>, IndexSequence<B...>> {
+  typedef IndexSequence<A..., (sizeof...(A) + B)...> type;
+};
+template <size_t N> struct MakeIndexSequence {
+  typedef typename ConcatSequences<typename MakeIndexSequence<N / 2>::type, typename MakeIndexSequence<N - N / 2>::type>::type type;
+};
+template <> struct MakeIndexSequence<0> { typedef IndexSequence<> type; };
+template <> struct MakeIndexSequence<1> { typedef IndexSequence<0> type; };
+
+struct Crc32Tables {
+  uint32_t t[8][0x100];
+};
+
+template <size_t... I>
+constexpr Crc32Tables make_crc32_tables(IndexSequence<I...>) {
+  return Crc32Tables{{
+    {crc32_slice_entry(0, I)...}, {crc32_slice_entry(1, I)...}, {crc32_slice_entry(2, I)...}, {crc32_slice_entry(3, I)...},
+    {crc32_slice_entry(4, I)...}, {crc32_slice_entry(5, I)...}, {crc32_slice_entry(6, I)...}, {crc32_slice_entry(7, I)...},
+  }};
+}
+
+constexpr Crc32Tables tables = make_crc32_tables(MakeIndexSequence<0x100>::type());
+
+static_assert(tables.t[0][1] == 0x77073096, "CRC32 table mismatch");
+
+uint32_t crc32_slice_by_8(const uint8_t* data, size_t n_bytes, uint32_t crc) {
+  crc = ~crc;
+  while (n_bytes >= 8) {
+    uint32_t lo = crc ^ (data[0] | data[1] << 8 | data[2] << 16 | (uint32_t)data[3] << 24);
+    uint32_t hi = data[4] | data[5] << 8 | data[6] << 16 | (uint32_t)data[7] << 24;
+    crc = tables.t[7][lo & 0xFF] ^ tables.t[6][(lo >> 8) & 0xFF] ^ tables.t[5][(lo >> 16) & 0xFF] ^ tables.t[4][lo >> 24]
+        ^ tables.t[3][hi & 0xFF] ^ tables.t[2][(hi >> 8) & 0xFF] ^ tables.t[1][(hi >> 16) & 0xFF] ^ tables.t[0][hi >> 24];
+    data += 8;
+    n_bytes -= 8;
+  }
+  while (n_bytes-- > 0) {
+    crc = tables.t[0][(crc ^ *data++) & 0xFF] ^ crc >> 8;
+  }
+  return ~crc;
+}
+
+#ifdef ESP32
+// The ROM implementation is used on target, as long as it agrees with the portable one (checked once, at startup,
+// before any tasks are running)
+const uint8_t check_data[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+const bool use_rom_crc = rom_crc32_le(0, check_data, sizeof(check_data)) == crc32_slice_by_8(check_data, sizeof(check_data), 0);
+#endif
+
 }
 
 void crc32(const void *data, size_t n_bytes, uint32_t* crc) {
-  static uint32_t table[0x100];
-  if(!*table)
-    for(size_t i = 0; i < 0x100; ++i)
-      table[i] = crc32_for_byte(i);
-  for(size_t i = 0; i < n_bytes; ++i)
-    *crc = table[(uint8_t)*crc ^ ((uint8_t*)data)[i]] ^ *crc >> 8;
+#ifdef ESP32
+  if (use_rom_crc) {
+    *crc = rom_crc32_le(*crc, (const uint8_t*)data, n_bytes);
+    return;
+  }
+#endif
+  *crc = crc32_slice_by_8((const uint8_t*)data, n_bytes, *crc);
 }
@@ -66,17 +66,21 @@ void DisplayTask::run() {
 
     uint8_t module_row, module_col;
     int32_t module_x, module_y;
-    SplitflapState last_state = {};
+    int8_t state_subscriber = splitflap_task_.subscribeState();
+    assert(state_subscriber >= 0);
+    StateChanges changes = {};
+    SplitflapState state = {};
+    uint32_t state_version = 0;
     String last_messages[countof(messages_)] = {};
     while(1) {
-        SplitflapState state = splitflap_task_.getState();
-        if (state != last_state) {
+        splitflap_task_.takeStateChanges(state_subscriber, changes);
+        if (changes.any() && splitflap_task_.getStateIfChanged(state_version, state)) {
             tft_.setTextSize(module_text_size);
-            for (uint8_t i = 0; i < NUM_MODULES; i++) {
-                SplitflapModuleState& s = state.modules[i];
-                if (s == last_state.modules[i]) {
+            for (uint8_t i = 0; i < state.num_modules; i++) {
+                if (!changes.global && !changes.module(i)) {
                     continue;
                 }
+                SplitflapModuleState& s = state.modules[i];
 
                 uint16_t background = 0x0000;
                 uint16_t foreground = 0xFFFF;
@@ -140,7 +144,7 @@ void DisplayTask::run() {
                 tft_.setCursor(module_x + 1, module_y + 2);
                 tft_.printf("%c", c);
             }
-            last_state = state;
+            changes = {};
         }
 
         const int message_height = 10;
@@ -165,7 +169,8 @@ void DisplayTask::run() {
             }
         }
 
-        delay(10);
+        // Sleep until the state changes, but still check for new messages periodically
+        splitflap_task_.waitForStateChange(pdMS_TO_TICKS(50));
     }
 }
 
@@ -17,7 +17,6 @@
 #include "http_task.h"
 
 #include <HTTPClient.h>
-#include <lwip/apps/sntp.h>
 #include <json11.hpp>
 #include <time.h>
 
@@ -224,64 +223,49 @@ bool HTTPTask::handleData(Json json) {
 }
 
 
-HTTPTask::HTTPTask(SplitflapTask& splitflap_task, DisplayTask& display_task, Logger& logger, const uint8_t task_core) :
+HTTPTask::HTTPTask(SplitflapTask& splitflap_task, DisplayTask& display_task, NetworkTask& network_task, Logger& logger, const uint8_t task_core) :
         Task("HTTP", 8192, 1, task_core),
         splitflap_task_(splitflap_task),
         display_task_(display_task),
+        network_task_(network_task),
         logger_(logger),
         wifi_client_() {
 }
 
-void HTTPTask::connectWifi() {
-    WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
-
-    // Disable WiFi sleep as it causes glitches on pin 39; see https://github.com/espressif/arduino-esp32/issues/4903#issuecomment-793187707
-    WiFi.setSleep(WIFI_PS_NONE);
-    
+void HTTPTask::waitForNetwork() {
     char buf[256];
 
-    logger_.log("Establishing connection to WiFi..");
-    snprintf(buf, sizeof(buf), "Wifi connecting to %s", WIFI_SSID);
-    display_task_.setMessage(1, String(buf));
-    while (WiFi.status() != WL_CONNECTED) {
-        delay(1000);
+    if (!network_task_.isConnected()) {
+        snprintf(buf, sizeof(buf), "Wifi connecting to %s", WIFI_SSID);
+        display_task_.setMessage(1, String(buf));
+        network_task_.waitForConnection();
     }
 
-    snprintf(buf, sizeof(buf), "Connected to network %s", WIFI_SSID);
-    logger_.log(buf);
-
-    // Sync SNTP
-    sntp_setoperatingmode(SNTP_OPMODE_POLL);
-
-    char server[] = "time.nist.gov"; // sntp_setservername takes a non-const char*, so use a non-const variable to avoid warning
-    sntp_setservername(0, server);
-    sntp_init();
-
-    logger_.log("Waiting for NTP time sync...");
-    snprintf(buf, sizeof(buf), "Syncing NTP time via %s...", server);
-    display_task_.setMessage(1, String(buf));
-    time_t now;
-    while (time(&now),now < 1625099485) {
-        delay(1000);
+    if (!network_task_.waitForTimeSync(0)) {
+        display_task_.setMessage(1, "Syncing NTP time...");
+        network_task_.waitForTimeSync();
     }
 
     setenv("TZ", TIMEZONE, 1);
     tzset();
-    strftime(buf, sizeof(buf), "Got time: %Y-%m-%d %H:%M:%S", localtime(&now));
+    time_t now;
+    time(&now);
+    strftime(buf, sizeof(buf), "Local time: %Y-%m-%d %H:%M:%S", localtime(&now));
     logger_.log(buf);
 }
 
 void HTTPTask::run() {
     char buf[max(NUM_MODULES + 1, 200)];
 
-    connectWifi();
+    waitForNetwork();
 
     bool stale = false;
     while(1) {
         long now = millis();
 
         bool update = false;
-        if (http_last_request_time_ == 0 || now - http_last_request_time_ > REQUEST_INTERVAL_MILLIS) {
+        // While WiFi is down, requests would only time out; the data goes stale and is fetched once it's back
+        if (network_task_.isConnected() && (http_last_request_time_ == 0 || now - http_last_request_time_ > REQUEST_INTERVAL_MILLIS)) {
             if (fetchData()) {
                 http_last_success_time_ = millis();
                 stale = false;
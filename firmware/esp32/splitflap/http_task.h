@@ -20,6 +20,7 @@
 #include <WiFi.h>
 
 #include "../core/logger.h"
+#include "../core/network_task.h"
 #include "../core/splitflap_task.h"
 #include "../core/task.h"
 
@@ -29,18 +30,19 @@ class HTTPTask : public Task<HTTPTask> {
     friend class Task<HTTPTask>; // Allow base Task to invoke protected run()
 
     public:
-        HTTPTask(SplitflapTask& splitflap_task, DisplayTask& display_task, Logger& logger, const uint8_t task_core);
+        HTTPTask(SplitflapTask& splitflap_task, DisplayTask& display_task, NetworkTask& network_task, Logger& logger, const uint8_t task_core);
 
     protected:
         void run();
 
     private:
-        void connectWifi();
+        void waitForNetwork();
         bool fetchData();
         bool handleData(json11::Json json);
 
         SplitflapTask& splitflap_task_;
         DisplayTask& display_task_;
+        NetworkTask& network_task_;
         Logger& logger_;
         WiFiClient wifi_client_;
         uint32_t http_last_request_time_ = 0;
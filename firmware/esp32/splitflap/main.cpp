@@ -40,19 +40,30 @@ DisplayTask displayTask(splitflapTask, 0);
 BaseSupervisorTask baseSupervisorTask(splitflapTask, serialTask, 0);
 #endif
 
+#if MQTT || HTTP || WEB_SERVER || PROTO_SERVER
+#include "../core/network_task.h"
+#include "secrets.h"
+NetworkTask networkTask(WIFI_SSID, WIFI_PASSWORD, 0);
+#endif
+
 #if MQTT
 #include "mqtt_task.h"
-MQTTTask mqttTask(splitflapTask, serialTask, 0);
+MQTTTask mqttTask(splitflapTask, networkTask, serialTask, 0);
 #endif
 
 #if HTTP
 #include "http_task.h"
-HTTPTask httpTask(splitflapTask, displayTask, serialTask, 0);
+HTTPTask httpTask(splitflapTask, displayTask, networkTask, serialTask, 0);
 #endif
 
 #if WEB_SERVER
 #include "web_server_task.h"
-WebServerTask webServerTask(splitflapTask, serialTask, 0, WEB_SERVER_PORT);
+WebServerTask webServerTask(splitflapTask, serialTask, networkTask, 0, WEB_SERVER_PORT);
+#endif
+
+#if PROTO_SERVER
+#include "proto_server_task.h"
+ProtoServerTask protoServerTask(splitflapTask, networkTask, serialTask, 0, PROTO_SERVER_PORT);
 #endif
 
 void setup() {
@@ -77,6 +88,12 @@ void setup() {
   displayTask.begin();
   #endif
 
+  // Started ahead of the tasks that use it, which wait for it to connect rather than holding up the rest of boot
+  #if MQTT || HTTP || WEB_SERVER || PROTO_SERVER
+  networkTask.setLogger(&serialTask);
+  networkTask.begin();
+  #endif
+
   #if MQTT
   mqttTask.begin();
   #endif
@@ -89,6 +106,10 @@ void setup() {
   webServerTask.begin();
   #endif
 
+  #if PROTO_SERVER
+  protoServerTask.begin();
+  #endif
+
   #ifdef CHAINLINK_BASE
   baseSupervisorTask.begin();
   #endif
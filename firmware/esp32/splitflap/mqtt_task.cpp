@@ -18,9 +18,10 @@
 #include "secrets.h"
 
 
-MQTTTask::MQTTTask(SplitflapTask& splitflap_task, Logger& logger, const uint8_t task_core) :
+MQTTTask::MQTTTask(SplitflapTask& splitflap_task, NetworkTask& network_task, Logger& logger, const uint8_t task_core) :
         Task("MQTT", 8192, 1, task_core),
         splitflap_task_(splitflap_task),
+        network_task_(network_task),
         logger_(logger),
         wifi_client_(),
         mqtt_client_(wifi_client_) {
@@ -28,22 +29,6 @@ MQTTTask::MQTTTask(SplitflapTask& splitflap_task, Logger& logger, const uint8_t
     mqtt_client_.setCallback(callback);
 }
 
-void MQTTTask::connectWifi() {
-    WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
-
-    // Disable WiFi sleep as it causes glitches on pin 39; see https://github.com/espressif/arduino-esp32/issues/4903#issuecomment-793187707
-    WiFi.setSleep(WIFI_PS_NONE);
-
-    while (WiFi.status() != WL_CONNECTED) {
-        delay(1000);
-        logger_.log("Establishing connection to WiFi..");
-    }
-
-    char buf[256];
-    snprintf(buf, sizeof(buf), "Connected to network %s", WIFI_SSID);
-    logger_.log(buf);
-}
-
 void MQTTTask::mqttCallback(char *topic, byte *payload, unsigned int length) {
     char buf[256];
     snprintf(buf, sizeof(buf), "Received mqtt callback for topic %s, length %u", topic, length);
@@ -69,10 +54,13 @@ void MQTTTask::connectMQTT() {
 }
 
 void MQTTTask::run() {
-    connectWifi();
+    network_task_.waitForConnection();
     connectMQTT();
 
     while(1) {
+        // Nothing to do while WiFi is down; the broker is reconnected to below once it's back
+        network_task_.waitForConnection();
+
         long now = millis();
         if (!mqtt_client_.connected() && (now - mqtt_last_connect_time_) > 5000) {
             logger_.log("Reconnecting MQTT");
@@ -18,6 +18,7 @@
 #include <Arduino.h>
 
 #include "../core/logger.h"
+#include "../core/network_task.h"
 #include "../core/splitflap_task.h"
 #include "../core/task.h"
 
@@ -29,19 +30,19 @@ class MQTTTask : public Task<MQTTTask> {
     friend class Task<MQTTTask>; // Allow base Task to invoke protected run()
 
     public:
-        MQTTTask(SplitflapTask& splitflapTask, Logger& logger, const uint8_t taskCore);
+        MQTTTask(SplitflapTask& splitflapTask, NetworkTask& networkTask, Logger& logger, const uint8_t taskCore);
 
     protected:
         void run();
 
     private:
         SplitflapTask& splitflap_task_;
+        NetworkTask& network_task_;
         Logger& logger_;
         WiFiClient wifi_client_;
         PubSubClient mqtt_client_;
         int mqtt_last_connect_time_ = 0;
 
-        void connectWifi();
         void connectMQTT();
         void mqttCallback(char *topic, byte *payload, unsigned int length);
 };
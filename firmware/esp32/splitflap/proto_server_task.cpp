@@ -0,0 +1,171 @@
+/*
+   Copyright 2024 Scott Bezek and the splitflap contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#if PROTO_SERVER
+#include <errno.h>
+#include <lwip/sockets.h>
+#include <new>
+#include <WiFi.h>
+
+#include "proto_server_task.h"
+
+// select() timeout; state changes don't wake select(), so this is also how long they can wait to be sent
+static const uint32_t MAX_IDLE_MICROS = 10000;
+
+ProtoServerTask::ProtoServerTask(SplitflapTask& splitflap_task, NetworkTask& network_task, Logger& logger, const uint8_t task_core, const uint16_t port) :
+        Task("ProtoServer", 12000, 1, task_core),
+        splitflap_task_(splitflap_task),
+        network_task_(network_task),
+        logger_(logger),
+        port_(port) {
+}
+
+bool ProtoServerTask::listen() {
+    listen_socket_ = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (listen_socket_ < 0) {
+        return false;
+    }
+
+    int reuse = 1;
+    setsockopt(listen_socket_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    struct sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons(port_);
+    if (bind(listen_socket_, (struct sockaddr*)&address, sizeof(address)) < 0 || ::listen(listen_socket_, MAX_SESSIONS) < 0) {
+        ::close(listen_socket_);
+        listen_socket_ = -1;
+        return false;
+    }
+
+    int flags = fcntl(listen_socket_, F_GETFL, 0);
+    fcntl(listen_socket_, F_SETFL, flags | O_NONBLOCK);
+    return true;
+}
+
+void ProtoServerTask::acceptSession(const SplitflapState& state) {
+    struct sockaddr_in address = {};
+    socklen_t address_size = sizeof(address);
+    int client_socket = accept(listen_socket_, (struct sockaddr*)&address, &address_size);
+    if (client_socket < 0) {
+        return;
+    }
+
+    char buf[100];
+    char address_str[16];
+    inet_ntoa_r(address.sin_addr, address_str, sizeof(address_str));
+    for (uint8_t i = 0; i < MAX_SESSIONS; i++) {
+        if (sessions_[i] != nullptr) {
+            continue;
+        }
+        sessions_[i] = new (std::nothrow) Session(splitflap_task_, client_socket);
+        if (sessions_[i] == nullptr) {
+            break;
+        }
+        // Nothing has changed as far as the new session knows, so this just gives it the current state
+        sessions_[i]->protocol.handleState(state, state);
+        snprintf(buf, sizeof(buf), "Proto client %s connected (session %u)", address_str, i);
+        logger_.log(buf);
+        return;
+    }
+
+    snprintf(buf, sizeof(buf), "Proto client %s rejected; no free sessions", address_str);
+    logger_.log(buf);
+    ::close(client_socket);
+}
+
+void ProtoServerTask::closeSession(uint8_t i) {
+    delete sessions_[i];
+    sessions_[i] = nullptr;
+
+    char buf[100];
+    snprintf(buf, sizeof(buf), "Proto client disconnected (session %u)", i);
+    logger_.log(buf);
+}
+
+void ProtoServerTask::run() {
+    // The socket listens on any address, so it keeps working across WiFi reconnects
+    network_task_.waitForConnection();
+    while (!listen()) {
+        logger_.log("Failed to start proto server; retrying in 5 seconds");
+        delay(5000);
+    }
+
+    char buf[100];
+    snprintf(buf, sizeof(buf), "Proto server listening on %s:%u", WiFi.localIP().toString().c_str(), port_);
+    logger_.log(buf);
+
+    int8_t state_subscriber = splitflap_task_.subscribeState();
+    assert(state_subscriber >= 0);
+    StateChanges changes = {};
+    SplitflapState last_state = {};
+    SplitflapState new_state = {};
+    uint32_t state_version = 0;
+    while(1) {
+        fd_set read_fds;
+        FD_ZERO(&read_fds);
+        FD_SET(listen_socket_, &read_fds);
+        int max_fd = listen_socket_;
+        for (uint8_t i = 0; i < MAX_SESSIONS; i++) {
+            if (sessions_[i] != nullptr) {
+                FD_SET(sessions_[i]->stream.getSocket(), &read_fds);
+                max_fd = max(max_fd, sessions_[i]->stream.getSocket());
+            }
+        }
+        struct timeval timeout = {
+            .tv_sec = 0,
+            .tv_usec = MAX_IDLE_MICROS,
+        };
+        int ready = select(max_fd + 1, &read_fds, NULL, NULL, &timeout);
+
+        if (ready > 0 && FD_ISSET(listen_socket_, &read_fds)) {
+            acceptSession(last_state);
+        }
+
+        // Sessions don't survive WiFi dropping (the peer can't tell, and the address may change), so close them
+        // rather than hold on to them until TCP gives up, and leave the slots free for clients to reconnect
+        if (!network_task_.isConnected()) {
+            for (uint8_t i = 0; i < MAX_SESSIONS; i++) {
+                if (sessions_[i] != nullptr) {
+                    closeSession(i);
+                }
+            }
+        }
+
+        splitflap_task_.takeStateChanges(state_subscriber, changes);
+        bool state_changed = changes.any() && splitflap_task_.getStateIfChanged(state_version, new_state);
+
+        for (uint8_t i = 0; i < MAX_SESSIONS; i++) {
+            Session* session = sessions_[i];
+            if (session == nullptr) {
+                continue;
+            }
+            if (state_changed) {
+                session->protocol.handleState(last_state, new_state);
+            }
+            session->protocol.loop();
+            if (!session->stream.pump()) {
+                closeSession(i);
+            }
+        }
+
+        if (state_changed) {
+            last_state = new_state;
+            changes = {};
+        }
+    }
+}
+#endif
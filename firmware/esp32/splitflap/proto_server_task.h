@@ -0,0 +1,66 @@
+/*
+   Copyright 2024 Scott Bezek and the splitflap contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#pragma once
+
+#include <Arduino.h>
+
+#include "../core/logger.h"
+#include "../core/network_task.h"
+#include "../core/splitflap_task.h"
+#include "../core/task.h"
+#include "../core/tcp_stream.h"
+
+#include "serial_proto_protocol.h"
+
+/**
+ * Serves the proto serial protocol (the same COBS + CRC32 + nanopb framing as over USB serial) to TCP clients, so
+ * hosts can drive the display over WiFi. Each connection gets its own protocol session, with its own nonce window, TX
+ * backpressure and state subscription settings; every session sees the same splitflap state.
+ */
+class ProtoServerTask : public Task<ProtoServerTask> {
+    friend class Task<ProtoServerTask>; // Allow base Task to invoke protected run()
+
+    public:
+        ProtoServerTask(SplitflapTask& splitflap_task, NetworkTask& network_task, Logger& logger, const uint8_t task_core, const uint16_t port);
+
+    protected:
+        void run();
+
+    private:
+        enum : uint8_t {
+            MAX_SESSIONS = 3,
+        };
+
+        struct Session {
+            Session(SplitflapTask& splitflap_task, int socket) : stream(socket), protocol(splitflap_task, stream) {}
+
+            TcpStream stream;
+            SerialProtoProtocol protocol;
+        };
+
+        SplitflapTask& splitflap_task_;
+        NetworkTask& network_task_;
+        Logger& logger_;
+        const uint16_t port_;
+
+        int listen_socket_ = -1;
+        // Allocated while connected
+        Session* sessions_[MAX_SESSIONS] = {};
+
+        bool listen();
+        void acceptSession(const SplitflapState& state);
+        void closeSession(uint8_t i);
+};
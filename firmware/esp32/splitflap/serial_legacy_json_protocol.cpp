@@ -14,16 +14,14 @@
    limitations under the License.
 */
 
-#include "json11.hpp"
+#include "../core/json_writer.h"
 
 #include "serial_legacy_json_protocol.h"
 #include "../proto_gen/splitflap.pb.h"
 
-using namespace json11;
-
 void SerialLegacyJsonProtocol::handleState(const SplitflapState& old_state, const SplitflapState& new_state) {
     bool all_stopped = true;
-    for (uint8_t i = 0; i < NUM_MODULES; i++) {
+    for (uint8_t i = 0; i < new_state.num_modules; i++) {
         all_stopped &= !new_state.modules[i].moving;
     }
     if (pending_move_response_ && all_stopped) {
@@ -32,21 +30,26 @@ void SerialLegacyJsonProtocol::handleState(const SplitflapState& old_state, cons
     }
 
     latest_state_ = new_state;
+
+    // The init message reports the number of modules, so wait until the splitflap task has detected it
+    if (old_state.num_modules == 0 && new_state.num_modules > 0) {
+        init();
+    }
 }
 
 void SerialLegacyJsonProtocol::log(const char* msg) {
-    Json body = Json::object {
-            {"type", "log"},
-            {"msg", std::string(msg)},
-    };
-    stream_.println(body.dump().c_str());
+    JsonWriter(stream_).beginObject()
+        .field("type", "log")
+        .field("msg", msg)
+        .endObject();
+    stream_.println();
 }
 
 void SerialLegacyJsonProtocol::loop() {
     if (latest_state_.mode == SplitflapMode::MODE_SENSOR_TEST) {
         if (millis() - last_sensor_print_millis_ > 200) {
             last_sensor_print_millis_ = millis();
-            for (uint8_t i = 0; i < NUM_MODULES; i++) {
+            for (uint8_t i = 0; i < latest_state_.num_modules; i++) {
                 stream_.write(latest_state_.modules[i].home_state ? '1' : '0');
             }
             stream_.println();
@@ -64,16 +67,21 @@ void SerialLegacyJsonProtocol::loop() {
         if (b == '%') {
             bool new_sensor_test_state = latest_state_.mode != SplitflapMode::MODE_SENSOR_TEST;
             splitflap_task_.setSensorTest(new_sensor_test_state);
-            stream_.print("{\"type\":\"sensor_test\", \"enabled\":");
-            stream_.print(new_sensor_test_state ? "true" : "false");
-            stream_.print("}\n");
+            JsonWriter(stream_).beginObject()
+                .field("type", "sensor_test")
+                .field("enabled", new_sensor_test_state)
+                .endObject();
+            stream_.print("\n");
         } else if (latest_state_.mode == SplitflapMode::MODE_RUN) {
             switch (b) {
                 case '@':
                     splitflap_task_.resetAll();
                     break;
                 case '#':
-                    stream_.print("{\"type\":\"no_op\"}\n");
+                    JsonWriter(stream_).beginObject()
+                        .field("type", "no_op")
+                        .endObject();
+                    stream_.print("\n");
                     stream_.flush();
                     break;
                 case '=':
@@ -81,21 +89,20 @@ void SerialLegacyJsonProtocol::loop() {
                     break;
                 case '\n':
                     pending_move_response_ = true;
-                    stream_.printf("{\"type\":\"move_echo\", \"dest\":\"");
-                    stream_.flush();
-                    for (uint8_t i = 0; i < recv_count_; i++) {
-                        stream_.write(recv_buffer_[i]);
-                    }
-                    stream_.printf("\"}\n");
+                    JsonWriter(stream_).beginObject()
+                        .field("type", "move_echo")
+                        .key("dest").value(recv_buffer_, recv_count_)
+                        .endObject();
+                    stream_.print("\n");
                     stream_.flush();
                     splitflap_task_.showString(recv_buffer_, recv_count_);
                     break;
                 case '+':
                     if (recv_count_ == 1) {
-                        for (uint8_t i = 1; i < NUM_MODULES; i++) {
+                        for (uint8_t i = 1; i < latest_state_.num_modules; i++) {
                             recv_buffer_[i] = recv_buffer_[0];
                         }
-                        splitflap_task_.showString(recv_buffer_, NUM_MODULES);
+                        splitflap_task_.showString(recv_buffer_, latest_state_.num_modules);
                     }
                     break;
                 case '>':
@@ -132,43 +139,45 @@ void SerialLegacyJsonProtocol::sendSupervisorState(PB_SupervisorState& superviso
 
 void SerialLegacyJsonProtocol::init() {
     stream_.print("\n\n\n");
-    stream_.print("{\"type\":\"init\", \"num_modules\":");
-    stream_.print(NUM_MODULES);
-    stream_.print("}\n");
+    JsonWriter(stream_).beginObject()
+        .field("type", "init")
+        .field("num_modules", latest_state_.num_modules)
+        .endObject();
+    stream_.print("\n");
 }
 
 void SerialLegacyJsonProtocol::dumpStatus(const SplitflapState& state) {
-    stream_.print("{\"type\":\"status\", \"modules\":[");
-    for (uint8_t i = 0; i < NUM_MODULES; i++) {
-        stream_.print("{\"state\":\"");
+    JsonWriter json(stream_);
+    json.beginObject()
+        .field("type", "status")
+        .beginArray("modules");
+    for (uint8_t i = 0; i < state.num_modules; i++) {
+        const char* module_state = "";
         switch (state.modules[i].state) {
             case NORMAL:
-                stream_.print("normal");
+                module_state = "normal";
                 break;
             case LOOK_FOR_HOME:
-                stream_.print("look_for_home");
+                module_state = "look_for_home";
                 break;
             case SENSOR_ERROR:
-                stream_.print("sensor_error");
+                module_state = "sensor_error";
                 break;
             case PANIC:
-                stream_.print("panic");
+                module_state = "panic";
                 break;
             case STATE_DISABLED:
-                stream_.print("disabled");
+                module_state = "disabled";
                 break;
         }
-        stream_.print("\", \"flap\":\"");
-        stream_.write(flaps[state.modules[i].flap_index]);
-        stream_.print("\", \"count_missed_home\":");
-        stream_.print(state.modules[i].count_missed_home);
-        stream_.print(", \"count_unexpected_home\":");
-        stream_.print(state.modules[i].count_unexpected_home);
-        stream_.print("}");
-        if (i < NUM_MODULES - 1) {
-            stream_.print(", ");
-        }
+        json.beginObject()
+            .field("state", module_state)
+            .field("flap", (char)flaps[state.modules[i].flap_index])
+            .field("count_missed_home", state.counters[i].count_missed_home)
+            .field("count_unexpected_home", state.counters[i].count_unexpected_home)
+            .endObject();
     }
-    stream_.print("]}\n");
+    json.endArray().endObject();
+    stream_.print("\n");
     stream_.flush();
 }
@@ -13,32 +13,54 @@
    See the License for the specific language governing permissions and
    limitations under the License.
 */
+#include <atomic>
+
 #include "../proto_gen/splitflap.pb.h"
 
+#include "cobs.h"
 #include "crc32.h"
 
 #include "pb_encode.h"
 #include "pb_decode.h"
 #include "serial_proto_protocol.h"
 
-static SerialProtoProtocol* singleton_for_packet_serial = 0;
-
 static const uint16_t MIN_STATE_INTERVAL_MILLIS = 100;
 static const uint16_t PERIODIC_STATE_INTERVAL_MILLIS = 5000;
 
-SerialProtoProtocol::SerialProtoProtocol(SplitflapTask& splitflap_task, Stream& stream) :
-        SerialProtocol(splitflap_task),
-        stream_(stream) {
-    packet_serial_.setStream(&stream);
+// Number of recent nonces remembered for de-duplicating retries; hosts may have up to this many messages in flight
+static const uint8_t NONCE_WINDOW_SIZE = 32;
+static_assert(NONCE_WINDOW_SIZE <= 32, "Nonce window is tracked in a uint32_t bitmask");
+
+// Free TX buffer space each class must leave for the higher priority ones, in TxClass order: a burst of acks (one per
+// nonce in the window), a GeneralState, and a few state updates
+static const uint16_t TX_RESERVE_BYTES[] = {0, 512, 1024, 8192};
+
+// Flap index in a SplitflapFrame that leaves the module as it is
+static const uint8_t FRAME_UNCHANGED = 0x3F;
+static_assert(NUM_FLAPS < FRAME_UNCHANGED, "SplitflapFrame flap indexes are 6 bits, with one value reserved");
 
-    // Note: not threadsafe or instance safe!! but PacketSerial requires a legacy function pointer, so we can't
-    // use a member, std::function, or lambda with captures
-    assert(singleton_for_packet_serial == 0);
-    singleton_for_packet_serial = this;
+// Highest baud rate hosts may switch to. The ESP32 UART can go faster, but common USB serial adapters top out around here.
+static const uint32_t MAX_BAUD_RATE = 2000000;
+static const uint32_t MIN_BAUD_RATE = 9600;
 
-    packet_serial_.setPacketHandler([](const uint8_t* buffer, size_t size) {
-        singleton_for_packet_serial->handlePacket(buffer, size);
-    });
+// How long after a baud rate change a valid packet must arrive before the previous rate is restored
+static const uint16_t BAUD_RATE_VERIFY_MILLIS = 2000;
+
+// Consecutive corrupt packets that make the link fall back to a slower rate: the previous one while verifying a change,
+// or the default rate afterwards
+static const uint8_t BAUD_RATE_FALLBACK_BAD_PACKETS = 3;
+
+// SplitflapState is encoded after room for the FromSplitflap tag and length, which are only known afterwards
+// Each protocol instance (e.g. the serial port and each TCP session) collects only its own command traces
+static std::atomic<uint32_t> next_trace_source(1);
+
+static const size_t STATE_HEADER_SIZE = PB_FromSplitflap_size - PB_SplitflapState_size;
+
+SerialProtoProtocol::SerialProtoProtocol(SplitflapTask& splitflap_task, Stream& stream) :
+        SerialProtocol(splitflap_task),
+        stream_(stream),
+        cobs_writer_(stream),
+        trace_source_(next_trace_source.fetch_add(1, std::memory_order_relaxed)) {
 }
 
 void SerialProtoProtocol::handleState(const SplitflapState& old_state, const SplitflapState& new_state) {
@@ -46,104 +68,320 @@ void SerialProtoProtocol::handleState(const SplitflapState& old_state, const Spl
 }
 
 void SerialProtoProtocol::ack(uint32_t nonce) {
-    pb_tx_buffer_ = {};
-    pb_tx_buffer_.which_payload = PB_FromSplitflap_ack_tag;
-    pb_tx_buffer_.payload.ack.nonce = nonce;
-    sendPbTxBuffer();
+    if (pending_acks_count_ == ACK_QUEUE_SIZE) {
+        // Drop the oldest; the host will retry that message and get it acked again
+        pending_acks_start_ = (pending_acks_start_ + 1) % ACK_QUEUE_SIZE;
+        pending_acks_count_--;
+        if (pending_acks_held_back_ > 0) {
+            pending_acks_held_back_--;
+        }
+        stats_.tx_classes[TX_CLASS_ACK].discarded++;
+    }
+    pending_acks_[(pending_acks_start_ + pending_acks_count_) % ACK_QUEUE_SIZE] = nonce;
+    pending_acks_count_++;
+
+    sendPendingAcks();
+}
+
+void SerialProtoProtocol::sendPendingAcks() {
+    while (pending_acks_count_ > 0) {
+        PB_Ack ack = {};
+        ack.nonce = pending_acks_[pending_acks_start_];
+        if (!sendPayload(PB_FromSplitflap_ack_tag, PB_Ack_fields, &ack, TX_CLASS_ACK)) {
+            // Count each waiting ack once, however many times it's retried
+            stats_.tx_classes[TX_CLASS_ACK].held_back += pending_acks_count_ - pending_acks_held_back_;
+            pending_acks_held_back_ = pending_acks_count_;
+            return;
+        }
+        pending_acks_start_ = (pending_acks_start_ + 1) % ACK_QUEUE_SIZE;
+        pending_acks_count_--;
+        if (pending_acks_held_back_ > 0) {
+            pending_acks_held_back_--;
+        }
+    }
 }
 
 void SerialProtoProtocol::log(const char* msg) {
-    pb_tx_buffer_ = {};
-    pb_tx_buffer_.which_payload = PB_FromSplitflap_log_tag;
+    // Logs are lowest priority, so while anything else is waiting for space they're dropped (and counted, so the
+    // host at least finds out how many it missed)
+    if (!tx_held_back_ && logs_dropped_ > 0) {
+        char buf[50];
+        snprintf(buf, sizeof(buf), "(%u log messages dropped)", logs_dropped_);
+        if (sendLog(buf)) {
+            logs_dropped_ = 0;
+        }
+    }
 
-    strlcpy(pb_tx_buffer_.payload.log.msg, msg, sizeof(pb_tx_buffer_.payload.log.msg));
+    if (tx_held_back_ || !sendLog(msg)) {
+        stats_.tx_classes[TX_CLASS_LOG].discarded++;
+        logs_dropped_++;
+    }
+}
 
-    sendPbTxBuffer();
+bool SerialProtoProtocol::sendLog(const char* msg) {
+    PB_Log log = {};
+    strlcpy(log.msg, msg, sizeof(log.msg));
+    return sendPayload(PB_FromSplitflap_log_tag, PB_Log_fields, &log, TX_CLASS_LOG);
 }
 
 void SerialProtoProtocol::sendSupervisorState(PB_SupervisorState& supervisor_state) {
-    pb_tx_buffer_ = {};
-    pb_tx_buffer_.which_payload = PB_FromSplitflap_supervisor_state_tag;
-    pb_tx_buffer_.payload.supervisor_state = supervisor_state;
-    sendPbTxBuffer();
+    pending_supervisor_state_ = supervisor_state;
+    supervisor_state_pending_ = true;
+    sendPendingSupervisorState();
+}
+
+void SerialProtoProtocol::sendPendingSupervisorState() {
+    if (!supervisor_state_pending_) {
+        return;
+    }
+    if (sendPayload(PB_FromSplitflap_supervisor_state_tag, PB_SupervisorState_fields, &pending_supervisor_state_, TX_CLASS_STATE)) {
+        supervisor_state_pending_ = false;
+        supervisor_state_held_back_ = false;
+    } else {
+        // A newer supervisor state replacing this one while it waits is still the same held back message
+        countHeldBack(TX_CLASS_STATE, supervisor_state_held_back_);
+    }
 }
 
 void SerialProtoProtocol::loop() {
-    do {
-        packet_serial_.update();
-    } while (stream_.available());
-
-    {
-        // SplitflapState updates
-            
-        // Rate limit state change transmissions
-        bool state_changed = latest_state_ != last_sent_state_ && millis() - last_sent_state_millis_ >= MIN_STATE_INTERVAL_MILLIS;
-
-        // Send state periodically or when forced, regardless of rate limit for state changes
-        bool force_send_state = state_requested_ || millis() - last_sent_state_millis_ > PERIODIC_STATE_INTERVAL_MILLIS;
-        if (state_changed || force_send_state) {
-            pb_tx_buffer_ = {};
-            pb_tx_buffer_.which_payload = PB_FromSplitflap_splitflap_state_tag;
-            pb_tx_buffer_.payload.splitflap_state.modules_count = NUM_MODULES;
-            for (uint8_t i = 0; i < NUM_MODULES; i++) {
-                pb_tx_buffer_.payload.splitflap_state.modules[i] = {
-                    .state = (PB_SplitflapState_ModuleState_State) latest_state_.modules[i].state,
-                    .flap_index = latest_state_.modules[i].flap_index,
-                    .moving = latest_state_.modules[i].moving,
-                    .home_state = latest_state_.modules[i].home_state,
-                    .count_unexpected_home = latest_state_.modules[i].count_unexpected_home,
-                    .count_missed_home = latest_state_.modules[i].count_missed_home,
-                };
+    int b;
+    while ((b = stream_.read()) >= 0) {
+        stats_.rx_bytes++;
+        if (b != 0) {
+            if (rx_size_ < sizeof(rx_buffer_)) {
+                rx_buffer_[rx_size_++] = b;
+            } else {
+                rx_overflow_ = true;
             }
-            #ifdef CHAINLINK
-            pb_tx_buffer_.payload.splitflap_state.loopbacks_ok = latest_state_.loopbacks_ok;
-            #endif
+            continue;
+        }
 
-            sendPbTxBuffer();
+        // End of packet
+        if (rx_overflow_) {
+            log("Packet too large");
+            badPacket();
+        } else if (rx_size_ > 0) {
+            size_t size = cobsDecodeInPlace(rx_buffer_, rx_size_);
+            if (size > 0) {
+                handlePacket(rx_buffer_, size);
+            } else {
+                badPacket();
+            }
+        }
+        rx_size_ = 0;
+        rx_overflow_ = false;
+    }
 
-            last_sent_state_ = latest_state_;
-            last_sent_state_millis_ = millis();
+    // Send in priority order; anything that doesn't fit in the TX buffer yet is retried next time round
+    tx_held_back_ = false;
+    sendPendingAcks();
+    updateBaudRate();
+    sendGeneralState();
+    sendPendingSupervisorState();
+    sendSplitflapState();
+    sendCommandTraces();
+
+    if (memcmp(&stats_, &stats_snapshot_.latest(), sizeof(stats_)) != 0) {
+        stats_snapshot_.publish(stats_);
+    }
+}
+
+const char* SerialProtoProtocol::txClassName(uint8_t tx_class) {
+    switch (tx_class) {
+        case TX_CLASS_ACK:
+            return "ack";
+        case TX_CLASS_CONTROL:
+            return "control";
+        case TX_CLASS_STATE:
+            return "state";
+        case TX_CLASS_LOG:
+            return "log";
+        default:
+            return "unknown";
+    }
+}
+
+void SerialProtoProtocol::sendCommandTraces() {
+    while (true) {
+        if (!trace_unsent_) {
+            if (!splitflap_task_.takeCompletedTrace(trace_source_, unsent_trace_)) {
+                return;
+            }
+            trace_unsent_ = true;
+        }
+        PB_CommandTrace trace = {
+            .nonce = unsent_trace_.id,
+            .received_micros = unsent_trace_.received_micros,
+            .posted_micros = unsent_trace_.posted_micros,
+            .dequeued_micros = unsent_trace_.dequeued_micros,
+            .first_step_micros = unsent_trace_.first_step_micros,
+            .settled_micros = unsent_trace_.settled_micros,
+        };
+        if (!sendPayload(PB_FromSplitflap_command_trace_tag, PB_CommandTrace_fields, &trace, TX_CLASS_STATE)) {
+            countHeldBack(TX_CLASS_STATE, trace_held_back_);
+            return;
         }
+        trace_unsent_ = false;
+        trace_held_back_ = false;
     }
+}
 
-    {
-        // GeneralState updates
+void SerialProtoProtocol::traceCommand(uint32_t nonce, uint32_t received_micros) {
+    if (!command_traces_) {
+        return;
+    }
+    CommandTrace trace = {};
+    trace.id = nonce;
+    trace.source = trace_source_;
+    trace.received_micros = received_micros;
+    trace.posted_micros = CommandTrace::now();
+    splitflap_task_.traceNextCommand(trace);
+}
 
-        // Send state periodically or when forced
-        bool force_send_state = state_requested_ || millis() - last_sent_general_state_millis_ > 2000;
-        if (force_send_state) {
-            PB_GeneralState state = {};
+void SerialProtoProtocol::sendSplitflapState() {
+    // Rate limit state change transmissions
+    bool state_changed = latest_state_ != last_sent_state_ && millis() - last_sent_state_millis_ >= MIN_STATE_INTERVAL_MILLIS;
 
-            state.serial_protocol_version = SERIAL_PROTOCOL_VERSION;
-            state.uptime_millis = millis();
+    // Send state periodically or when forced, regardless of rate limit for state changes
+    bool force_send_state = splitflap_state_requested_ || millis() - last_sent_state_millis_ > PERIODIC_STATE_INTERVAL_MILLIS;
 
-            snprintf(state.build_info.git_hash, sizeof(state.build_info.git_hash), BUILD_GIT_HASH);
-            snprintf(state.build_info.build_date, sizeof(state.build_info.build_date), BUILD_DATE);
-            snprintf(state.build_info.build_os, sizeof(state.build_info.build_os), BUILD_OS);
-            state.has_build_info = true;
+    // Don't report any modules until the splitflap task has determined how many are connected
+    bool state_ready = latest_state_.num_modules > 0;
+    if (!state_ready || !(state_changed || force_send_state)) {
+        return;
+    }
 
-            memcpy(&state.flap_character_set.bytes, flaps, NUM_FLAPS);
-            state.flap_character_set.size = NUM_FLAPS;
+    // If the host asked for deltas, only send the modules that changed since the last message, except for
+    // periodic/requested keyframes (and if the number of modules changed)
+    bool delta = state_deltas_ && !force_send_state && latest_state_.num_modules == last_sent_state_.num_modules;
+
+    // Encode the modules straight from the latest state, rather than filling in a PB_SplitflapState (with room for
+    // every module) first
+    pb_ostream_t stream = pb_ostream_from_buffer(tx_buffer_ + STATE_HEADER_SIZE, PB_SplitflapState_size);
+    bool ok = true;
+    for (uint8_t i = 0; i < latest_state_.num_modules; i++) {
+        if (delta && latest_state_.modules[i] == last_sent_state_.modules[i] && latest_state_.counters[i] == last_sent_state_.counters[i]) {
+            continue;
+        }
+        PB_SplitflapState_ModuleState module = {
+            .state = (PB_SplitflapState_ModuleState_State) latest_state_.modules[i].state,
+            .flap_index = (uint8_t) latest_state_.modules[i].flap_index,
+            .moving = latest_state_.modules[i].moving != 0,
+            .home_state = latest_state_.modules[i].home_state != 0,
+            .count_unexpected_home = latest_state_.counters[i].count_unexpected_home,
+            .count_missed_home = latest_state_.counters[i].count_missed_home,
+            .index = (uint8_t) (delta ? i : 0),
+        };
+        ok = ok
+            && pb_encode_tag(&stream, PB_WT_STRING, PB_SplitflapState_modules_tag)
+            && pb_encode_submessage(&stream, PB_SplitflapState_ModuleState_fields, &module);
+    }
+    #ifdef CHAINLINK
+    ok = ok && encodeVarintField(&stream, PB_SplitflapState_loopbacks_ok_tag, latest_state_.loopbacks_ok);
+    #endif
+    ok = ok
+        && encodeVarintField(&stream, PB_SplitflapState_sequence_tag, state_sequence_ + 1)
+        && encodeVarintField(&stream, PB_SplitflapState_is_delta_tag, delta);
+
+    // Then fill in the FromSplitflap tag and length just before it
+    size_t state_size = stream.bytes_written;
+    pb_ostream_t sizing = PB_OSTREAM_SIZING;
+    pb_encode_tag(&sizing, PB_WT_STRING, PB_FromSplitflap_splitflap_state_tag);
+    pb_encode_varint(&sizing, state_size);
+    uint8_t* packet = tx_buffer_ + STATE_HEADER_SIZE - sizing.bytes_written;
+    pb_ostream_t header = pb_ostream_from_buffer(packet, sizing.bytes_written);
+    ok = ok
+        && pb_encode_tag(&header, PB_WT_STRING, PB_FromSplitflap_splitflap_state_tag)
+        && pb_encode_varint(&header, state_size);
+    if (!ok) {
+        stream_.println(stream.errmsg);
+        stream_.flush();
+        assert(false);
+    }
 
-            pb_tx_buffer_ = {};
-            pb_tx_buffer_.which_payload = PB_FromSplitflap_general_state_tag;
-            pb_tx_buffer_.payload.general_state = state;
-            sendPbTxBuffer();
+    if (!sendTxBuffer(packet, sizing.bytes_written + state_size, TX_CLASS_STATE)) {
+        // Nothing is marked as sent, so the next attempt includes these changes along with any newer ones
+        countHeldBack(TX_CLASS_STATE, splitflap_state_held_back_);
+        return;
+    }
+    splitflap_state_held_back_ = false;
 
-            last_sent_general_state_millis_ = millis();
+    state_sequence_++;
+    last_sent_state_ = latest_state_;
+    last_sent_state_millis_ = millis();
+    splitflap_state_requested_ = false;
+}
+
+void SerialProtoProtocol::sendGeneralState() {
+    // Send state periodically or when requested
+    if (!general_state_requested_ && millis() - last_sent_general_state_millis_ <= 2000) {
+        return;
+    }
+
+    if (general_state_static_size_ == 0) {
+        // Build info and the flap character set never change, so only encode them once
+        PB_GeneralState state = {};
+
+        snprintf(state.build_info.git_hash, sizeof(state.build_info.git_hash), BUILD_GIT_HASH);
+        snprintf(state.build_info.build_date, sizeof(state.build_info.build_date), BUILD_DATE);
+        snprintf(state.build_info.build_os, sizeof(state.build_info.build_os), BUILD_OS);
+        state.has_build_info = true;
+
+        memcpy(&state.flap_character_set.bytes, flaps, NUM_FLAPS);
+        state.flap_character_set.size = NUM_FLAPS;
+
+        pb_ostream_t stream = pb_ostream_from_buffer(general_state_static_, sizeof(general_state_static_));
+        if (!pb_encode(&stream, PB_GeneralState_fields, &state)) {
+            stream_.println(stream.errmsg);
+            stream_.flush();
+            assert(false);
         }
+        general_state_static_size_ = stream.bytes_written;
     }
 
-    if (state_requested_) {
-        // Handled above
-        state_requested_ = false;
+    PB_GeneralState state = {};
+
+    state.serial_protocol_version = SERIAL_PROTOCOL_VERSION;
+    state.uptime_millis = millis();
+    state.num_modules = latest_state_.num_modules;
+    state.ack_window = NONCE_WINDOW_SIZE;
+    state.baud_rate = baud_rate_;
+    state.max_baud_rate = baud_rate_change_callback_ ? MAX_BAUD_RATE : 0;
+
+    state.tx_stats_count = NUM_TX_CLASSES;
+    memcpy(state.tx_stats, stats_.tx_classes, sizeof(stats_.tx_classes));
+
+    // An encoded message is just its encoded fields one after another, so the FromSplitflap message can be put
+    // together from the freshly encoded fields above followed by the cached ones
+    size_t dynamic_size = 0;
+    pb_get_encoded_size(&dynamic_size, PB_GeneralState_fields, &state);
+
+    pb_ostream_t stream = pb_ostream_from_buffer(tx_buffer_, sizeof(tx_buffer_) - 4);
+    if (!pb_encode_tag(&stream, PB_WT_STRING, PB_FromSplitflap_general_state_tag)
+            || !pb_encode_varint(&stream, dynamic_size + general_state_static_size_)
+            || !pb_encode(&stream, PB_GeneralState_fields, &state)
+            || !pb_write(&stream, general_state_static_, general_state_static_size_)) {
+        stream_.println(stream.errmsg);
+        stream_.flush();
+        assert(false);
+    }
+
+    if (sendTxBuffer(tx_buffer_, stream.bytes_written, TX_CLASS_CONTROL)) {
+        last_sent_general_state_millis_ = millis();
+        general_state_requested_ = false;
+        general_state_held_back_ = false;
+    } else {
+        countHeldBack(TX_CLASS_CONTROL, general_state_held_back_);
     }
 }
 
 void SerialProtoProtocol::handlePacket(const uint8_t* buffer, size_t size) {
+    uint32_t received_micros = CommandTrace::now();
+
     if (size <= 4) {
         // Too small, ignore bad packet
         log("Small packet");
+        badPacket();
         return;
     }
 
@@ -160,109 +398,471 @@ void SerialProtoProtocol::handlePacket(const uint8_t* buffer, size_t size) {
         char buf[200];
         snprintf(buf, sizeof(buf), "Bad CRC (%u byte packet). Expected %08x but got %08x.", size - 4, expected_crc, provided_crc);
         log(buf);
+        stats_.crc_errors++;
+        badPacket();
         return;
     }
+    stats_.rx_packets++;
+
+    // A valid packet confirms the link works at the current baud rate
+    bad_packets_ = 0;
+    if (baud_rate_verifying_) {
+        baud_rate_verifying_ = false;
+        char buf[50];
+        snprintf(buf, sizeof(buf), "Baud rate changed to %u", baud_rate_);
+        log(buf);
+    }
 
+    // Only the nonce and the position of the payload are decoded up front; the payload is decoded straight into a
+    // Command (or whatever it's for) once the nonce has been checked
+    uint32_t nonce = 0;
+    uint32_t payload_tag = 0;
+    pb_istream_t payload = {};
     pb_istream_t stream = pb_istream_from_buffer(buffer, size - 4);
-    if (!pb_decode(&stream, PB_ToSplitflap_fields, &pb_rx_buffer_)) {
+    if (!decodeToSplitflap(&stream, nonce, payload_tag, payload)) {
         char buf[200];
         snprintf(buf, sizeof(buf), "Decoding failed: %s", PB_GET_ERROR(&stream));
         log(buf);
         return;
     }
 
-    // Always ACK immediately
-    ack(pb_rx_buffer_.nonce);
-    if (pb_rx_buffer_.nonce == last_nonce_) {
+    // Always ACK immediately (or as soon as there's room to)
+    ack(nonce);
+    NonceStatus nonce_status = checkNonce(nonce);
+    if (nonce_status == NonceStatus::DUPLICATE) {
         // Ignore any extraneous retries
         char buf[200];
-        snprintf(buf, sizeof(buf), "Already handled nonce %u", pb_rx_buffer_.nonce);
+        snprintf(buf, sizeof(buf), "Already handled nonce %u", nonce);
         log(buf);
         return;
     }
-    last_nonce_ = pb_rx_buffer_.nonce;
-    
-    switch (pb_rx_buffer_.which_payload) {
+
+    bool ok = true;
+    switch (payload_tag) {
         case PB_ToSplitflap_splitflap_command_tag: {
-            PB_SplitflapCommand command = pb_rx_buffer_.payload.splitflap_command;
-            if (command.modules_count > 0) {
-                Command c = {};
-                c.command_type = CommandType::MODULES;
-                for (uint8_t i = 0; i < min((int)command.modules_count, NUM_MODULES); i++) {
-                    switch (command.modules[i].action) {
-                        case PB_SplitflapCommand_ModuleCommand_Action_NO_OP:
+            Command c = {};
+            c.command_type = CommandType::MODULES;
+            uint16_t modules_count = 0;
+            bool save_all_offsets = false;
+            ok = decodeSplitflapCommand(&payload, c, modules_count, save_all_offsets);
+            if (!ok) {
+                break;
+            }
+
+            // GO_TO_FLAP targets are treated like a config or frame: a late retry mustn't undo newer targets. The
+            // command's other actions aren't superseded by anything, so they're still applied.
+            bool has_targets = false;
+            for (uint8_t i = 0; i < NUM_MODULES; i++) {
+                has_targets |= c.data.module_command[i] >= QCMD_FLAP;
+            }
+            if (has_targets) {
+                if (nonce_status == NonceStatus::LATE && (int32_t)(nonce - last_display_nonce_) < 0) {
+                    char buf[200];
+                    snprintf(buf, sizeof(buf), "Ignoring flap targets in command %u; superseded by %u", nonce, last_display_nonce_);
+                    log(buf);
+                    for (uint8_t i = 0; i < NUM_MODULES; i++) {
+                        if (c.data.module_command[i] >= QCMD_FLAP) {
                             c.data.module_command[i] = QCMD_NO_OP;
-                            break;
-                        case PB_SplitflapCommand_ModuleCommand_Action_RESET_AND_HOME:
-                            c.data.module_command[i] = QCMD_RESET_AND_HOME;
-                            break;
-                        case PB_SplitflapCommand_ModuleCommand_Action_GO_TO_FLAP:
-                            if (command.modules[i].param <= 255 - QCMD_FLAP) {
-                                c.data.module_command[i] = QCMD_FLAP + command.modules[i].param;
-                            }
-                            break;
-                        case PB_SplitflapCommand_ModuleCommand_Action_INCREASE_OFFSET_TENTH:
-                            c.data.module_command[i] = QCMD_INCR_OFFSET_TENTH;
-                            break;
-                        case PB_SplitflapCommand_ModuleCommand_Action_INCREASE_OFFSET_HALF:
-                            c.data.module_command[i] = QCMD_INCR_OFFSET_HALF;
-                            break;
-                        case PB_SplitflapCommand_ModuleCommand_Action_SET_OFFSET:
-                            c.data.module_command[i] = QCMD_SET_OFFSET;
-                            break;
-                        default:
-                            // Ignore unknown action
-                            break;
+                        }
                     }
+                } else {
+                    last_display_nonce_ = nonce;
                 }
-                splitflap_task_.postRawCommand(c);
-            } else if (command.save_all_offsets) {
+            }
+
+            if (modules_count > 0) {
+                traceCommand(nonce, received_micros);
+                if (splitflap_task_.postRawCommand(c) == SubmitResult::REJECTED) {
+                    log("Some module commands were invalid and ignored");
+                }
+            } else if (save_all_offsets) {
+                traceCommand(nonce, received_micros);
                 splitflap_task_.saveAllOffsets();
             }
             break;
         }
         case PB_ToSplitflap_splitflap_config_tag: {
-            PB_SplitflapConfig config = pb_rx_buffer_.payload.splitflap_config;
+            // A config replaces the whole display state, so a late retry of an older config (or frame) must not undo a
+            // newer one
+            if (nonce_status == NonceStatus::LATE && (int32_t)(nonce - last_display_nonce_) < 0) {
+                char buf[200];
+                snprintf(buf, sizeof(buf), "Ignoring config %u; superseded by %u", nonce, last_display_nonce_);
+                log(buf);
+                break;
+            }
+
             Command c = {};
             c.command_type = CommandType::CONFIG;
-            for (uint8_t i = 0; i < min((int)config.modules_count, NUM_MODULES); i++) {
-                ModuleConfig& module_config = c.data.module_configs.config[i];
-                module_config.target_flap_index = config.modules[i].target_flap_index;
-                module_config.movement_nonce = config.modules[i].movement_nonce;
-                module_config.reset_nonce = config.modules[i].reset_nonce;
+            ok = decodeSplitflapConfig(&payload, c);
+            if (!ok) {
+                break;
             }
+            last_display_nonce_ = nonce;
+            traceCommand(nonce, received_micros);
             splitflap_task_.postRawCommand(c);
             break;
         }
-        case PB_ToSplitflap_request_state_tag:
-            state_requested_ = true;
+        case PB_ToSplitflap_splitflap_frame_tag: {
+            // Frames set targets just like configs, so the same goes for late retries
+            if (nonce_status == NonceStatus::LATE && (int32_t)(nonce - last_display_nonce_) < 0) {
+                char buf[200];
+                snprintf(buf, sizeof(buf), "Ignoring frame %u; superseded by %u", nonce, last_display_nonce_);
+                log(buf);
+                break;
+            }
+
+            PB_SplitflapFrame frame = {};
+            ok = pb_decode(&payload, PB_SplitflapFrame_fields, &frame);
+            if (!ok) {
+                break;
+            }
+            last_display_nonce_ = nonce;
+            traceCommand(nonce, received_micros);
+            showSplitflapFrame(frame);
+            break;
+        }
+        case PB_ToSplitflap_request_state_tag: {
+            PB_RequestState request_state = {};
+            ok = pb_decode(&payload, PB_RequestState_fields, &request_state);
+            if (!ok) {
+                break;
+            }
+            splitflap_state_requested_ = true;
+            general_state_requested_ = true;
+            state_deltas_ = request_state.state_deltas;
+            command_traces_ = request_state.command_traces;
+            break;
+        }
+        case PB_ToSplitflap_clock_sync_tag: {
+            PB_ClockSync clock_sync = {};
+            ok = pb_decode(&payload, PB_ClockSync_fields, &clock_sync);
+            if (!ok) {
+                break;
+            }
+            // Best effort; if this doesn't fit in the TX buffer, the host just gets one less sample
+            clock_sync.received_micros = received_micros;
+            clock_sync.sent_micros = micros();
+            if (!sendPayload(PB_FromSplitflap_clock_sync_tag, PB_ClockSync_fields, &clock_sync, TX_CLASS_CONTROL)) {
+                stats_.tx_classes[TX_CLASS_CONTROL].discarded++;
+            }
+            break;
+        }
+        case PB_ToSplitflap_set_baud_rate_tag: {
+            PB_SetBaudRate set_baud_rate = {};
+            ok = pb_decode(&payload, PB_SetBaudRate_fields, &set_baud_rate);
+            if (!ok) {
+                break;
+            }
+            if (!baud_rate_change_callback_ || set_baud_rate.baud_rate < MIN_BAUD_RATE || set_baud_rate.baud_rate > MAX_BAUD_RATE) {
+                char buf[50];
+                snprintf(buf, sizeof(buf), "Unsupported baud rate %u", set_baud_rate.baud_rate);
+                log(buf);
+                break;
+            }
+            // Switch once the ack has gone out at the current rate
+            pending_baud_rate_ = set_baud_rate.baud_rate;
             break;
+        }
         default: {
             char buf[200];
-            snprintf(buf, sizeof(buf), "Unknown ToSplitflap type: %d", pb_rx_buffer_.which_payload);
+            snprintf(buf, sizeof(buf), "Unknown ToSplitflap type: %u", payload_tag);
             log(buf);
             return;
         }
     }
+
+    if (!ok) {
+        char buf[200];
+        snprintf(buf, sizeof(buf), "Decoding failed: %s", PB_GET_ERROR(&payload));
+        log(buf);
+    }
+}
+
+void SerialProtoProtocol::badPacket() {
+    stats_.bad_packets++;
+    if (bad_packets_ < UINT8_MAX) {
+        bad_packets_++;
+    }
+    if (bad_packets_ < BAUD_RATE_FALLBACK_BAD_PACKETS) {
+        return;
+    }
+
+    // Most likely the host is using a different baud rate
+    if (baud_rate_verifying_) {
+        changeBaudRate(previous_baud_rate_);
+        log("Baud rate change failed (corrupt packets); restored previous rate");
+    } else if (baud_rate_ != MONITOR_SPEED) {
+        changeBaudRate(MONITOR_SPEED);
+        log("Too many corrupt packets; fell back to default baud rate");
+    }
+}
+
+void SerialProtoProtocol::changeBaudRate(uint32_t baud_rate) {
+    baud_rate_change_callback_(baud_rate);
+    baud_rate_ = baud_rate;
+    baud_rate_verifying_ = false;
+    bad_packets_ = 0;
+
+    // Whatever was partially received was at the old rate
+    rx_size_ = 0;
+    rx_overflow_ = false;
+    general_state_requested_ = true;
+}
+
+void SerialProtoProtocol::updateBaudRate() {
+    if (pending_baud_rate_ != 0 && pending_acks_count_ == 0) {
+        uint32_t previous_baud_rate = baud_rate_;
+        changeBaudRate(pending_baud_rate_);
+        pending_baud_rate_ = 0;
+        previous_baud_rate_ = previous_baud_rate;
+        baud_rate_verifying_ = true;
+        baud_rate_changed_millis_ = millis();
+    } else if (baud_rate_verifying_ && millis() - baud_rate_changed_millis_ > BAUD_RATE_VERIFY_MILLIS) {
+        changeBaudRate(previous_baud_rate_);
+        log("Baud rate change not confirmed by host; restored previous rate");
+    }
+}
+
+bool SerialProtoProtocol::decodeToSplitflap(pb_istream_t* stream, uint32_t& nonce, uint32_t& payload_tag, pb_istream_t& payload) {
+    while (stream->bytes_left > 0) {
+        pb_wire_type_t wire_type;
+        uint32_t tag;
+        bool eof;
+        if (!pb_decode_tag(stream, &wire_type, &tag, &eof)) {
+            return false;
+        }
+        if (tag == PB_ToSplitflap_nonce_tag && wire_type == PB_WT_VARINT) {
+            if (!pb_decode_varint32(stream, &nonce)) {
+                return false;
+            }
+        } else if ((tag == PB_ToSplitflap_splitflap_command_tag || tag == PB_ToSplitflap_splitflap_config_tag
+                || tag == PB_ToSplitflap_request_state_tag || tag == PB_ToSplitflap_splitflap_frame_tag
+                || tag == PB_ToSplitflap_set_baud_rate_tag || tag == PB_ToSplitflap_clock_sync_tag)
+                && wire_type == PB_WT_STRING) {
+            // Only locate the payload for now (a copy of the substream is just a view of the same buffer), and skip
+            // over it
+            pb_istream_t substream;
+            if (!pb_make_string_substream(stream, &substream)) {
+                return false;
+            }
+            payload = substream;
+            payload_tag = tag;
+            if (!pb_close_string_substream(stream, &substream)) {
+                return false;
+            }
+        } else if (!pb_skip_field(stream, wire_type)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SerialProtoProtocol::decodeSplitflapCommand(pb_istream_t* stream, Command& command, uint16_t& modules_count, bool& save_all_offsets) {
+    while (stream->bytes_left > 0) {
+        pb_wire_type_t wire_type;
+        uint32_t tag;
+        bool eof;
+        if (!pb_decode_tag(stream, &wire_type, &tag, &eof)) {
+            return false;
+        }
+        if (tag == PB_SplitflapCommand_modules_tag && wire_type == PB_WT_STRING) {
+            PB_SplitflapCommand_ModuleCommand module = {};
+            if (!pb_decode_ex(stream, PB_SplitflapCommand_ModuleCommand_fields, &module, PB_DECODE_DELIMITED)) {
+                return false;
+            }
+            uint16_t i = modules_count++;
+            if (i >= NUM_MODULES) {
+                continue;
+            }
+            switch (module.action) {
+                case PB_SplitflapCommand_ModuleCommand_Action_NO_OP:
+                    command.data.module_command[i] = QCMD_NO_OP;
+                    break;
+                case PB_SplitflapCommand_ModuleCommand_Action_RESET_AND_HOME:
+                    command.data.module_command[i] = QCMD_RESET_AND_HOME;
+                    break;
+                case PB_SplitflapCommand_ModuleCommand_Action_GO_TO_FLAP:
+                    if (module.param <= 255 - QCMD_FLAP) {
+                        command.data.module_command[i] = QCMD_FLAP + module.param;
+                    }
+                    break;
+                case PB_SplitflapCommand_ModuleCommand_Action_INCREASE_OFFSET_TENTH:
+                    command.data.module_command[i] = QCMD_INCR_OFFSET_TENTH;
+                    break;
+                case PB_SplitflapCommand_ModuleCommand_Action_INCREASE_OFFSET_HALF:
+                    command.data.module_command[i] = QCMD_INCR_OFFSET_HALF;
+                    break;
+                case PB_SplitflapCommand_ModuleCommand_Action_SET_OFFSET:
+                    command.data.module_command[i] = QCMD_SET_OFFSET;
+                    break;
+                default:
+                    // Ignore unknown action
+                    break;
+            }
+        } else if (tag == PB_SplitflapCommand_save_all_offsets_tag && wire_type == PB_WT_VARINT) {
+            uint32_t value;
+            if (!pb_decode_varint32(stream, &value)) {
+                return false;
+            }
+            save_all_offsets = value != 0;
+        } else if (!pb_skip_field(stream, wire_type)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SerialProtoProtocol::decodeSplitflapConfig(pb_istream_t* stream, Command& command) {
+    uint16_t i = 0;
+    while (stream->bytes_left > 0) {
+        pb_wire_type_t wire_type;
+        uint32_t tag;
+        bool eof;
+        if (!pb_decode_tag(stream, &wire_type, &tag, &eof)) {
+            return false;
+        }
+        if (tag == PB_SplitflapConfig_modules_tag && wire_type == PB_WT_STRING) {
+            PB_SplitflapConfig_ModuleConfig module = {};
+            if (!pb_decode_ex(stream, PB_SplitflapConfig_ModuleConfig_fields, &module, PB_DECODE_DELIMITED)) {
+                return false;
+            }
+            if (i < NUM_MODULES) {
+                ModuleConfig& module_config = command.data.module_configs.config[i];
+                module_config.target_flap_index = module.target_flap_index;
+                module_config.movement_nonce = module.movement_nonce;
+                module_config.reset_nonce = module.reset_nonce;
+            }
+            i++;
+        } else if (!pb_skip_field(stream, wire_type)) {
+            return false;
+        }
+    }
+    return true;
 }
 
-void SerialProtoProtocol::sendPbTxBuffer() {
-    // Encode protobuf message to byte buffer
-    pb_ostream_t stream = pb_ostream_from_buffer(tx_buffer_, sizeof(tx_buffer_));
-    if (!pb_encode(&stream, PB_FromSplitflap_fields, &pb_tx_buffer_)) {
+void SerialProtoProtocol::showSplitflapFrame(const PB_SplitflapFrame& frame) {
+    uint16_t available = frame.flap_indexes.size * 8 / 6;
+    uint16_t count = frame.module_count > 0 ? frame.module_count : available;
+    if (count > available) {
+        char buf[200];
+        snprintf(buf, sizeof(buf), "Frame has %u flap indexes but module_count is %u", available, count);
+        log(buf);
+        return;
+    }
+
+    SubmitResult result = SubmitResult::QUEUED;
+    for (uint16_t i = 0; i < count; i++) {
+        // Unpack the 6 bits for this module, which may straddle two bytes
+        uint16_t bit = i * 6;
+        uint8_t shift = bit % 8;
+        const uint8_t* bytes = frame.flap_indexes.bytes + bit / 8;
+        uint8_t flap_index = bytes[0] >> shift;
+        if (shift > 2) {
+            flap_index |= bytes[1] << (8 - shift);
+        }
+        flap_index &= 0x3F;
+        if (flap_index == FRAME_UNCHANGED) {
+            continue;
+        }
+
+        uint16_t module = frame.start_module + i;
+        if (module >= NUM_MODULES) {
+            result = SubmitResult::REJECTED;
+            break;
+        }
+        result = mergeSubmitResult(result, splitflap_task_.showFlapIndex(module, flap_index));
+    }
+    if (result == SubmitResult::REJECTED) {
+        log("Some frame flap indexes were invalid and ignored");
+    }
+}
+
+SerialProtoProtocol::NonceStatus SerialProtoProtocol::checkNonce(uint32_t nonce) {
+    if (seen_nonces_ == 0) {
+        // First message
+        highest_nonce_ = nonce;
+        seen_nonces_ = 1;
+        return NonceStatus::NEW;
+    }
+
+    uint32_t ahead = nonce - highest_nonce_;
+    if (ahead != 0 && ahead < 0x80000000) {
+        seen_nonces_ = ahead >= NONCE_WINDOW_SIZE ? 1 : ((seen_nonces_ << ahead) | 1);
+        highest_nonce_ = nonce;
+        return NonceStatus::NEW;
+    }
+
+    uint32_t behind = highest_nonce_ - nonce;
+    if (behind >= NONCE_WINDOW_SIZE) {
+        // Too old to be a retry from within the window, so this must be a new host session
+        highest_nonce_ = nonce;
+        seen_nonces_ = 1;
+        return NonceStatus::NEW;
+    }
+
+    uint32_t bit = 1UL << behind;
+    if (seen_nonces_ & bit) {
+        return NonceStatus::DUPLICATE;
+    }
+    seen_nonces_ |= bit;
+    return NonceStatus::LATE;
+}
+
+bool SerialProtoProtocol::sendPayload(pb_size_t tag, const pb_msgdesc_t* fields, const void* message, TxClass tx_class) {
+    // FromSplitflap is just a oneof, so its encoding is the payload's tag and the payload as a submessage
+    pb_ostream_t stream = pb_ostream_from_buffer(tx_buffer_, sizeof(tx_buffer_) - 4);
+    if (!pb_encode_tag(&stream, PB_WT_STRING, tag) || !pb_encode_submessage(&stream, fields, message)) {
         stream_.println(stream.errmsg);
         stream_.flush();
         assert(false);
     }
 
+    return sendTxBuffer(tx_buffer_, stream.bytes_written, tx_class);
+}
+
+void SerialProtoProtocol::countHeldBack(TxClass tx_class, bool& held_back) {
+    if (!held_back) {
+        stats_.tx_classes[tx_class].held_back++;
+        held_back = true;
+    }
+}
+
+bool SerialProtoProtocol::encodeVarintField(pb_ostream_t* stream, pb_size_t tag, uint32_t value) {
+    // Like proto3, omit default values
+    if (value == 0) {
+        return true;
+    }
+    return pb_encode_tag(stream, PB_WT_VARINT, tag) && pb_encode_varint(stream, value);
+}
+
+bool SerialProtoProtocol::sendTxBuffer(uint8_t* packet, size_t size, TxClass tx_class) {
+    PB_GeneralState_TxClassStats& stats = stats_.tx_classes[tx_class];
+
+    // Worst case COBS overhead, plus the delimiter. If the message doesn't fit (leaving room for higher priority
+    // classes), hold it back rather than blocking in the UART driver until it does.
+    size_t packet_size = size + 4;
+    size_t encoded_size = CobsWriter::maxEncodedSize(packet_size);
+    if (stream_.availableForWrite() < (int)(encoded_size + TX_RESERVE_BYTES[tx_class])) {
+        // Callers count the message as held back or discarded, since only they know whether it's a retry
+        if (tx_class != TX_CLASS_LOG) {
+            tx_held_back_ = true;
+        }
+        return false;
+    }
+
     // Compute and append little-endian CRC32
     uint32_t crc = 0;
-    crc32(tx_buffer_, stream.bytes_written, &crc);
-    tx_buffer_[stream.bytes_written + 0] = (crc >> 0)  & 0xFF;
-    tx_buffer_[stream.bytes_written + 1] = (crc >> 8)  & 0xFF;
-    tx_buffer_[stream.bytes_written + 2] = (crc >> 16) & 0xFF;
-    tx_buffer_[stream.bytes_written + 3] = (crc >> 24) & 0xFF;
+    crc32(packet, size, &crc);
+    packet[size + 0] = (crc >> 0)  & 0xFF;
+    packet[size + 1] = (crc >> 8)  & 0xFF;
+    packet[size + 2] = (crc >> 16) & 0xFF;
+    packet[size + 3] = (crc >> 24) & 0xFF;
 
     // Encode and send proto+CRC as a COBS packet
-    packet_serial_.send(tx_buffer_, stream.bytes_written + 4);
+    cobs_writer_.write(packet, packet_size);
+    cobs_writer_.end();
+
+    stats.bytes += packet_size;
+    stats.messages++;
+    return true;
 }
@@ -15,8 +15,11 @@
 */
 #pragma once
 
-#include "PacketSerial.h"
+#include "pb_decode.h"
+#include "pb_encode.h"
 
+#include "../core/snapshot_buffer.h"
+#include "cobs.h"
 #include "serial_protocol.h"
 #include "../proto_gen/splitflap.pb.h"
 
@@ -28,11 +31,59 @@
  *      - May or may not have software offset support
  * 1:
  *      - GeneralState is introduced (including introduction of serial protocol versioning)
+ * 2:
+ *      - GeneralState.num_modules reports the number of connected modules (detected at runtime for Chainlink);
+ *        SplitflapState only includes connected modules and isn't sent until that number is known
+ * 3:
+ *      - SplitflapState has a sequence number, and is sent as deltas between keyframes if the host sets
+ *        RequestState.state_deltas
+ * 4:
+ *      - Retries are de-duplicated over a window of recent nonces (advertised as GeneralState.ack_window) rather than
+ *        just the last one, so hosts may pipeline that many messages
+ * 5:
+ *      - Outgoing messages are prioritized (acks, then GeneralState, then SplitflapState/SupervisorState, then logs);
+ *        when the serial TX buffer is filling up, state updates are merged and logs are dropped. Per-class TX stats
+ *        are reported in GeneralState.tx_stats
+ * 6:
+ *      - SplitflapFrame is introduced: packed 6-bit flap indexes for all (or a range of) modules
+ * 7:
+ *      - SetBaudRate is introduced; GeneralState reports the current and maximum baud rates
+ * 8:
+ *      - CommandTrace (sent if the host sets RequestState.command_traces) and ClockSync are introduced
+ * 9:
+ *      - GeneralState.tx_stats counts each held back message once (rather than every retry) in held_back, which
+ *        replaces dropped; messages that are never sent are counted separately in discarded
 */
-#define SERIAL_PROTOCOL_VERSION (1);
+#define SERIAL_PROTOCOL_VERSION (9);
+
+// Switches the underlying serial port to the given baud rate, after waiting for everything already written to be sent
+typedef std::function<void(uint32_t)> BaudRateChangeCallback;
 
 class SerialProtoProtocol : public SerialProtocol {
     public:
+        // Outgoing message classes, highest priority first. When the serial TX buffer is filling up, each class must
+        // leave some room for the ones above it, so lower priority messages are held back (state is retried with any
+        // later changes merged in, logs are dropped) rather than delaying higher priority ones.
+        enum TxClass : uint8_t {
+            TX_CLASS_ACK,
+            TX_CLASS_CONTROL,
+            TX_CLASS_STATE,
+            TX_CLASS_LOG,
+            NUM_TX_CLASSES,
+        };
+
+        struct Stats {
+            uint32_t rx_bytes;
+            // Valid packets received, and corrupt ones (of which, those with a bad CRC)
+            uint32_t rx_packets;
+            uint32_t bad_packets;
+            uint32_t crc_errors;
+            // As reported in GeneralState.tx_stats
+            PB_GeneralState_TxClassStats tx_classes[NUM_TX_CLASSES];
+        };
+
+        static const char* txClassName(uint8_t tx_class);
+
         SerialProtoProtocol(SplitflapTask& splitflap_task, Stream& stream);
         ~SerialProtoProtocol() {}
         void log(const char* msg) override;
@@ -41,27 +92,121 @@ class SerialProtoProtocol : public SerialProtocol {
         void sendSupervisorState(PB_SupervisorState& supervisor_state) override;
 
         void init();
+
+        // Safe to call from any task; updated once per loop
+        Stats getStats() {
+            return stats_snapshot_.read();
+        }
+
+        // Enables SetBaudRate; without a callback (e.g. not a UART), hosts are told switching isn't supported
+        void setBaudRateChangeCallback(BaudRateChangeCallback cb) {
+            baud_rate_change_callback_ = cb;
+        }
     
     private:
+        enum : uint8_t {
+            ACK_QUEUE_SIZE = 32,
+        };
+
         Stream& stream_;
-        PB_FromSplitflap pb_tx_buffer_;
-        PB_ToSplitflap pb_rx_buffer_;
+
+        // Received COBS packet (max message size + CRC32, plus COBS overhead), decoded in place once complete
+        uint8_t rx_buffer_[PB_ToSplitflap_size + 4 + (PB_ToSplitflap_size + 4) / 254 + 1];
+        size_t rx_size_ = 0;
+        bool rx_overflow_ = false;
 
         uint8_t tx_buffer_[PB_FromSplitflap_size + 4]; // Max message size + CRC32
+        CobsWriter cobs_writer_;
+
+        enum class NonceStatus {
+            // Not seen before, and the newest so far
+            NEW,
+            // Not seen before, but older than the newest (e.g. a retry of a message that was lost first time round)
+            LATE,
+            // Already handled
+            DUPLICATE,
+        };
 
-        PacketSerial_<COBS, 0, (PB_ToSplitflap_size + 4) * 2 + 10> packet_serial_;
+        // Nonces handled recently: bit i is set if highest_nonce_ - i has been handled
+        uint32_t highest_nonce_ = 0;
+        uint32_t seen_nonces_ = 0;
+        // Nonce of the last config, frame or command with GO_TO_FLAP targets, which supersedes late retries of any
+        // before it
+        uint32_t last_display_nonce_ = 0;
 
-        uint32_t last_nonce_;
+        // Acks waiting for space in the TX buffer
+        uint32_t pending_acks_[ACK_QUEUE_SIZE];
+        uint8_t pending_acks_start_ = 0;
+        uint8_t pending_acks_count_ = 0;
+        // How many of the oldest pending acks have already been counted as held back
+        uint8_t pending_acks_held_back_ = 0;
+
+        Stats stats_ = {};
+        SnapshotBuffer<Stats> stats_snapshot_;
+        // Whether a message above log priority has been held back since the last loop, so logs should be dropped
+        bool tx_held_back_ = false;
+        uint32_t logs_dropped_ = 0;
 
         SplitflapState latest_state_ = {};
         SplitflapState last_sent_state_ = {};
         uint32_t last_sent_state_millis_ = 0;
+        uint32_t state_sequence_ = 0;
+        bool state_deltas_ = false;
 
         uint32_t last_sent_general_state_millis_ = 0;
+        // Encoded GeneralState fields that never change (build info and flap character set)
+        uint8_t general_state_static_[PB_GeneralState_size];
+        size_t general_state_static_size_ = 0;
+
+        // Only the latest supervisor state is kept if it has to wait for space in the TX buffer
+        PB_SupervisorState pending_supervisor_state_;
+        bool supervisor_state_pending_ = false;
+
+        // Whether each retried message has already been counted as held back (cleared once it's sent)
+        bool splitflap_state_held_back_ = false;
+        bool general_state_held_back_ = false;
+        bool supervisor_state_held_back_ = false;
+
+        bool splitflap_state_requested_ = false;
+        bool general_state_requested_ = false;
+
+        bool command_traces_ = false;
+        const uint32_t trace_source_;
+        // Completed trace waiting for space in the TX buffer
+        CommandTrace unsent_trace_ = {};
+        bool trace_unsent_ = false;
+        bool trace_held_back_ = false;
 
-        bool state_requested_;
+        BaudRateChangeCallback baud_rate_change_callback_;
+        uint32_t baud_rate_ = MONITOR_SPEED;
+        // Rate to switch to once the SetBaudRate ack has gone out (0 if none)
+        uint32_t pending_baud_rate_ = 0;
+        // After switching, the previous rate is restored unless a valid packet arrives within BAUD_RATE_VERIFY_MILLIS
+        bool baud_rate_verifying_ = false;
+        uint32_t previous_baud_rate_ = 0;
+        uint32_t baud_rate_changed_millis_ = 0;
+        // Corrupt packets received since the last valid one
+        uint8_t bad_packets_ = 0;
 
-        void sendPbTxBuffer();
+        bool sendPayload(pb_size_t tag, const pb_msgdesc_t* fields, const void* message, TxClass tx_class);
+        bool sendTxBuffer(uint8_t* packet, size_t size, TxClass tx_class);
+        void countHeldBack(TxClass tx_class, bool& held_back);
+        static bool encodeVarintField(pb_ostream_t* stream, pb_size_t tag, uint32_t value);
+        void sendPendingAcks();
+        void sendPendingSupervisorState();
+        void sendSplitflapState();
+        void sendGeneralState();
+        void sendCommandTraces();
+        void traceCommand(uint32_t nonce, uint32_t received_micros);
+        bool sendLog(const char* msg);
         void handlePacket(const uint8_t* buffer, size_t size);
+        void badPacket();
+        void changeBaudRate(uint32_t baud_rate);
+        void updateBaudRate();
+        bool decodeToSplitflap(pb_istream_t* stream, uint32_t& nonce, uint32_t& payload_tag, pb_istream_t& payload);
+        bool decodeSplitflapCommand(pb_istream_t* stream, Command& command, uint16_t& modules_count, bool& save_all_offsets);
+        bool decodeSplitflapConfig(pb_istream_t* stream, Command& command);
+        void showSplitflapFrame(const PB_SplitflapFrame& frame);
         void ack(uint32_t nonce);
+        NonceStatus checkNonce(uint32_t nonce);
 };
@@ -17,6 +17,10 @@
 
 #include "../core/uart_stream.h"
 
+// Upper bound on how long the task sleeps with nothing to do, so that rate-limited/periodic state updates and
+// messages held back by TX backpressure still go out on time
+static const TickType_t MAX_IDLE_TICKS = pdMS_TO_TICKS(10);
+
 SerialTask::SerialTask(SplitflapTask& splitflap_task, const uint8_t task_core) :
         Task("Serial", 16000, 1, task_core),
         Logger(),
@@ -24,9 +28,6 @@ SerialTask::SerialTask(SplitflapTask& splitflap_task, const uint8_t task_core) :
         stream_(),
         legacy_protocol_(splitflap_task_, stream_),
         proto_protocol_(splitflap_task_, stream_) {
-    log_queue_ = xQueueCreate(10, sizeof(std::string *));
-    assert(log_queue_ != NULL);
-
     supervisor_state_queue_ = xQueueCreate(1, sizeof(PB_SupervisorState));
     assert(supervisor_state_queue_ != NULL);
 }
@@ -34,8 +35,7 @@ SerialTask::SerialTask(SplitflapTask& splitflap_task, const uint8_t task_core) :
 void SerialTask::run() {
     stream_.begin();
 
-    // Start in legacy protocol mode
-    legacy_protocol_.init();
+    // Start in legacy protocol mode (it sends its init message once the splitflap task reports its state)
     SerialProtocol* current_protocol = &legacy_protocol_;
 
     ProtocolChangeCallback protocol_change_callback = [this, &current_protocol] (uint8_t protocol) {
@@ -54,43 +54,83 @@ void SerialTask::run() {
 
     legacy_protocol_.setProtocolChangeCallback(protocol_change_callback);
     proto_protocol_.setProtocolChangeCallback(protocol_change_callback);
+    proto_protocol_.setBaudRateChangeCallback([this] (uint32_t baud_rate) {
+        stream_.setBaudRate(baud_rate);
+    });
 
     splitflap_task_.setLogger(this);
 
+    int8_t state_subscriber = splitflap_task_.subscribeState();
+    assert(state_subscriber >= 0);
+    StateChanges changes = {};
     SplitflapState last_state = {};
+    SplitflapState new_state = {};
+    uint32_t state_version = 0;
     while(1) {
-        SplitflapState new_state = splitflap_task_.getState();
-
-        if (new_state != last_state) {
+        splitflap_task_.takeStateChanges(state_subscriber, changes);
+        if (changes.any() && splitflap_task_.getStateIfChanged(state_version, new_state)) {
             current_protocol->handleState(last_state, new_state);
             last_state = new_state;
+            changes = {};
         }
 
         current_protocol->loop();
 
-        std::string* log_string;
-        while (xQueueReceive(log_queue_, &log_string, 0) == pdTRUE) {
-            current_protocol->log(log_string->c_str());
-            delete log_string;
+        LogRecord record;
+        char log_buffer[LogRecord::MAX_TEXT_LENGTH + 1];
+        while (log_ring_.pop(record)) {
+            record.formatTo(log_buffer, sizeof(log_buffer));
+            current_protocol->log(log_buffer);
+        }
+        uint32_t log_dropped = log_ring_.dropped();
+        if (log_dropped != log_dropped_reported_) {
+            snprintf(log_buffer, sizeof(log_buffer), "(%u log messages dropped; log buffer full)", log_dropped - log_dropped_reported_);
+            current_protocol->log(log_buffer);
+            log_dropped_reported_ = log_dropped;
+        }
+
+        uint32_t rx_overflows = stream_.getRxOverflows();
+        if (rx_overflows != rx_overflows_reported_) {
+            snprintf(log_buffer, sizeof(log_buffer), "Serial RX overflow (%u total); input was discarded", rx_overflows);
+            current_protocol->log(log_buffer);
+            rx_overflows_reported_ = rx_overflows;
         }
 
         PB_SupervisorState supervisor_state;
         if (xQueueReceive(supervisor_state_queue_, &supervisor_state, 0) == pdTRUE) {
             current_protocol->sendSupervisorState(supervisor_state);
         }
-        delay(1);
+
+        // Sleep until a state change or serial receive event (both are delivered as task notifications), or until
+        // it's time to check on periodic messages
+        splitflap_task_.waitForStateChange(MAX_IDLE_TICKS);
     }
 }
 
 void SerialTask::log(const char* msg) {
-    // Allocate a string for the duration it's in the queue; it is free'd by the queue consumer
-    std::string* msg_str = new std::string(msg);
+    // The message may not outlive this call, so copy it (truncated if necessary) into the record
+    LogRecord record;
+    record.format = nullptr;
+    strlcpy(record.text, msg, sizeof(record.text));
+    logRecord(record);
+}
 
-    // Put string in queue (or drop if full to avoid blocking)
-    xQueueSendToBack(log_queue_, &msg_str, 0);
+void SerialTask::logRecord(const LogRecord& record) {
+    // Drops (and counts) the record if the ring is full, rather than blocking
+    log_ring_.push(record);
 }
 
 void SerialTask::sendSupervisorState(PB_SupervisorState& supervisor_state) {
     // Only queue the latest supervisor state
     xQueueOverwrite(supervisor_state_queue_, &supervisor_state);
+#ifdef CHAINLINK_BASE
+    supervisor_state_snapshot_.publish(supervisor_state);
+#endif
+}
+
+#ifdef CHAINLINK_BASE
+void SerialTask::getSupervisorState(PB_SupervisorState& out) {
+    uint32_t version = supervisor_state_snapshot_.version() - 1;
+    supervisor_state_snapshot_.readIfChanged(version, out);
 }
+#endif
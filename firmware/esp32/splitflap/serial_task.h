@@ -17,6 +17,7 @@
 
 #include "config.h"
 
+#include "../core/log_ring.h"
 #include "../core/splitflap_task.h"
 #include "../core/task.h"
 #include "../core/uart_stream.h"
@@ -32,9 +33,20 @@ class SerialTask : public Task<SerialTask>, public Logger {
         virtual ~SerialTask() {};
         
         void log(const char* msg) override;
+        void logRecord(const LogRecord& record) override;
 
         void sendSupervisorState(PB_SupervisorState& supervisor_state);
 
+        // Safe to call from any task
+        SerialProtoProtocol::Stats getProtoStats() {
+            return proto_protocol_.getStats();
+        }
+
+#ifdef CHAINLINK_BASE
+        // Latest supervisor state passed to sendSupervisorState (all zero until there is one). Safe to call from any task.
+        void getSupervisorState(PB_SupervisorState& out);
+#endif
+
     protected:
         void run();
 
@@ -45,8 +57,15 @@ class SerialTask : public Task<SerialTask>, public Logger {
         SerialLegacyJsonProtocol legacy_protocol_;
         SerialProtoProtocol proto_protocol_;
 
-        QueueHandle_t log_queue_;
+        // Log messages from any task, formatted and sent on the serial task
+        LogRing log_ring_;
+        uint32_t log_dropped_reported_ = 0;
+        uint32_t rx_overflows_reported_ = 0;
+
         QueueHandle_t supervisor_state_queue_;
+#ifdef CHAINLINK_BASE
+        SnapshotBuffer<PB_SupervisorState> supervisor_state_snapshot_;
+#endif
 
         void dumpStatus(SplitflapState& state);
 };
@@ -0,0 +1,205 @@
+/*
+   Copyright 2024 Scott Bezek and the splitflap contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "text_admission.h"
+
+#include "../core/semaphore_guard.h"
+
+#include "config.h"
+
+// Flap each module will head for if the text is shown (characters that aren't on the flaps leave a module as it is)
+static void textToTargets(const char* text, uint8_t length, const uint8_t* current, uint8_t* targets) {
+    for (uint8_t i = 0; i < NUM_MODULES; i++) {
+        targets[i] = current[i];
+        if (i >= length) {
+            continue;
+        }
+        for (uint8_t flap = 0; flap < NUM_FLAPS; flap++) {
+            if ((uint8_t)text[i] == flaps[flap]) {
+                targets[i] = flap;
+                break;
+            }
+        }
+    }
+}
+
+TextAdmission::TextAdmission(SplitflapTask& splitflap_task, uint8_t burst, uint32_t interval_millis, uint32_t min_dwell_millis) :
+        splitflap_task_(splitflap_task),
+        interval_millis_(interval_millis),
+        max_credit_millis_(burst * interval_millis),
+        min_dwell_millis_(min_dwell_millis),
+        semaphore_(xSemaphoreCreateMutex()) {
+    assert(semaphore_ != NULL);
+    xSemaphoreGive(semaphore_);
+}
+
+AdmissionResult TextAdmission::submit(uint32_t client, const char* text, size_t length, bool force_movement, uint32_t& retry_after_millis) {
+    SemaphoreGuard lock(semaphore_);
+    uint32_t now = millis();
+
+    if (!takeCredit(client, now, retry_after_millis)) {
+        stats_.rate_limited++;
+        // No point coming back before the display could show it anyway
+        retry_after_millis = max(retry_after_millis, predictFreeMillis(now));
+        return AdmissionResult::RATE_LIMITED;
+    }
+    stats_.accepted++;
+
+    uint8_t clamped_length = min(length, (size_t)NUM_MODULES);
+    if (!pending_ && !busy(now)) {
+        show(text, clamped_length, force_movement, now);
+        return AdmissionResult::SHOWN;
+    }
+
+    // Latest wins: whatever was waiting is never shown
+    if (pending_) {
+        stats_.coalesced++;
+    }
+    memcpy(pending_text_, text, clamped_length);
+    pending_length_ = clamped_length;
+    pending_force_ = force_movement;
+    pending_ = true;
+    return AdmissionResult::QUEUED;
+}
+
+bool TextAdmission::update(const SplitflapState& state) {
+    SemaphoreGuard lock(semaphore_);
+    uint32_t now = millis();
+
+    bool moving = false;
+    num_modules_ = state.num_modules;
+    for (uint8_t i = 0; i < state.num_modules; i++) {
+        flap_index_[i] = state.modules[i].flap_index;
+        moving |= state.modules[i].moving;
+    }
+
+    if (moving) {
+        moving_ = true;
+        awaiting_motion_ = false;
+    } else if (moving_) {
+        moving_ = false;
+        settled_millis_ = now;
+    } else if (awaiting_motion_ && now - shown_millis_ >= MOTION_START_MILLIS) {
+        // Nothing had to move, so the message has been up since it was shown
+        awaiting_motion_ = false;
+    }
+
+    if (pending_ && !busy(now)) {
+        pending_ = false;
+        show(pending_text_, pending_length_, pending_force_, now);
+    }
+    return pending_;
+}
+
+TextAdmissionStats TextAdmission::getStats() {
+    SemaphoreGuard lock(semaphore_);
+    TextAdmissionStats stats = stats_;
+    stats.pending = pending_;
+    return stats;
+}
+
+bool TextAdmission::takeCredit(uint32_t client, uint32_t now, uint32_t& retry_after_millis) {
+    // Find the client's bucket, or else the one that's been refilling longest (a full bucket is as good as none)
+    ClientBucket* bucket = nullptr;
+    ClientBucket* replace = nullptr;
+    uint32_t replace_credit = 0;
+    for (uint8_t i = 0; i < MAX_CLIENTS; i++) {
+        ClientBucket& candidate = clients_[i];
+        uint32_t credit = min(candidate.credit_millis + (now - candidate.updated_millis), max_credit_millis_);
+        if (candidate.address == client && candidate.updated_millis != 0) {
+            bucket = &candidate;
+            break;
+        }
+        if (candidate.updated_millis == 0) {
+            credit = max_credit_millis_;
+        }
+        if (replace == nullptr || credit > replace_credit) {
+            replace = &candidate;
+            replace_credit = credit;
+        }
+    }
+    if (bucket == nullptr) {
+        bucket = replace;
+        bucket->address = client;
+        bucket->credit_millis = max_credit_millis_;
+    } else {
+        bucket->credit_millis = min(bucket->credit_millis + (now - bucket->updated_millis), max_credit_millis_);
+    }
+    // 0 marks an unused bucket
+    bucket->updated_millis = now == 0 ? 1 : now;
+
+    if (bucket->credit_millis < interval_millis_) {
+        retry_after_millis = interval_millis_ - bucket->credit_millis;
+        return false;
+    }
+    bucket->credit_millis -= interval_millis_;
+    return true;
+}
+
+bool TextAdmission::busy(uint32_t now) {
+    if (stats_.shown == 0) {
+        return false;
+    }
+    return moving_
+        || (awaiting_motion_ && now - shown_millis_ < MOTION_START_MILLIS)
+        || now - settled_millis_ < min_dwell_millis_;
+}
+
+uint32_t TextAdmission::predictFreeMillis(uint32_t now) {
+    if (!busy(now)) {
+        return 0;
+    }
+
+    uint32_t free_millis = 0;
+    if (moving_ || awaiting_motion_) {
+        // Still on its way; the dwell time starts once it settles
+        free_millis = estimateMotionMillis(flap_index_, target_, num_modules_, false) + min_dwell_millis_;
+    } else if (now - settled_millis_ < min_dwell_millis_) {
+        free_millis = min_dwell_millis_ - (now - settled_millis_);
+    }
+
+    // The waiting message goes up next, and gets its own dwell time
+    if (pending_) {
+        uint8_t pending_targets[NUM_MODULES];
+        textToTargets(pending_text_, pending_length_, target_, pending_targets);
+        free_millis += estimateMotionMillis(target_, pending_targets, num_modules_, pending_force_) + min_dwell_millis_;
+    }
+    return free_millis;
+}
+
+uint32_t TextAdmission::estimateMotionMillis(const uint8_t* from, const uint8_t* to, uint8_t num_modules, bool force_movement) {
+    // Modules only move forwards, and all at once, so the furthest one decides
+    uint8_t max_flaps = 0;
+    for (uint8_t i = 0; i < num_modules; i++) {
+        uint8_t flaps_to_move = (to[i] + NUM_FLAPS - from[i]) % NUM_FLAPS;
+        if (flaps_to_move == 0 && force_movement) {
+            flaps_to_move = NUM_FLAPS;
+        }
+        max_flaps = max(max_flaps, flaps_to_move);
+    }
+    if (max_flaps == 0) {
+        return 0;
+    }
+    return ESTIMATED_START_STOP_MILLIS + max_flaps * ESTIMATED_MILLIS_PER_FLAP;
+}
+
+void TextAdmission::show(const char* text, uint8_t length, bool force_movement, uint32_t now) {
+    splitflap_task_.showString(text, length, force_movement);
+    textToTargets(text, length, target_, target_);
+    stats_.shown++;
+    shown_millis_ = now;
+    settled_millis_ = now;
+    awaiting_motion_ = true;
+}
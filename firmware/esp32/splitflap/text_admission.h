@@ -0,0 +1,126 @@
+/*
+   Copyright 2024 Scott Bezek and the splitflap contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#pragma once
+
+#include <Arduino.h>
+
+#include "../core/splitflap_task.h"
+
+enum class AdmissionResult {
+    // Handed to the splitflap task straight away
+    SHOWN,
+    // The display is still busy with an earlier message; shown once it's free, unless replaced by a later one first
+    QUEUED,
+    // The client has used up its allowance
+    RATE_LIMITED,
+};
+
+struct TextAdmissionStats {
+    // Messages admitted (shown or queued)
+    uint32_t accepted;
+    // Messages handed to the splitflap task
+    uint32_t shown;
+    // Queued messages replaced by a later one before they were shown
+    uint32_t coalesced;
+    // Messages rejected because the client had used up its allowance
+    uint32_t rate_limited;
+    bool pending;
+};
+
+/**
+ * Admission policy for text submitted by web clients, so a busy public install neither stalls nor thrashes the
+ * display between messages mid-motion.
+ *
+ * Each client (by address) gets a token bucket: a burst of up to `burst` messages, refilled at one per
+ * `interval_millis`. A message submitted while the display is still moving (or within `min_dwell_millis` of it
+ * settling) waits, and only the latest waiting message is kept. Rejected clients are told how long to wait, taking
+ * into account when the display is expected to be free.
+ *
+ * submit() may be called from any task; update() must be called with each new state from a single task.
+ */
+class TextAdmission {
+    public:
+        TextAdmission(SplitflapTask& splitflap_task, uint8_t burst, uint32_t interval_millis, uint32_t min_dwell_millis);
+        TextAdmission(TextAdmission const&)=delete;
+        TextAdmission& operator=(TextAdmission const&)=delete;
+
+        // If the result is RATE_LIMITED, retry_after_millis is set to how long the client should wait
+        AdmissionResult submit(uint32_t client, const char* text, size_t length, bool force_movement, uint32_t& retry_after_millis);
+
+        // Tracks motion, and shows the waiting message once the display is free. Returns true while a message is
+        // waiting, in which case this should be called again within POLL_INTERVAL_MILLIS even without a state change.
+        bool update(const SplitflapState& state);
+
+        TextAdmissionStats getStats();
+
+        enum : uint32_t {
+            POLL_INTERVAL_MILLIS = 100,
+        };
+
+    private:
+        enum : uint8_t {
+            MAX_CLIENTS = 16,
+        };
+
+        enum : uint32_t {
+            // A shown message counts as in motion for this long, until the state shows modules moving, or none had
+            // to move
+            MOTION_START_MILLIS = 500,
+
+            // Rough motion time estimates (one flap at cruising speed, plus acceleration and deceleration)
+            ESTIMATED_MILLIS_PER_FLAP = 65,
+            ESTIMATED_START_STOP_MILLIS = 400,
+        };
+
+        struct ClientBucket {
+            uint32_t address;
+            // Time's worth of credit, refilled in real time up to burst * interval; each message costs one interval
+            uint32_t credit_millis;
+            uint32_t updated_millis;
+        };
+
+        SplitflapTask& splitflap_task_;
+        const uint32_t interval_millis_;
+        const uint32_t max_credit_millis_;
+        const uint32_t min_dwell_millis_;
+        SemaphoreHandle_t semaphore_;
+
+        ClientBucket clients_[MAX_CLIENTS] = {};
+
+        char pending_text_[NUM_MODULES];
+        uint8_t pending_length_ = 0;
+        bool pending_force_ = false;
+        bool pending_ = false;
+
+        // Flaps the display is showing (as of the last update) and heading for
+        uint8_t num_modules_ = 0;
+        uint8_t flap_index_[NUM_MODULES] = {};
+        uint8_t target_[NUM_MODULES] = {};
+
+        bool moving_ = false;
+        bool awaiting_motion_ = false;
+        uint32_t shown_millis_ = 0;
+        // When the current message settled (or was shown, while it's still moving)
+        uint32_t settled_millis_ = 0;
+
+        TextAdmissionStats stats_ = {};
+
+        bool takeCredit(uint32_t client, uint32_t now, uint32_t& retry_after_millis);
+        bool busy(uint32_t now);
+        uint32_t predictFreeMillis(uint32_t now);
+        static uint32_t estimateMotionMillis(const uint8_t* from, const uint8_t* to, uint8_t num_modules, bool force_movement);
+        void show(const char* text, uint8_t length, bool force_movement, uint32_t now);
+};
@@ -0,0 +1,256 @@
+/*
+   Copyright 2024 Scott Bezek and the splitflap contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "text_history.h"
+
+#include <time.h>
+
+#include "../core/configuration.h"
+#include "../core/network_task.h"
+#include "../core/semaphore_guard.h"
+#include "crc32.h"
+
+static const char* HISTORY_PATH = "/history.bin";
+static const char* HISTORY_TEMP_PATH = "/history.tmp";
+
+static const uint32_t HISTORY_MAGIC = 0x31484653; // "SFH1"
+static const uint16_t HISTORY_VERSION = 1;
+
+TextHistory::TextHistory(Logger& logger) : logger_(logger), semaphore_(xSemaphoreCreateMutex()) {
+    assert(semaphore_ != NULL);
+    xSemaphoreGive(semaphore_);
+}
+
+void TextHistory::load() {
+    SemaphoreGuard lock(semaphore_);
+    FatGuard fat(nullptr);
+    if (!fat.mounted_) {
+        log("Failed to mount FFat; history won't be saved");
+        return;
+    }
+
+    // A rewrite was interrupted after removing the old file
+    if (!FFat.exists(HISTORY_PATH) && FFat.exists(HISTORY_TEMP_PATH)) {
+        FFat.rename(HISTORY_TEMP_PATH, HISTORY_PATH);
+    }
+
+    File f = FFat.open(HISTORY_PATH);
+    if (!f) {
+        return;
+    }
+
+    FileHeader header = {};
+    if (f.read((uint8_t*)&header, sizeof(header)) != sizeof(header) || header.magic != HISTORY_MAGIC
+            || header.version != HISTORY_VERSION || header.record_size != sizeof(Record)) {
+        f.close();
+        log("Ignoring saved history (unknown format)");
+        return;
+    }
+
+    Record record;
+    bool corrupt = false;
+    while (f.available() > 0) {
+        uint32_t crc = 0;
+        bool complete = f.read((uint8_t*)&record, sizeof(record)) == sizeof(record);
+        if (complete) {
+            crc32(&record.entry, sizeof(record.entry), &crc);
+        }
+        if (!complete || crc != record.crc || record.entry.sequence <= latest_sequence_ || record.entry.length > NUM_MODULES) {
+            // Most likely a torn write at the end; keep what came before it
+            corrupt = true;
+            break;
+        }
+        if (record.entry.sequence != latest_sequence_ + 1) {
+            // Entries were lost before they were saved; only the ones after the gap are contiguous
+            count_ = 0;
+        }
+        memcpy(&entries_[record.entry.sequence % CAPACITY], &record.entry, sizeof(record.entry));
+        latest_sequence_ = record.entry.sequence;
+        if (count_ < CAPACITY) {
+            count_++;
+        }
+        file_records_++;
+    }
+    f.close();
+
+    saved_sequence_ = latest_sequence_;
+    // Appending after a bad record would leave the new ones unreadable
+    rewrite_needed_ = corrupt;
+
+    char buf[100];
+    snprintf(buf, sizeof(buf), "Loaded %u history entries%s", count_, corrupt ? " (ignored a corrupt record)" : "");
+    log(buf);
+}
+
+void TextHistory::add(const char* text, size_t length) {
+    time_t now = time(nullptr);
+
+    SemaphoreGuard lock(semaphore_);
+    uint32_t sequence = ++latest_sequence_;
+    HistoryEntry& entry = entries_[sequence % CAPACITY];
+    // Cleared completely (padding included), since whole entries are checksummed when saved
+    memset(&entry, 0, sizeof(entry));
+    entry.sequence = sequence;
+    entry.unix_time = NetworkTask::isValidTime(now) ? now : 0;
+    entry.length = min(length, (size_t)NUM_MODULES);
+    memcpy(entry.text, text, entry.length);
+    if (count_ < CAPACITY) {
+        count_++;
+    }
+    if (sequence == saved_sequence_ + 1) {
+        first_unsaved_millis_ = millis();
+    }
+}
+
+bool TextHistory::get(uint32_t sequence, HistoryEntry& out) {
+    SemaphoreGuard lock(semaphore_);
+    if (sequence == 0 || sequence > latest_sequence_ || sequence + count_ <= latest_sequence_) {
+        return false;
+    }
+    memcpy(&out, &entries_[sequence % CAPACITY], sizeof(out));
+    return true;
+}
+
+uint32_t TextHistory::latestSequence() {
+    SemaphoreGuard lock(semaphore_);
+    return latest_sequence_;
+}
+
+uint32_t TextHistory::oldestSequence() {
+    SemaphoreGuard lock(semaphore_);
+    return count_ == 0 ? 0 : latest_sequence_ - count_ + 1;
+}
+
+bool TextHistory::flushIfDue() {
+    uint32_t latest;
+    uint32_t oldest;
+    uint32_t first_unsaved_millis;
+    {
+        SemaphoreGuard lock(semaphore_);
+        latest = latest_sequence_;
+        oldest = latest_sequence_ - count_ + 1;
+        first_unsaved_millis = first_unsaved_millis_;
+    }
+    uint32_t unsaved = latest - saved_sequence_;
+    if (unsaved == 0) {
+        return false;
+    }
+    if (unsaved < FLUSH_BATCH_SIZE && millis() - first_unsaved_millis < FLUSH_INTERVAL_MILLIS) {
+        return true;
+    }
+
+    // Entries are written outside the lock, one at a time, so adding entries never waits for the file system. Any that
+    // are added meanwhile are saved next time. If some were pushed out of the ring before they could be saved, the
+    // file is rewritten so there's no gap in it.
+    bool lost_unsaved = oldest > saved_sequence_ + 1;
+    bool ok;
+    if (rewrite_needed_ || lost_unsaved || file_records_ + unsaved > 2 * CAPACITY) {
+        ok = rewrite(latest);
+    } else {
+        ok = append(saved_sequence_ + 1, latest);
+    }
+
+    SemaphoreGuard lock(semaphore_);
+    if (ok) {
+        saved_sequence_ = latest;
+    }
+    if (latest_sequence_ != saved_sequence_) {
+        // Leftovers (or a failed write) wait for another interval
+        first_unsaved_millis_ = millis();
+        return true;
+    }
+    return false;
+}
+
+bool TextHistory::append(uint32_t from_sequence, uint32_t to_sequence) {
+    FatGuard fat(nullptr);
+    if (!fat.mounted_) {
+        log("Failed to mount FFat to save history");
+        return false;
+    }
+    File f = FFat.open(HISTORY_PATH, FILE_APPEND);
+    if (!f) {
+        log("Failed to open history file");
+        return false;
+    }
+    uint32_t records = 0;
+    bool ok = writeRecords(f, from_sequence, to_sequence, records);
+    f.close();
+    file_records_ += records;
+    if (!ok) {
+        log("Failed to save history");
+        rewrite_needed_ = true;
+    }
+    return ok;
+}
+
+bool TextHistory::rewrite(uint32_t to_sequence) {
+    FatGuard fat(nullptr);
+    if (!fat.mounted_) {
+        log("Failed to mount FFat to save history");
+        return false;
+    }
+    File f = FFat.open(HISTORY_TEMP_PATH, FILE_WRITE);
+    if (!f) {
+        log("Failed to open history file");
+        return false;
+    }
+    FileHeader header = {};
+    header.magic = HISTORY_MAGIC;
+    header.version = HISTORY_VERSION;
+    header.record_size = sizeof(Record);
+    uint32_t records = 0;
+    bool ok = f.write((const uint8_t*)&header, sizeof(header)) == sizeof(header)
+        && writeRecords(f, oldestSequence(), to_sequence, records);
+    f.close();
+    if (!ok) {
+        log("Failed to save history");
+        FFat.remove(HISTORY_TEMP_PATH);
+        return false;
+    }
+
+    // FAT can't rename over an existing file
+    FFat.remove(HISTORY_PATH);
+    if (!FFat.rename(HISTORY_TEMP_PATH, HISTORY_PATH)) {
+        log("Failed to replace history file");
+        return false;
+    }
+    file_records_ = records;
+    rewrite_needed_ = false;
+    return true;
+}
+
+bool TextHistory::writeRecords(File& file, uint32_t from_sequence, uint32_t to_sequence, uint32_t& records) {
+    Record record;
+    for (uint32_t sequence = from_sequence; sequence <= to_sequence; sequence++) {
+        // Entries pushed out of the ring since (always the oldest ones) are skipped
+        if (!get(sequence, record.entry)) {
+            continue;
+        }
+        record.crc = 0;
+        crc32(&record.entry, sizeof(record.entry), &record.crc);
+        if (file.write((const uint8_t*)&record, sizeof(record)) != sizeof(record)) {
+            return false;
+        }
+        records++;
+    }
+    return true;
+}
+
+void TextHistory::log(const char* msg) {
+    char buf[200];
+    snprintf(buf, sizeof(buf), "History: %s", msg);
+    logger_.log(buf);
+}
@@ -0,0 +1,109 @@
+/*
+   Copyright 2024 Scott Bezek and the splitflap contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#pragma once
+
+#include <Arduino.h>
+#include <FFat.h>
+
+#include "../core/logger.h"
+
+#include "config.h"
+
+struct HistoryEntry {
+    // Starts at 1 and goes up by one per entry, carrying on from the saved history after a restart
+    uint32_t sequence;
+    // Unix time the entry was added, or 0 if the clock hadn't been set
+    uint32_t unix_time;
+    uint8_t length;
+    // Not null-terminated; only as much as fits on the display is kept
+    char text[NUM_MODULES];
+};
+
+/**
+ * The most recent WEB_HISTORY_SIZE messages, kept in a fixed ring (no allocation or shifting per message) and saved
+ * to FFat so they survive a restart.
+ *
+ * New entries are appended to the file in batches, at most every FLUSH_INTERVAL_MILLIS unless FLUSH_BATCH_SIZE of
+ * them pile up first, to limit flash writes. Once the file holds twice as many records as the ring, it's rewritten
+ * with just the ring's contents.
+ *
+ * add() and get() may be called from any task; load() and flushIfDue() must be called from a single task.
+ */
+class TextHistory {
+    public:
+        enum : uint16_t {
+            CAPACITY = WEB_HISTORY_SIZE,
+        };
+
+        enum : uint32_t {
+            FLUSH_INTERVAL_MILLIS = 30000,
+            FLUSH_BATCH_SIZE = 16,
+            // How often flushIfDue() should be called while there are unsaved entries
+            FLUSH_CHECK_MILLIS = 1000,
+        };
+
+        TextHistory(Logger& logger);
+        TextHistory(TextHistory const&)=delete;
+        TextHistory& operator=(TextHistory const&)=delete;
+
+        void load();
+        void add(const char* text, size_t length);
+
+        // Returns false if the entry isn't (or is no longer) in the ring
+        bool get(uint32_t sequence, HistoryEntry& out);
+        // Sequence numbers of the newest and oldest entries in the ring (0 if it's empty)
+        uint32_t latestSequence();
+        uint32_t oldestSequence();
+
+        // Saves any unsaved entries if they're due; returns whether some are still waiting
+        bool flushIfDue();
+
+    private:
+        struct FileHeader {
+            uint32_t magic;
+            uint16_t version;
+            uint16_t record_size;
+        };
+
+        static_assert(CAPACITY > 0, "WEB_HISTORY_SIZE must be at least 1");
+
+        Logger& logger_;
+        SemaphoreHandle_t semaphore_;
+
+        // Entry n is at index n % CAPACITY
+
+        HistoryEntry entries_[CAPACITY] = {};
+        uint32_t latest_sequence_ = 0;
+        uint16_t count_ = 0;
+
+        // Newest entry already in the file, and when the oldest one that isn't was added
+        uint32_t saved_sequence_ = 0;
+        uint32_t first_unsaved_millis_ = 0;
+        // Records in the file (including any that have since left the ring)
+        uint32_t file_records_ = 0;
+        bool rewrite_needed_ = true;
+
+        struct Record {
+            HistoryEntry entry;
+            // Of the entry's bytes
+            uint32_t crc;
+        };
+
+        bool append(uint32_t from_sequence, uint32_t to_sequence);
+        bool rewrite(uint32_t to_sequence);
+        bool writeRecords(File& file, uint32_t from_sequence, uint32_t to_sequence, uint32_t& records);
+        void log(const char* msg);
+};
@@ -0,0 +1,31 @@
+/*
+   Copyright 2024 Scott Bezek and the splitflap contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#pragma once
+
+#include <Arduino.h>
+
+// A gzipped web UI file, generated at build time from software/chainlink/frontend/esp32 (see
+// firmware/buildscript_web_assets.py)
+struct WebAsset {
+    const char* path;
+    const char* content_type;
+    // Strong ETag (including quotes), from a hash of the uncompressed content
+    const char* etag;
+    // Only ever referenced with its hash in the URL, so it can be cached indefinitely
+    bool immutable;
+    const uint8_t* data;
+    size_t size;
+};
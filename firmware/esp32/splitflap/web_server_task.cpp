@@ -15,1614 +15,746 @@
 */
 
 #include "web_server_task.h"
+#include "web_assets_data.h"
 #include "secrets.h"
 #include "config.h"
 
-// Embedded HTML content
-const char WebServerTask::HTML_CONTENT[] = R"rawliteral(
-<!DOCTYPE html>
-<html lang="en">
-<head>
-    <meta charset="UTF-8">
-    <meta name="viewport" content="width=device-width, initial-scale=1.0">
-    <title>Splitflap Display Controller</title>
-    <style>
-/* Reset and base styles */
-* {
-    margin: 0;
-    padding: 0;
-    box-sizing: border-box;
-}
-
-body {
-    font-family: 'Segoe UI', Tahoma, Geneva, Verdana, sans-serif;
-    background: #6aaa64;
-    min-height: 100vh;
-    color: #333;
-    position: relative;
-}
-
-.container {
-    max-width: 800px;
-    margin: 0 auto;
-    padding: 20px;
-}
-
-/* Header */
-header {
-    text-align: center;
-    margin-bottom: 40px;
-}
-
-h1 {
-    color: white;
-    font-size: 2.5rem;
-    font-weight: 700;
-    margin-bottom: 10px;
-    text-shadow: 0 2px 4px rgba(0,0,0,0.3);
-    letter-spacing: 2px;
-}
-
-.status {
-    display: flex;
-    align-items: center;
-    justify-content: center;
-    gap: 10px;
-    color: white;
-    font-size: 1.1rem;
-}
-
-.status-indicator {
-    width: 12px;
-    height: 12px;
-    border-radius: 50%;
-    background: #ff6b6b;
-    animation: pulse 2s infinite;
-}
-
-.status-indicator.connected {
-    background: #51cf66;
-}
-
-@keyframes pulse {
-    0% { opacity: 1; }
-    50% { opacity: 0.5; }
-    100% { opacity: 1; }
-}
-
-/* History Sidebar */
-.history-sidebar {
-    position: fixed;
-    top: 0;
-    right: 0;
-    width: 300px;
-    height: 100vh;
-    background: #faf8f5;
-    box-shadow: -2px 0 10px rgba(0,0,0,0.1);
-    transition: right 0.3s ease;
-    z-index: 1000;
-    overflow-y: auto;
-}
-
-.history-sidebar.closed {
-    right: -300px;
-}
-
-.history-header {
-    padding: 20px;
-    background: #8B4513;
-    color: white;
-    display: flex;
-    justify-content: space-between;
-    align-items: center;
-}
-
-.header-buttons {
-    display: flex;
-    gap: 10px;
-    align-items: center;
-}
-
-.history-title {
-    font-size: 1.2rem;
-    font-weight: 600;
-}
-
-.history-close {
-    background: none;
-    border: none;
-    color: white;
-    font-size: 1.5rem;
-    cursor: pointer;
-    padding: 0;
-    width: 30px;
-    height: 30px;
-    display: flex;
-    align-items: center;
-    justify-content: center;
-    border-radius: 50%;
-    transition: background 0.2s ease;
-}
-
-.history-close:hover {
-    background: rgba(255,255,255,0.2);
-}
-
-.logout-btn {
-    background: none;
-    border: none;
-    color: white;
-    font-size: 1.2rem;
-    cursor: pointer;
-    padding: 5px;
-    width: 30px;
-    height: 30px;
-    display: flex;
-    align-items: center;
-    justify-content: center;
-    border-radius: 50%;
-    transition: background 0.2s ease;
-}
-
-.logout-btn:hover {
-    background: rgba(255,255,255,0.2);
-}
-
-.history-list {
-    padding: 0 20px 20px 20px;
-}
-
-.current-state-section, .admin-login-section, .admin-section, .history-section {
-    padding: 20px;
-    border-bottom: 1px solid #e0e0e0;
-}
-
-.history-section:last-child {
-    border-bottom: none;
-}
-
-.admin-login {
-    display: flex;
-    flex-direction: column;
-    gap: 10px;
-    align-items: center;
-}
-
-.admin-login-btn {
-    padding: 10px 20px;
-    border: 2px solid #8B4513;
-    border-radius: 6px;
-    background: #8B4513;
-    color: white;
-    font-weight: 600;
-    cursor: pointer;
-    transition: all 0.2s ease;
-    font-size: 0.9rem;
-    width: 100%;
-}
-
-.admin-login-btn:hover {
-    background: #6B3410;
-    border-color: #6B3410;
-}
-
-.admin-status {
-    font-size: 0.8rem;
-    color: #666;
-    text-align: center;
-    font-style: italic;
-}
-
-.admin-logout-btn {
-    background: #dc3545;
-    border-color: #dc3545;
-    color: white;
-}
-
-.admin-logout-btn:hover {
-    background: #c82333;
-    border-color: #c82333;
-}
-
-/* Disabled state overlay */
-.disabled-overlay {
-    position: fixed;
-    top: 0;
-    left: 0;
-    width: 100%;
-    height: 100%;
-    background: rgba(0, 0, 0, 0.7);
-    z-index: 1000;
-    display: none;
-    justify-content: center;
-    align-items: center;
-    flex-direction: column;
-    color: white;
-    font-size: 1.2rem;
-    text-align: center;
-}
-
-.disabled-overlay.show {
-    display: flex;
-}
-
-.disabled-icon {
-    font-size: 4rem;
-    margin-bottom: 20px;
-    opacity: 0.8;
-}
-
-.disabled-message {
-    background: rgba(0, 0, 0, 0.8);
-    padding: 20px 30px;
-    border-radius: 10px;
-    border: 2px solid #ff6b6b;
-    max-width: 400px;
-}
-
-.disabled-title {
-    font-size: 1.5rem;
-    font-weight: bold;
-    margin-bottom: 10px;
-    color: #ff6b6b;
-}
-
-.disabled-subtitle {
-    font-size: 1rem;
-    opacity: 0.9;
-    line-height: 1.4;
-}
-
-.admin-controls {
-    display: flex;
-    flex-direction: column;
-    gap: 10px;
-}
-
-.admin-btn {
-    padding: 10px 15px;
-    border: 2px solid #8B4513;
-    border-radius: 6px;
-    background: white;
-    color: #8B4513;
-    font-weight: 600;
-    cursor: pointer;
-    transition: all 0.2s ease;
-    font-size: 0.9rem;
-}
-
-.admin-btn:hover {
-    background: #8B4513;
-    color: white;
-}
-
-.admin-btn:disabled {
-    opacity: 0.5;
-    cursor: not-allowed;
-}
-
-/* Admin-only sections */
-.admin-only {
-    display: none;
-}
-
-.admin-only.show {
-    display: block;
-}
-
-.section-title {
-    font-size: 1rem;
-    font-weight: 600;
-    color: #8B4513;
-    margin-bottom: 15px;
-    text-transform: uppercase;
-    letter-spacing: 0.5px;
-}
-
-.current-display-item {
-    display: flex;
-    flex-direction: column;
-    align-items: center;
-    padding: 15px 0;
-    text-align: center;
-}
-
-.state-label {
-    font-weight: 500;
-    color: #666;
-    margin-bottom: 8px;
-    font-size: 0.9rem;
-}
-
-.current-word {
-    font-weight: 700;
-    color: #8B4513;
-    font-family: monospace;
-    font-size: 1.4rem;
-    letter-spacing: 2px;
-    background: #f8f9fa;
-    padding: 10px 15px;
-    border-radius: 8px;
-    border: 2px solid #8B4513;
-    min-width: 120px;
-}
-
-.history-item {
-    padding: 12px;
-    margin-bottom: 8px;
-    background: #f8f9fa;
-    border-radius: 8px;
-    border-left: 4px solid #8B4513;
-    font-family: monospace;
-    font-size: 1.1rem;
-    word-break: break-all;
-}
-
-.history-item:last-child {
-    margin-bottom: 0;
-}
-
-.history-toggle {
-    position: fixed;
-    top: 20px;
-    right: 20px;
-    background: white;
-    border: none;
-    border-radius: 50%;
-    width: 50px;
-    height: 50px;
-    box-shadow: 0 2px 10px rgba(0,0,0,0.1);
-    cursor: pointer;
-    display: flex;
-    align-items: center;
-    justify-content: center;
-    font-size: 1.2rem;
-    color: #8B4513;
-    transition: all 0.2s ease;
-    z-index: 1001;
-}
-
-.history-toggle:hover {
-    transform: scale(1.1);
-    box-shadow: 0 4px 15px rgba(0,0,0,0.2);
-}
-
-.history-toggle::before {
-    content: "→";
-}
-
-.history-sidebar.closed + .history-toggle::before {
-    content: "📋";
-}
-
-/* Main content */
-main {
-    background: white;
-    border-radius: 12px;
-    padding: 40px;
-    box-shadow: 0 4px 6px rgba(0,0,0,0.1);
-    border: 1px solid #d3d6da;
-}
-
-/* Display Grid - Wordle style */
-.display-grid {
-    display: flex;
-    justify-content: center;
-    gap: 8px;
-    margin-bottom: 40px;
-}
-
-.display-box {
-    width: 60px;
-    height: 60px;
-    border: 3px solid #d3d6da;
-    border-radius: 0;
-    display: flex;
-    align-items: center;
-    justify-content: center;
-    font-size: 2rem;
-    font-weight: bold;
-    background: white;
-    transition: all 0.2s ease;
-    cursor: pointer;
-    position: relative;
-    text-transform: uppercase;
-}
-
-.display-box:hover {
-    border-color: #878a8c;
-    transform: scale(1.05);
-}
-
-.display-box.focused {
-    border-color: #878a8c;
-    box-shadow: 0 0 0 2px rgba(135, 138, 140, 0.3);
-}
-
-.display-box.filled {
-    border-color: #878a8c;
-    background: white;
-}
-
-/* Controls */
-.controls {
-    display: flex;
-    justify-content: center;
-    gap: 15px;
-    margin-bottom: 40px;
-    flex-wrap: wrap;
-}
-
-.btn {
-    padding: 12px 24px;
-    border: none;
-    border-radius: 8px;
-    font-size: 1rem;
-    font-weight: 600;
-    cursor: pointer;
-    transition: all 0.2s ease;
-    text-transform: uppercase;
-    letter-spacing: 0.5px;
-}
-
-.btn:disabled {
-    opacity: 0.5;
-    cursor: not-allowed;
-}
-
-.btn-primary {
-    background: #6aaa64;
-    color: white;
-}
-
-.btn-primary:hover:not(:disabled) {
-    background: #5a9a54;
-    transform: translateY(-2px);
-    box-shadow: 0 4px 12px rgba(106, 170, 100, 0.3);
-}
-
-.btn-secondary {
-    background: #d3d6da;
-    color: #333;
-}
-
-.btn-secondary:hover {
-    background: #c4c7ca;
-    transform: translateY(-2px);
-}
-
-.btn-warning {
-    background: #f7b731;
-    color: white;
-}
-
-.btn-warning:hover {
-    background: #e6a429;
-    transform: translateY(-2px);
-}
-
-/* Alphabet Keyboard */
-.alphabet-keyboard {
-    display: flex;
-    flex-wrap: wrap;
-    justify-content: center;
-    gap: 6px;
-    margin-bottom: 40px;
-    padding: 20px;
-    background: transparent;
-}
-
-.key {
-    width: 40px;
-    height: 40px;
-    border: 2px solid #d3d6da;
-    border-radius: 4px;
-    background: #d3d6da;
-    display: flex;
-    align-items: center;
-    justify-content: center;
-    font-size: 1.1rem;
-    font-weight: bold;
-    cursor: pointer;
-    transition: all 0.2s ease;
-    user-select: none;
-    color: #333;
-    text-transform: uppercase;
-}
-
-.key:hover {
-    background: #878a8c;
-    border-color: #878a8c;
-    transform: scale(1.05);
-}
-
-.key:active {
-    transform: scale(0.95);
-}
-
-.key.space {
-    width: 80px;
-    font-size: 0.8rem;
-    color: #666;
-}
-
-.key.used {
-    background: #6aaa64;
-    color: white;
-    border-color: #6aaa64;
-}
-
-/* Toast Notifications */
-.toast {
-    position: fixed;
-    top: 20px;
-    right: 20px;
-    background: #333;
-    color: white;
-    padding: 15px 20px;
-    border-radius: 8px;
-    box-shadow: 0 4px 12px rgba(0,0,0,0.3);
-    transform: translateX(400px);
-    transition: transform 0.3s ease;
-    z-index: 1000;
+static const char* moduleStateName(uint8_t state) {
+    switch (state) {
+        case NORMAL:
+            return "normal";
+        case LOOK_FOR_HOME:
+            return "look_for_home";
+        case SENSOR_ERROR:
+            return "sensor_error";
+        case PANIC:
+            return "panic";
+        case STATE_DISABLED:
+            return "disabled";
+        default:
+            return "unknown";
+    }
 }
 
-.toast.show {
-    transform: translateX(0);
+static uint32_t queryParam(AsyncWebServerRequest* request, const char* name, uint32_t default_value) {
+    if (!request->hasParam(name)) {
+        return default_value;
+    }
+    return strtoul(request->getParam(name)->value().c_str(), nullptr, 10);
 }
 
-.toast.success {
-    background: #6aaa64;
+static bool anyModuleMoving(const SplitflapState& state) {
+    for (uint8_t i = 0; i < state.num_modules; i++) {
+        if (state.modules[i].moving) {
+            return true;
+        }
+    }
+    return false;
 }
 
-.toast.error {
-    background: #ff6b6b;
+WebServerTask::WebServerTask(SplitflapTask& splitflap_task, SerialTask& serial_task, NetworkTask& network_task, const uint8_t task_core, const uint16_t port)
+    : Task("WebServer", 8192, 1, task_core), splitflap_task_(splitflap_task), serial_task_(serial_task), network_task_(network_task), logger_(serial_task), server_(port),
+        text_admission_(splitflap_task, WEB_TEXT_BURST, WEB_TEXT_INTERVAL_MILLIS, WEB_TEXT_MIN_DWELL_MILLIS), events_("/events"),
+        history_(serial_task) {
 }
 
-/* Responsive Design */
-@media (max-width: 768px) {
-    .container {
-        padding: 10px;
-    }
-    
-    main {
-        padding: 20px;
-    }
-    
-    h1 {
-        font-size: 2rem;
-    }
-    
-    .display-box {
-        width: 50px;
-        height: 50px;
-        font-size: 1.5rem;
-    }
-    
-    .key {
-        width: 35px;
-        height: 35px;
-        font-size: 1rem;
-    }
-    
-    .key.space {
-        width: 70px;
-    }
+void WebServerTask::run() {
+    char buf[200];
     
-    .controls {
-        flex-direction: column;
-        align-items: center;
-    }
+    logger_.log("Starting web server task...");
     
-    .btn {
-        width: 200px;
-    }
-}
-    </style>
-</head>
-<body>
-    <div class="container">
-        <header>
-            <h1>flipper</h1>
-            <div class="status" id="status">
-                <span class="status-indicator" id="statusIndicator"></span>
-                <span id="statusText">Connecting...</span>
-            </div>
-        </header>
-
-        <main>
-            <!-- Display Grid -->
-            <div class="display-grid" id="displayGrid">
-                <!-- Boxes will be generated by JavaScript -->
-            </div>
-
-            <!-- Controls -->
-            <div class="controls">
-                <button id="sendButton" class="btn btn-primary" disabled>
-                    Send to Display
-                </button>
-                <button id="clearButton" class="btn btn-secondary">
-                    Clear
-                </button>
-                <button id="forceMovementButton" class="btn btn-warning">
-                    Force Movement
-                </button>
-            </div>
-
-            <!-- Alphabet Keyboard -->
-            <div class="alphabet-keyboard" id="alphabetKeyboard">
-                <!-- Alphabet keys will be generated by JavaScript -->
-            </div>
-        </main>
-
-        <!-- Toast Notifications -->
-        <div id="toast" class="toast"></div>
-    </div>
+    history_.load();
+    setupWebServer();
 
-    <!-- History Sidebar -->
-    <button class="history-toggle" id="historyToggle" title="Toggle History"></button>
+    // The server listens on any address, so it keeps working across WiFi reconnects
+    network_task_.waitForConnection();
+    server_.begin();
+    server_started_ = true;
     
-    <div class="history-sidebar" id="historySidebar">
-        <div class="history-header">
-            <div class="history-title">Display Info</div>
-            <button class="history-close" id="historyClose">×</button>
-        </div>
-        
-        <!-- Current State Section -->
-        <div class="current-state-section admin-only" id="currentStateSection">
-            <div class="section-title">Current Display</div>
-            <div class="current-display-item">
-                <span class="state-label">Now Showing:</span>
-                <span class="state-value current-word" id="currentWord">---</span>
-            </div>
-        </div>
-        
-        <!-- Admin Login Section -->
-        <div class="admin-login-section" id="adminLoginSection">
-            <div class="section-title">Admin Access</div>
-            <div class="admin-login">
-                <button class="admin-login-btn" id="adminLoginBtn">Login as Admin</button>
-                <div class="admin-status" id="adminStatus">Guest Mode</div>
-            </div>
-        </div>
-        
-        <!-- Admin Controls Section -->
-        <div class="admin-section" id="adminSection" style="display: none;">
-            <div class="section-title">Admin Controls</div>
-            <div class="admin-controls">
-                <button class="admin-btn" id="enableBtn">Enable Display</button>
-                <button class="admin-btn" id="disableBtn">Disable Display</button>
-                <button class="admin-btn admin-logout-btn" id="adminLogoutBtn">Logout Admin</button>
-            </div>
-        </div>
-        
-        <!-- History Section -->
-        <div class="history-section admin-only" id="historySection">
-            <div class="section-title">Last 10 Words</div>
-            <div class="history-list" id="historyList">
-                <div class="history-item">Loading...</div>
-            </div>
-        </div>
-    </div>
-
-    <script>
-// Configuration
-const API_BASE_URL = window.location.origin;
-const UPDATE_INTERVAL = 5000; // 5 seconds
-
-// State
-let currentStatus = null;
-let currentText = [];
-let currentFocusIndex = 0;
-let numModules = 6; // Default, will be updated from server
-let history = []; // Array to store last 10 words sent
-let currentDisplayedWord = '---'; // Currently displayed word on splitflap
-let isAdminMode = false; // Whether user is in admin mode
-let displayEnabled = true; // Whether display is enabled
-
-// DOM Elements
-const statusIndicator = document.getElementById('statusIndicator');
-const statusText = document.getElementById('statusText');
-const displayGrid = document.getElementById('displayGrid');
-const alphabetKeyboard = document.getElementById('alphabetKeyboard');
-const sendButton = document.getElementById('sendButton');
-const clearButton = document.getElementById('clearButton');
-const forceMovementButton = document.getElementById('forceMovementButton');
-const toast = document.getElementById('toast');
-const historyToggle = document.getElementById('historyToggle');
-const historySidebar = document.getElementById('historySidebar');
-const historyClose = document.getElementById('historyClose');
-const historyList = document.getElementById('historyList');
-const currentWordEl = document.getElementById('currentWord');
-const adminLoginSection = document.getElementById('adminLoginSection');
-const adminLoginBtn = document.getElementById('adminLoginBtn');
-const adminStatus = document.getElementById('adminStatus');
-const adminSection = document.getElementById('adminSection');
-const enableBtn = document.getElementById('enableBtn');
-const disableBtn = document.getElementById('disableBtn');
-const adminLogoutBtn = document.getElementById('adminLogoutBtn');
-const disabledOverlay = document.getElementById('disabledOverlay');
-
-// API Functions
-async function fetchStatus() {
-    try {
-        const response = await fetch(`${API_BASE_URL}/status`);
-        if (!response.ok) {
-            throw new Error(`HTTP error! status: ${response.status}`);
-        }
-        return await response.json();
-    } catch (error) {
-        console.error('Error fetching status:', error);
-        throw error;
-    }
-}
-
-async function fetchHistory() {
-    try {
-        const response = await fetch(`${API_BASE_URL}/history`);
-        if (!response.ok) {
-            throw new Error(`HTTP error! status: ${response.status}`);
+    snprintf(buf, sizeof(buf), "Web server started on http://%s", WiFi.localIP().toString().c_str());
+    logger_.log(buf);
+    
+    // Requests are handled as they arrive on the AsyncTCP task; this task pushes state changes to event clients, and
+    // shows queued /text messages once the display is free
+    int8_t state_subscriber = splitflap_task_.subscribeState();
+    if (state_subscriber < 0) {
+        logger_.log("Web server can't subscribe to state changes; live events disabled");
+        vTaskDelete(NULL);
+    }
+    StateChanges changes = {};
+    SplitflapState state = {};
+    uint32_t state_version = 0;
+    bool text_pending = false;
+    bool history_unsaved = false;
+    while (1) {
+        // Woken by state changes, event client connections, queued messages and new history entries
+        TickType_t timeout = portMAX_DELAY;
+        if (events_resync_) {
+            timeout = pdMS_TO_TICKS(MIN_EVENT_INTERVAL_MILLIS);
+        } else if (text_pending) {
+            timeout = pdMS_TO_TICKS(TextAdmission::POLL_INTERVAL_MILLIS);
+        } else if (history_unsaved) {
+            timeout = pdMS_TO_TICKS(TextHistory::FLUSH_CHECK_MILLIS);
         }
-        return await response.json();
-    } catch (error) {
-        console.error('Error fetching history:', error);
-        throw error;
-    }
-}
+        splitflap_task_.waitForStateChange(timeout);
 
-async function fetchAdminStatus() {
-    try {
-        const response = await fetch(`${API_BASE_URL}/admin/status`);
-        if (!response.ok) {
-            if (response.status === 401) {
-                // User is not authenticated as admin - guest mode
-                return { admin_mode: false, guest_mode: true };
-            }
-            throw new Error(`HTTP error! status: ${response.status}`);
+        // Changes keep accumulating meanwhile, so a display full of moving modules doesn't flood clients
+        uint32_t since_push = millis() - last_push_millis_;
+        if (since_push < MIN_EVENT_INTERVAL_MILLIS) {
+            delay(MIN_EVENT_INTERVAL_MILLIS - since_push);
         }
-        return await response.json();
-    } catch (error) {
-        console.error('Error fetching admin status:', error);
-        return { admin_mode: false, guest_mode: true };
-    }
-}
 
-async function sendAdminAction(action) {
-    try {
-        const response = await fetch(`${API_BASE_URL}/admin/control`, {
-            method: 'POST',
-            headers: {
-                'Content-Type': 'application/json',
-            },
-            body: JSON.stringify({ action: action })
-        });
-        
-        if (!response.ok) {
-            throw new Error(`HTTP error! status: ${response.status}`);
+        // A client that fell behind gets a fresh snapshot once the backlog has gone out, rather than piling more
+        // events onto a full queue
+        bool snapshot = events_snapshot_requested_.exchange(false)
+            || (events_resync_ && events_.avgPacketsWaiting() == 0);
+        splitflap_task_.takeStateChanges(state_subscriber, changes);
+        bool state_changed = changes.any() && splitflap_task_.getStateIfChanged(state_version, state);
+        if (state_changed || snapshot) {
+            pushStateEvents(state, changes, snapshot);
+            last_push_millis_ = millis();
         }
-        
-        return await response.json();
-    } catch (error) {
-        console.error('Error sending admin action:', error);
-        throw error;
-    }
-}
-
-async function sendText(text, forceMovement = false) {
-    try {
-        const response = await fetch(`${API_BASE_URL}/text`, {
-            method: 'POST',
-            headers: {
-                'Content-Type': 'application/json',
-            },
-            body: JSON.stringify({
-                message: text,
-                force_movement: forceMovement
-            })
-        });
-        
-        if (!response.ok) {
-            if (response.status === 403) {
-                // Display is disabled
-                const errorData = await response.json();
-                throw new Error(errorData.message || 'Display is disabled by admin');
-            }
-            throw new Error(`HTTP error! status: ${response.status}`);
+        if (state_changed) {
+            changes = {};
         }
-        
-        return await response.json();
-    } catch (error) {
-        console.error('Error sending text:', error);
-        throw error;
+        text_pending = text_admission_.update(state);
+        history_unsaved = history_.flushIfDue();
     }
 }
 
-// History Management Functions
-async function loadHistory() {
-    try {
-        const response = await fetchHistory();
-        history = response.history || [];
-        updateHistoryDisplay();
-    } catch (error) {
-        console.error('Failed to load history:', error);
-        historyList.innerHTML = '<div class="history-item">Failed to load history</div>';
-    }
+void WebServerTask::writeModuleJSON(JsonWriter& json, const SplitflapState& state, uint8_t i) {
+    json.beginObject()
+        .field("index", i)
+        .field("state", moduleStateName(state.modules[i].state))
+        .field("flap_index", state.modules[i].flap_index)
+        .field("flap", (char)flaps[state.modules[i].flap_index])
+        .field("moving", (bool)state.modules[i].moving)
+        .field("home_state", (bool)state.modules[i].home_state)
+        .field("count_missed_home", state.counters[i].count_missed_home)
+        .field("count_unexpected_home", state.counters[i].count_unexpected_home)
+        .endObject();
 }
 
-function updateHistoryDisplay() {
-    if (history.length === 0) {
-        historyList.innerHTML = '<div class="history-item">No history yet</div>';
-        // Update current word display
-        currentDisplayedWord = '---';
-        currentWordEl.textContent = '---';
+void WebServerTask::sendEvent(BufferPrint& event_data, const char* event) {
+    if (event_data.overflowed()) {
+        logger_.log("Web event too large; dropped");
         return;
     }
-    
-    historyList.innerHTML = history.map(item => 
-        `<div class="history-item">${escapeHtml(item)}</div>`
-    ).join('');
-    
-    // Update current word display with the most recent history item
-    currentDisplayedWord = history[0] || '---';
-    currentWordEl.textContent = currentDisplayedWord;
-}
-
-function escapeHtml(text) {
-    const div = document.createElement('div');
-    div.textContent = text;
-    return div.innerHTML;
-}
-
-function toggleHistorySidebar() {
-    historySidebar.classList.toggle('closed');
-}
-
-function closeHistorySidebar() {
-    historySidebar.classList.add('closed');
-}
-
-
-// Admin Functions
-async function checkAdminMode() {
-    try {
-        const adminStatusResponse = await fetchAdminStatus();
-        isAdminMode = adminStatusResponse.admin_mode || false;
-        displayEnabled = adminStatusResponse.enabled !== false;
-        
-        // Update UI based on admin status
-        if (isAdminMode) {
-            adminLoginSection.style.display = 'none';
-            adminSection.style.display = 'block';
-            adminStatus.textContent = 'Admin Mode';
-            
-            // Show admin-only sections
-            const currentStateSection = document.getElementById('currentStateSection');
-            const historySection = document.getElementById('historySection');
-            if (currentStateSection) currentStateSection.classList.add('show');
-            if (historySection) historySection.classList.add('show');
-            
-            updateAdminButtons();
-            
-            // Update disabled overlay based on display state
-            if (displayEnabled) {
-                hideDisabledOverlay();
-            } else {
-                showDisabledOverlay();
-            }
-        } else {
-            adminLoginSection.style.display = 'block';
-            adminSection.style.display = 'none';
-            adminStatus.textContent = 'Guest Mode';
-            
-            // Hide admin-only sections
-            const currentStateSection = document.getElementById('currentStateSection');
-            const historySection = document.getElementById('historySection');
-            if (currentStateSection) currentStateSection.classList.remove('show');
-            if (historySection) historySection.classList.remove('show');
-        }
-        
-        return isAdminMode;
-    } catch (error) {
-        console.error('Failed to check admin mode:', error);
-        isAdminMode = false;
-        adminLoginSection.style.display = 'block';
-        adminSection.style.display = 'none';
-        adminStatus.textContent = 'Guest Mode';
-        
-        // Hide admin-only sections on error
-        const currentStateSection = document.getElementById('currentStateSection');
-        const historySection = document.getElementById('historySection');
-        if (currentStateSection) currentStateSection.classList.remove('show');
-        if (historySection) historySection.classList.remove('show');
-        
-        return false;
-    }
-}
-
-function updateAdminButtons() {
-    if (displayEnabled) {
-        enableBtn.disabled = true;
-        disableBtn.disabled = false;
-    } else {
-        enableBtn.disabled = false;
-        disableBtn.disabled = true;
+    // A client whose queue is full (SSE_MAX_QUEUED_MESSAGES) misses the event, and with it a delta that later ones
+    // don't repeat, so resync everyone
+    if (events_.send(event_data.c_str(), event) != AsyncEventSource::ENQUEUED) {
+        events_resync_ = true;
     }
 }
 
-async function handleAdminAction(action) {
-    try {
-        const response = await sendAdminAction(action);
-        if (response.success) {
-            displayEnabled = (action === 'enable');
-            updateAdminButtons();
-            
-            // Update disabled overlay
-            if (displayEnabled) {
-                hideDisabledOverlay();
-            } else {
-                showDisabledOverlay();
-            }
-            
-            showToast(response.message, 'success');
-        } else {
-            showToast(response.message, 'error');
-        }
-    } catch (error) {
-        showToast(`Error: ${error.message}`, 'error');
+void WebServerTask::pushStateEvents(const SplitflapState& state, const StateChanges& changes, bool snapshot) {
+    if (snapshot) {
+        events_resync_ = false;
     }
-}
 
-async function loginAsAdmin() {
-    // Trigger admin authentication by trying to access admin endpoint
-    try {
-        const response = await fetch(`${API_BASE_URL}/admin/status`);
-        if (response.ok) {
-            // Successfully authenticated as admin
-            await checkAdminMode();
-            showToast('Logged in as admin', 'success');
-        } else if (response.status === 401) {
-            // Authentication required - browser will show login prompt
-            showToast('Please enter admin credentials', 'error');
-        } else {
-            showToast('Login failed', 'error');
-        }
-    } catch (error) {
-        showToast(`Login error: ${error.message}`, 'error');
+    // Nobody to tell, but later deltas are still relative to this state
+    if (events_.count() == 0) {
+        last_pushed_state_ = state;
+        events_resync_ = false;
+        return;
     }
-}
-
-function logoutAdmin() {
-    // Clear admin credentials and refresh
-    window.location.href = `${API_BASE_URL}/logout`;
-}
 
-function showDisabledOverlay() {
-    if (disabledOverlay) {
-        disabledOverlay.classList.add('show');
+    if (snapshot || changes.global) {
+        BufferPrint event_data(event_buffer_, sizeof(event_buffer_));
+        JsonWriter(event_data).beginObject()
+            .field("num_modules", state.num_modules)
+            .field("mode", state.mode == SplitflapMode::MODE_RUN ? "run" : "sensor_test")
+            .field("paused", state.paused)
+            .endObject();
+        sendEvent(event_data, "state");
     }
-}
 
-function hideDisabledOverlay() {
-    if (disabledOverlay) {
-        disabledOverlay.classList.remove('show');
-    }
-}
+    sendModuleEvents(state, changes, snapshot);
 
-// UI Functions
-function showToast(message, type = 'success') {
-    toast.textContent = message;
-    toast.className = `toast ${type}`;
-    toast.classList.add('show');
-    
-    setTimeout(() => {
-        toast.classList.remove('show');
-    }, 3000);
-}
-
-function updateStatusDisplay(status) {
-    currentStatus = status;
-    
-    if (status.connected) {
-        statusIndicator.classList.add('connected');
-        statusText.textContent = `Connected (${status.num_modules} modules)`;
-        numModules = status.num_modules;
-        sendButton.disabled = false;
-        
-        // Always create alphabet keyboard when connected
-        createAlphabetKeyboard();
-        
-        // Update history and current word from status
-        if (status.history) {
-            history = status.history;
-            updateHistoryDisplay();
+    for (uint8_t i = 0; i < state.num_modules; i++) {
+        const SplitflapModuleState& module = state.modules[i];
+        const SplitflapModuleState& last_module = last_pushed_state_.modules[i];
+        bool new_fault = (module.state == SENSOR_ERROR || module.state == PANIC) && module.state != last_module.state;
+        bool new_home_error = state.counters[i].count_missed_home > last_pushed_state_.counters[i].count_missed_home
+            || state.counters[i].count_unexpected_home > last_pushed_state_.counters[i].count_unexpected_home;
+        if (!changes.module(i) || !(new_fault || new_home_error)) {
+            continue;
         }
-        
-        if (status.current_word) {
-            currentDisplayedWord = status.current_word;
-            currentWordEl.textContent = status.current_word;
+        BufferPrint event_data(event_buffer_, sizeof(event_buffer_));
+        JsonWriter(event_data).beginObject()
+            .field("index", i)
+            .field("state", moduleStateName(module.state))
+            .field("count_missed_home", state.counters[i].count_missed_home)
+            .field("count_unexpected_home", state.counters[i].count_unexpected_home)
+            .endObject();
+        sendEvent(event_data, "module_error");
+    }
+
+    if (anyModuleMoving(last_pushed_state_) && !anyModuleMoving(state)) {
+        BufferPrint event_data(event_buffer_, sizeof(event_buffer_));
+        JsonWriter json(event_data);
+        json.beginObject().key("text");
+        writeDisplayedText(json, state);
+        json.endObject();
+        sendEvent(event_data, "settled");
+    }
+
+    last_pushed_state_ = state;
+}
+
+void WebServerTask::sendModuleEvents(const SplitflapState& state, const StateChanges& changes, bool snapshot) {
+    uint8_t batch[MODULES_PER_EVENT];
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < state.num_modules; i++) {
+        bool changed = state.modules[i] != last_pushed_state_.modules[i] || state.counters[i] != last_pushed_state_.counters[i];
+        if (!snapshot && !(changes.module(i) && changed)) {
+            continue;
         }
-        
-        // Handle display enabled/disabled state
-        if (status.display_enabled === false) {
-            showDisabledOverlay();
-        } else {
-            hideDisabledOverlay();
+        batch[count++] = i;
+        if (count == MODULES_PER_EVENT) {
+            sendModuleBatch(state, batch, count);
+            count = 0;
         }
-    } else {
-        statusIndicator.classList.remove('connected');
-        statusText.textContent = `Disconnected: ${status.error || 'Unknown error'}`;
-        sendButton.disabled = true;
-        
-        // Update current word display
-        currentWordEl.textContent = '---';
-        hideDisabledOverlay();
     }
-    
-    // Update display grid if number of modules changed
-    if (status.connected && status.num_modules !== currentText.length) {
-        initializeDisplay();
+    if (count > 0) {
+        sendModuleBatch(state, batch, count);
     }
 }
 
-function initializeDisplay() {
-    // Clear existing boxes
-    displayGrid.innerHTML = '';
-    
-    // Create boxes for each module
-    currentText = new Array(numModules).fill(' ');
-    
-    for (let i = 0; i < numModules; i++) {
-        const box = document.createElement('div');
-        box.className = 'display-box';
-        box.textContent = ' ';
-        box.dataset.index = i.toString();
-        box.tabIndex = 0; // Make focusable
-        
-        // Add click handler
-        box.addEventListener('click', () => focusBox(i));
-        
-        // Add keyboard input handler
-        box.addEventListener('keydown', (e) => handleBoxKeydown(e, i));
-        
-        displayGrid.appendChild(box);
+void WebServerTask::sendModuleBatch(const SplitflapState& state, const uint8_t* modules, uint8_t count) {
+    BufferPrint event_data(event_buffer_, sizeof(event_buffer_));
+    JsonWriter json(event_data);
+    json.beginObject().beginArray("modules");
+    for (uint8_t i = 0; i < count; i++) {
+        writeModuleJSON(json, state, modules[i]);
     }
-    
-    // Focus first box
-    focusBox(0);
+    json.endArray().endObject();
+    sendEvent(event_data, "modules");
 }
 
-function focusBox(index) {
-    // Remove focus from all boxes
-    document.querySelectorAll('.display-box').forEach(box => {
-        box.classList.remove('focused');
-    });
-    
-    // Add focus to selected box
-    const box = document.querySelector(`[data-index="${index}"]`);
-    if (box) {
-        box.classList.add('focused');
-        box.focus();
-        currentFocusIndex = index;
-    }
+bool WebServerTask::checkAuthentication(AsyncWebServerRequest* request) {
+    // Allow guest access - no authentication required for basic functionality
+    return true;
 }
 
-function updateDisplayBox(index, char) {
-    const box = document.querySelector(`[data-index="${index}"]`);
-    if (box) {
-        box.textContent = char;
-        box.classList.toggle('filled', char !== ' ');
+bool WebServerTask::checkAdminAuthentication(AsyncWebServerRequest* request) {
+    if (!request->authenticate(WEB_SERVER_USERNAME, WEB_SERVER_PASSWORD)) {
+        request->requestAuthentication("Splitflap Display Controller - Admin", false);
+        return false;
     }
+    return true;
 }
 
-function handleBoxKeydown(event, index) {
-    event.preventDefault();
-    
-    const key = event.key.toLowerCase();
-    
-    // Handle special keys
-    if (key === 'backspace') {
-        if (currentText[index] !== ' ') {
-            currentText[index] = ' ';
-            updateDisplayBox(index, ' ');
-        } else if (index > 0) {
-            focusBox(index - 1);
-        }
-        return;
-    }
-    
-    if (key === 'arrowleft' && index > 0) {
-        focusBox(index - 1);
-        return;
-    }
-    
-    if (key === 'arrowright' && index < numModules - 1) {
-        focusBox(index + 1);
-        return;
+void WebServerTask::bufferBody(AsyncWebServerRequest* request, uint8_t* data, size_t len, size_t index, size_t total) {
+    // The buffer belongs to the request, which frees it when it's done
+    if (index == 0 && total <= MAX_BODY_SIZE) {
+        request->_tempObject = malloc(total);
     }
-    
-    if (key === 'enter') {
-        sendCurrentText();
-        return;
-    }
-    
-    // Handle character input
-    if (currentStatus?.alphabet.includes(key.toUpperCase())) {
-        currentText[index] = key.toUpperCase();
-        updateDisplayBox(index, key.toUpperCase());
-        
-        // Move to next box if not the last one
-        if (index < numModules - 1) {
-            focusBox(index + 1);
-        }
+    if (request->_tempObject != nullptr && index + len <= total) {
+        memcpy((uint8_t*)request->_tempObject + index, data, len);
     }
 }
 
-function createAlphabetKeyboard() {
-    // Use server alphabet if available, otherwise use default
-    const alphabet = currentStatus?.alphabet || [' ', 'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M', 'N', 'O', 'P', 'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z', '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '.', ',', "'"];
-    
-    console.log('Creating alphabet keyboard with:', alphabet);
-    alphabetKeyboard.innerHTML = '';
-    
-    alphabet.forEach(char => {
-        const key = document.createElement('div');
-        key.className = 'key';
-        key.textContent = char;
-        
-        if (char === ' ') {
-            key.classList.add('space');
-            key.textContent = 'SPACE';
+bool WebServerTask::parseJsonBody(AsyncWebServerRequest* request, JsonDocument& doc) {
+    if (request->_tempObject == nullptr) {
+        if (request->contentLength() > MAX_BODY_SIZE) {
+            request->send(413, "application/json", "{\"success\": false, \"message\": \"Request body too large\"}");
+        } else {
+            request->send(400, "application/json", "{\"success\": false, \"message\": \"No JSON data provided\"}");
         }
-        
-        key.addEventListener('click', () => {
-            console.log('Clicked key:', char);
-            if (currentText[currentFocusIndex] !== ' ') {
-                key.classList.add('used');
-            }
-            
-            currentText[currentFocusIndex] = char;
-            updateDisplayBox(currentFocusIndex, char);
-            
-            // Move to next box if not the last one
-            if (currentFocusIndex < numModules - 1) {
-                focusBox(currentFocusIndex + 1);
-            }
-        });
-        
-        alphabetKeyboard.appendChild(key);
-    });
-    
-    console.log('Alphabet keyboard created with', alphabet.length, 'keys');
-}
-
-function sendCurrentText() {
-    if (!currentStatus?.connected) {
-        showToast('Not connected to splitflap display', 'error');
-        return;
-    }
-    
-    const text = currentText.join('');
-    sendText(text)
-        .then(response => {
-            if (response.success) {
-                showToast(`Sent "${text}"`, 'success');
-                // Reload history from device (this will update current word display)
-                loadHistory();
-            } else {
-                showToast(response.message, 'error');
-            }
-        })
-        .catch(error => {
-            showToast(`Error: ${error.message}`, 'error');
-        });
-}
-
-function sendCurrentTextWithForceMovement() {
-    if (!currentStatus?.connected) {
-        showToast('Not connected to splitflap display', 'error');
-        return;
+        return false;
     }
     
-    const text = currentText.join('');
-    sendText(text, true)
-        .then(response => {
-            if (response.success) {
-                showToast(`Sent "${text}" (force movement)`, 'success');
-                // Reload history from device (this will update current word display)
-                loadHistory();
-            } else {
-                showToast(response.message, 'error');
-            }
-        })
-        .catch(error => {
-            showToast(`Error: ${error.message}`, 'error');
-        });
-}
-
-function clearDisplay() {
-    currentText = new Array(numModules).fill(' ');
-    
-    for (let i = 0; i < numModules; i++) {
-        updateDisplayBox(i, ' ');
+    DeserializationError error = deserializeJson(doc, (const char*)request->_tempObject, request->contentLength());
+    if (error) {
+        request->send(400, "application/json", "{\"success\": false, \"message\": \"Invalid JSON\"}");
+        return false;
     }
-    
-    focusBox(0);
-    
-    // Reset keyboard key states
-    document.querySelectorAll('.key').forEach(key => {
-        key.classList.remove('used');
-    });
+    return true;
 }
 
-// Event Listeners
-sendButton.addEventListener('click', sendCurrentText);
-clearButton.addEventListener('click', clearDisplay);
-forceMovementButton.addEventListener('click', sendCurrentTextWithForceMovement);
-
-// History sidebar event listeners
-historyToggle.addEventListener('click', toggleHistorySidebar);
-historyClose.addEventListener('click', closeHistorySidebar);
-
-// Admin control event listeners
-enableBtn.addEventListener('click', () => handleAdminAction('enable'));
-disableBtn.addEventListener('click', () => handleAdminAction('disable'));
-adminLoginBtn.addEventListener('click', loginAsAdmin);
-adminLogoutBtn.addEventListener('click', logoutAdmin);
-
-// Global keyboard shortcuts
-document.addEventListener('keydown', (e) => {
-    if (e.ctrlKey || e.metaKey) {
-        switch (e.key) {
-            case 'Enter':
-                e.preventDefault();
-                sendCurrentText();
-                break;
-            case 'Backspace':
-                e.preventDefault();
-                clearDisplay();
-                break;
-        }
-    }
-});
-
-// Status update loop
-async function updateStatus() {
-    try {
-        console.log('Fetching status...');
-        const status = await fetchStatus();
-        console.log('Status received:', status);
-        updateStatusDisplay(status);
-    } catch (error) {
-        console.error('Failed to fetch status:', error);
-        statusText.textContent = 'Connection error';
-        statusIndicator.classList.remove('connected');
-        sendButton.disabled = true;
-    }
+void WebServerTask::onJsonPost(const char* uri, bool admin, JsonRequestHandler handler) {
+    server_.on(uri, HTTP_POST, timed([this, admin, handler](AsyncWebServerRequest* request) {
+        if (!(admin ? checkAdminAuthentication(request) : checkAuthentication(request))) return;
+        
+        DynamicJsonDocument doc(1024);
+        if (!parseJsonBody(request, doc)) return;
+        handler(request, doc);
+    }), nullptr, bufferBody);
 }
 
-// Initialize app
-async function init() {
-    console.log('Initializing app...');
-    
-    // Initialize display first
-    initializeDisplay();
-    
-    // Create alphabet keyboard with default alphabet
-    createAlphabetKeyboard();
-    
-    // Initialize current word display
-    currentWordEl.textContent = '---';
-    
-    // Load history from device
-    await loadHistory();
-    
-    // Check admin mode
-    await checkAdminMode();
-    
-    // Initial status check
-    await updateStatus();
-    
-    // Set up periodic status updates
-    setInterval(updateStatus, UPDATE_INTERVAL);
-    
-    console.log('App initialized');
+void WebServerTask::sendJSON(AsyncWebServerRequest* request, size_t size_hint, JsonContent content) {
+    // Written in chunks straight into the response buffer, rather than building a String or document first
+    AsyncResponseStream* response = request->beginResponseStream("application/json", size_hint);
+    JsonWriter json(*response);
+    content(json);
+    request->send(response);
 }
 
-// Start the app
-document.addEventListener('DOMContentLoaded', init);
-    </script>
-    
-    <!-- Disabled State Overlay -->
-    <div class="disabled-overlay" id="disabledOverlay">
-        <div class="disabled-icon">🚫</div>
-        <div class="disabled-message">
-            <div class="disabled-title">Display Disabled</div>
-            <div class="disabled-subtitle">The display has been disabled by an administrator.<br>Please contact an admin to re-enable it.</div>
-        </div>
-    </div>
-</body>
-</html>
-)rawliteral";
-
-WebServerTask::WebServerTask(SplitflapTask& splitflap_task, Logger& logger, const uint8_t task_core, const uint16_t port)
-    : Task("WebServer", 8192, 1, task_core), splitflap_task_(splitflap_task), logger_(logger), server_(port) {
+void WebServerTask::sendChunked(AsyncWebServerRequest* request, const char* content_type, ChunkedContent content) {
+    // Each chunk is filled as there's room to send it, by writing the whole response again and keeping just that
+    // chunk's part, so content must write exactly the same thing every time (i.e. from a snapshot)
+    request->send(request->beginChunkedResponse(content_type, [content](uint8_t* buffer, size_t max_len, size_t index) {
+        WindowPrint window(buffer, max_len, index);
+        content(window);
+        return window.length();
+    }));
 }
 
-void WebServerTask::run() {
-    char buf[200];
-    
-    logger_.log("Starting web server task...");
-    
-    // Connect to WiFi if not already connected
-    if (WiFi.status() != WL_CONNECTED) {
-        logger_.log("Connecting to WiFi...");
-        WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
-        
-        int attempts = 0;
-        while (WiFi.status() != WL_CONNECTED && attempts < 20) {
-            delay(1000);
-            attempts++;
-            snprintf(buf, sizeof(buf), "WiFi connection attempt %d", attempts);
-            logger_.log(buf);
-        }
-        
-        if (WiFi.status() != WL_CONNECTED) {
-            logger_.log("Failed to connect to WiFi");
-            return;
-        }
-    }
-    
-    snprintf(buf, sizeof(buf), "WiFi connected. IP address: %s", WiFi.localIP().toString().c_str());
-    logger_.log(buf);
-    
-    setupWebServer();
-    server_.begin();
-    server_started_ = true;
-    
-    snprintf(buf, sizeof(buf), "Web server started on http://%s", WiFi.localIP().toString().c_str());
-    logger_.log(buf);
-    
-    while (1) {
-        server_.handleClient();
-        delay(1);
+void WebServerTask::serveAsset(AsyncWebServerRequest* request, const WebAsset& asset) {
+    AsyncWebServerResponse* response;
+    if (request->hasHeader("If-None-Match") && strstr(request->header("If-None-Match").c_str(), asset.etag) != nullptr) {
+        response = request->beginResponse(304);
+    } else {
+        response = request->beginResponse_P(200, asset.content_type, asset.data, asset.size);
+        response->addHeader("Content-Encoding", "gzip");
     }
+    response->addHeader("ETag", asset.etag);
+    // Anything else has a fixed URL, so it's revalidated every time (which is cheap with the ETag)
+    response->addHeader("Cache-Control", asset.immutable ? "public, max-age=31536000, immutable" : "no-cache");
+    request->send(response);
 }
 
-bool WebServerTask::checkAuthentication() {
-    // Allow guest access - no authentication required for basic functionality
-    return true;
-}
-
-bool WebServerTask::checkAdminAuthentication() {
-    if (!server_.authenticate(WEB_SERVER_USERNAME, WEB_SERVER_PASSWORD)) {
-        server_.requestAuthentication(BASIC_AUTH, "Splitflap Display Controller - Admin");
-        return false;
-    }
-    return true;
+ArRequestHandlerFunction WebServerTask::timed(ArRequestHandlerFunction handler) {
+    return [this, handler](AsyncWebServerRequest* request) {
+        uint32_t start_micros = micros();
+        handler(request);
+        request_duration_.record(micros() - start_micros);
+    };
 }
 
 void WebServerTask::setupWebServer() {
-    // Root page - serve the embedded HTML
-    server_.on("/", [this]() {
-        if (!checkAuthentication()) return;
-        server_.send(200, "text/html", HTML_CONTENT);
+    // Live state events. A new client gets a full snapshot on the next push.
+    events_.onConnect([this](AsyncEventSourceClient* client) {
+        events_snapshot_requested_.store(true);
+        xTaskNotifyGive(getHandle());
     });
+    server_.addHandler(&events_);
+    
+    // Frontend, pre-compressed and served straight from flash
+    for (const WebAsset& asset : WEB_ASSETS) {
+        server_.on(asset.path, HTTP_GET, timed([this, &asset](AsyncWebServerRequest* request) {
+            if (!checkAuthentication(request)) return;
+            serveAsset(request, asset);
+        }));
+    }
     
     // API endpoints
-    server_.on("/status", [this]() {
-        if (!checkAuthentication()) return;
-        String statusJson = getStatusJSON();
-        server_.send(200, "application/json", statusJson);
-    });
+    server_.on("/status", timed([this](AsyncWebServerRequest* request) {
+        if (!checkAuthentication(request)) return;
+        // Grows with the number of modules, so it's streamed rather than buffered
+        std::shared_ptr<SplitflapState> state = std::make_shared<SplitflapState>(splitflap_task_.getState());
+        sendChunked(request, "application/json", [state](Print& out) {
+            JsonWriter json(out);
+            writeStatusJSON(json, *state);
+        });
+    }));
+    
+    // Prometheus metrics; everything is read from snapshots, so scraping never holds up the splitflap task
+    server_.on("/metrics", HTTP_GET, timed([this](AsyncWebServerRequest* request) {
+        if (!checkAuthentication(request)) return;
+        // Per-module metrics make this large, so it's streamed (from a snapshot, so every chunk sees the same values)
+        std::shared_ptr<MetricsSnapshot> snapshot = std::make_shared<MetricsSnapshot>();
+        takeMetricsSnapshot(*snapshot);
+        sendChunked(request, PrometheusWriter::CONTENT_TYPE, [snapshot](Print& out) {
+            PrometheusWriter metrics(out);
+            writeMetrics(metrics, *snapshot);
+        });
+    }));
     
-    server_.on("/text", HTTP_POST, [this]() {
-        if (!checkAuthentication()) return;
-        
+    onJsonPost("/text", false, [this](AsyncWebServerRequest* request, JsonDocument& doc) {
         // Check if display is enabled
         if (!display_enabled_) {
-            server_.send(403, "application/json", "{\"success\": false, \"message\": \"Display is disabled by admin\"}");
+            request->send(403, "application/json", "{\"success\": false, \"message\": \"Display is disabled by admin\"}");
             return;
         }
         
-        if (!server_.hasArg("plain")) {
-            server_.send(400, "application/json", "{\"success\": false, \"message\": \"No JSON data provided\"}");
-            return;
-        }
-        
-        String jsonString = server_.arg("plain");
-        
-        // Parse JSON
-        DynamicJsonDocument doc(1024);
-        DeserializationError error = deserializeJson(doc, jsonString);
+        const char* message = doc["message"] | "";
+        bool forceMovement = doc["force_movement"] | false;
+        size_t length = strlen(message);
         
-        if (error) {
-            server_.send(400, "application/json", "{\"success\": false, \"message\": \"Invalid JSON\"}");
+        if (length == 0) {
+            request->send(400, "application/json", "{\"success\": false, \"message\": \"Empty message\"}");
             return;
         }
         
-        String message = doc["message"];
-        bool forceMovement = doc["force_movement"] | false;
-        
-        if (message.length() == 0) {
-            server_.send(400, "application/json", "{\"success\": false, \"message\": \"Empty message\"}");
+        uint32_t retry_after_millis = 0;
+        AdmissionResult result = text_admission_.submit(request->client()->remoteIP(), message, length, forceMovement, retry_after_millis);
+        if (result == AdmissionResult::RATE_LIMITED) {
+            char body[100];
+            uint32_t retry_after = max((retry_after_millis + 999) / 1000, (uint32_t)1);
+            snprintf(body, sizeof(body), "{\"success\": false, \"message\": \"Too many messages\", \"retry_after\": %u}", retry_after);
+            AsyncWebServerResponse* response = request->beginResponse(429, "application/json", body);
+            response->addHeader("Retry-After", String(retry_after));
+            request->send(response);
             return;
         }
         
-        // Send to splitflap
-        char buf[message.length() + 1];
-        message.toCharArray(buf, sizeof(buf));
-        
-        splitflap_task_.showString(buf, message.length(), forceMovement);
-        
         // Add to history
-        addToHistory(message);
+        addToHistory(message, length);
         
         char logBuf[200];
-        snprintf(logBuf, sizeof(logBuf), "Web request: displaying '%s' (force: %s)", buf, forceMovement ? "true" : "false");
+        snprintf(logBuf, sizeof(logBuf), "Web request: %s '%s' (force: %s)", result == AdmissionResult::SHOWN ? "displaying" : "queued",
+            message, forceMovement ? "true" : "false");
         logger_.log(logBuf);
         
-        server_.send(200, "application/json", "{\"success\": true, \"message\": \"Text sent to display\"}");
+        if (result == AdmissionResult::QUEUED) {
+            // Have the web server task check for when the display is free
+            xTaskNotifyGive(getHandle());
+            request->send(202, "application/json", "{\"success\": true, \"queued\": true, \"message\": \"Text queued until the display settles\"}");
+            return;
+        }
+        request->send(200, "application/json", "{\"success\": true, \"message\": \"Text sent to display\"}");
     });
     
-    server_.on("/calibrate", HTTP_POST, [this]() {
-        if (!checkAuthentication()) return;
+    server_.on("/calibrate", HTTP_POST, timed([this](AsyncWebServerRequest* request) {
+        if (!checkAuthentication(request)) return;
         // Trigger recalibration
         splitflap_task_.resetAll();
         
         logger_.log("Web request: triggered recalibration");
         
-        server_.send(200, "application/json", "{\"success\": true, \"message\": \"Recalibration started\"}");
-    });
+        request->send(200, "application/json", "{\"success\": true, \"message\": \"Recalibration started\"}");
+    }));
     
     // History endpoints
-    server_.on("/history", HTTP_GET, [this]() {
-        if (!checkAuthentication()) return;
-        String historyJson = getHistoryJSON();
-        server_.send(200, "application/json", historyJson);
-    });
+    server_.on("/history", HTTP_GET, timed([this](AsyncWebServerRequest* request) {
+        if (!checkAuthentication(request)) return;
+        // Newest first; clients can page back with before=<sequence>, or fetch only newer entries with since=<sequence>
+        uint32_t since = queryParam(request, "since", 0);
+        uint32_t before = queryParam(request, "before", 0);
+        uint32_t limit = queryParam(request, "limit", DEFAULT_HISTORY_PAGE);
+        if (limit > MAX_HISTORY_PAGE) {
+            limit = MAX_HISTORY_PAGE;
+        }
+        // Entries can be added meanwhile, so this can't be streamed like /status
+        sendJSON(request, 64 + limit * HISTORY_ENTRY_JSON_SIZE, [this, since, before, limit](JsonWriter& json) {
+            writeHistoryJSON(json, since, before, limit);
+        });
+    }));
     
     // Admin endpoints
-    server_.on("/admin/status", HTTP_GET, [this]() {
-        if (!checkAdminAuthentication()) return;
-        String adminJson = getAdminStatusJSON();
-        server_.send(200, "application/json", adminJson);
-    });
+    server_.on("/admin/status", HTTP_GET, timed([this](AsyncWebServerRequest* request) {
+        if (!checkAdminAuthentication(request)) return;
+        sendJSON(request, ADMIN_STATUS_JSON_SIZE, [this](JsonWriter& json) { writeAdminStatusJSON(json); });
+    }));
     
-    server_.on("/admin/control", HTTP_POST, [this]() {
-        if (!checkAdminAuthentication()) return;
-        if (!server_.hasArg("plain")) {
-            server_.send(400, "application/json", "{\"success\": false, \"message\": \"No JSON data provided\"}");
-            return;
-        }
-        
-        String body = server_.arg("plain");
-        DynamicJsonDocument doc(1024);
-        DeserializationError error = deserializeJson(doc, body);
-        
-        if (error) {
-            server_.send(400, "application/json", "{\"success\": false, \"message\": \"Invalid JSON\"}");
-            return;
-        }
-        
+    onJsonPost("/admin/control", true, [this](AsyncWebServerRequest* request, JsonDocument& doc) {
         if (doc.containsKey("action")) {
             String action = doc["action"];
             if (action == "enable") {
                 display_enabled_ = true;
                 logger_.log("Display enabled by admin");
-                server_.send(200, "application/json", "{\"success\": true, \"message\": \"Display enabled\"}");
+                request->send(200, "application/json", "{\"success\": true, \"message\": \"Display enabled\"}");
             } else if (action == "disable") {
                 display_enabled_ = false;
                 logger_.log("Display disabled by admin");
-                server_.send(200, "application/json", "{\"success\": true, \"message\": \"Display disabled\"}");
+                request->send(200, "application/json", "{\"success\": true, \"message\": \"Display disabled\"}");
+            } else if (action == "pause") {
+                splitflap_task_.pause();
+                logger_.log("Motion paused by admin");
+                request->send(200, "application/json", "{\"success\": true, \"message\": \"Motion paused\"}");
+            } else if (action == "resume") {
+                splitflap_task_.resume();
+                logger_.log("Motion resumed by admin");
+                request->send(200, "application/json", "{\"success\": true, \"message\": \"Motion resumed\"}");
+            } else if (action == "emergency_stop") {
+                splitflap_task_.disableAll();
+                logger_.log("Emergency stop by admin - all modules disabled");
+                request->send(200, "application/json", "{\"success\": true, \"message\": \"All modules disabled\"}");
             } else {
-                server_.send(400, "application/json", "{\"success\": false, \"message\": \"Unknown action\"}");
+                request->send(400, "application/json", "{\"success\": false, \"message\": \"Unknown action\"}");
             }
         } else {
-            server_.send(400, "application/json", "{\"success\": false, \"message\": \"Missing action field\"}");
+            request->send(400, "application/json", "{\"success\": false, \"message\": \"Missing action field\"}");
         }
     });
     
-    server_.on("/history", HTTP_POST, [this]() {
-        if (!checkAuthentication()) return;
-        if (!server_.hasArg("plain")) {
-            server_.send(400, "application/json", "{\"success\": false, \"message\": \"No JSON data provided\"}");
-            return;
-        }
-        
-        String body = server_.arg("plain");
-        DynamicJsonDocument doc(1024);
-        DeserializationError error = deserializeJson(doc, body);
-        
-        if (error) {
-            server_.send(400, "application/json", "{\"success\": false, \"message\": \"Invalid JSON\"}");
-            return;
-        }
-        
+    onJsonPost("/history", false, [this](AsyncWebServerRequest* request, JsonDocument& doc) {
         if (doc.containsKey("text")) {
-            String text = doc["text"];
-            addToHistory(text);
-            server_.send(200, "application/json", "{\"success\": true, \"message\": \"History updated\"}");
+            const char* text = doc["text"] | "";
+            addToHistory(text, strlen(text));
+            request->send(200, "application/json", "{\"success\": true, \"message\": \"History updated\"}");
         } else {
-            server_.send(400, "application/json", "{\"success\": false, \"message\": \"Missing text field\"}");
+            request->send(400, "application/json", "{\"success\": false, \"message\": \"Missing text field\"}");
         }
     });
     
     // Logout endpoint
-    server_.on("/logout", [this]() {
-        server_.sendHeader("WWW-Authenticate", "Basic realm=\"Login Required\"");
-        server_.send(401, "text/plain", "Logged out");
-    });
+    server_.on("/logout", timed([](AsyncWebServerRequest* request) {
+        AsyncWebServerResponse* response = request->beginResponse(401, "text/plain", "Logged out");
+        response->addHeader("WWW-Authenticate", "Basic realm=\"Login Required\"");
+        request->send(response);
+    }));
     
     // Handle 404
-    server_.onNotFound([this]() {
-        server_.send(404, "application/json", "{\"success\": false, \"message\": \"Not found\"}");
-    });
-}
-
-String WebServerTask::getAlphabetString() {
-    String alphabet = "[";
-    for (int i = 0; i < NUM_FLAPS; i++) {
-        if (i > 0) {
-            alphabet += ",";
-        }
-        alphabet += "\"";
-        char c = (char)flaps[i];
-        alphabet += c;
-        alphabet += "\"";
-    }
-    alphabet += "]";
-    return alphabet;
-}
-
-String WebServerTask::getStatusJSON() {
-    SplitflapState state = splitflap_task_.getState();
-    
-    String json = "{";
-    json += "\"connected\": true,";
-    json += "\"num_modules\": " + String(NUM_MODULES) + ",";
-    json += "\"alphabet\": " + getAlphabetString() + ",";
-    json += "\"mode\": \"" + String(state.mode == SplitflapMode::MODE_RUN ? "run" : "sensor_test") + "\"";
-    json += "}";
-    
-    return json;
+    server_.onNotFound(timed([](AsyncWebServerRequest* request) {
+        request->send(404, "application/json", "{\"success\": false, \"message\": \"Not found\"}");
+    }));
 }
 
-String WebServerTask::getHistoryJSON() {
-    DynamicJsonDocument doc(2048);
-    JsonArray historyArray = doc.createNestedArray("history");
-    
-    for (int i = 0; i < history_count_; i++) {
-        historyArray.add(history_[i]);
+void WebServerTask::writeDisplayedText(JsonWriter& json, const SplitflapState& state) {
+    char text[NUM_MODULES];
+    for (uint8_t i = 0; i < state.num_modules; i++) {
+        text[i] = flaps[state.modules[i].flap_index];
     }
-    
-    String result;
-    serializeJson(doc, result);
-    return result;
+    json.value(text, state.num_modules);
 }
 
-String WebServerTask::getAdminStatusJSON() {
-    DynamicJsonDocument doc(1024);
-    doc["enabled"] = display_enabled_;
-    doc["admin_mode"] = true;
-    
-    String result;
-    serializeJson(doc, result);
-    return result;
+void WebServerTask::writeStatusJSON(JsonWriter& json, const SplitflapState& state) {
+    json.beginObject()
+        .field("connected", true)
+        .field("num_modules", state.num_modules)
+        .beginArray("alphabet");
+    for (int i = 0; i < NUM_FLAPS; i++) {
+        json.value((char)flaps[i]);
+    }
+    json.endArray()
+        .field("mode", state.mode == SplitflapMode::MODE_RUN ? "run" : "sensor_test")
+        .field("paused", state.paused);
+    json.key("current_text");
+    writeDisplayedText(json, state);
+    json.beginArray("modules");
+    for (uint8_t i = 0; i < state.num_modules; i++) {
+        writeModuleJSON(json, state, i);
+    }
+    json.endArray().endObject();
+}
+
+void WebServerTask::writeHistoryJSON(JsonWriter& json, uint32_t since, uint32_t before, uint32_t limit) {
+    uint32_t latest = history_.latestSequence();
+    uint32_t oldest = history_.oldestSequence();
+    uint32_t sequence = (before != 0 && before <= latest) ? before - 1 : latest;
+
+    json.beginObject()
+        .field("latest", latest)
+        .field("oldest", oldest)
+        .beginArray("history");
+    HistoryEntry entry;
+    uint32_t count = 0;
+    for (; sequence > since && count < limit && history_.get(sequence, entry); sequence--, count++) {
+        json.beginObject()
+            .field("sequence", entry.sequence)
+            .field("time", entry.unix_time)
+            .key("text").value(entry.text, entry.length)
+            .endObject();
+    }
+    json.endArray()
+        // Whether there are older entries (after since) than the ones returned
+        .field("more", sequence > since && sequence >= oldest && oldest != 0)
+        .endObject();
+}
+
+void WebServerTask::writeAdminStatusJSON(JsonWriter& json) {
+    MailboxStats mailbox_stats = splitflap_task_.getMailboxStats();
+    PriorityLaneStats priority_stats = splitflap_task_.getPriorityLaneStats();
+    TextAdmissionStats text_stats = text_admission_.getStats();
+
+    json.beginObject()
+        .field("enabled", display_enabled_)
+        .field("admin_mode", true);
+    json.beginObject("command_mailbox")
+        .field("depth", mailbox_stats.depth)
+        .field("max_depth", mailbox_stats.max_depth)
+        .field("max_batch", mailbox_stats.max_batch)
+        .field("submitted", mailbox_stats.submitted)
+        .field("coalesced", mailbox_stats.coalesced)
+        .field("rejected", mailbox_stats.rejected)
+        .field("drains", mailbox_stats.drains)
+        .endObject();
+    json.beginObject("priority_lane")
+        .field("paused", splitflap_task_.getState().paused)
+        .field("handled", priority_stats.requests_handled)
+        .field("last_latency_us", priority_stats.last_latency_micros)
+        .field("max_latency_us", priority_stats.max_latency_micros)
+        .endObject();
+    json.beginObject("text_admission")
+        .field("accepted", text_stats.accepted)
+        .field("shown", text_stats.shown)
+        .field("coalesced", text_stats.coalesced)
+        .field("rate_limited", text_stats.rate_limited)
+        .field("pending", text_stats.pending)
+        .endObject();
+    json.endObject();
+}
+
+void WebServerTask::takeMetricsSnapshot(MetricsSnapshot& snapshot) {
+    splitflap_task_.getMetrics(snapshot.splitflap);
+    snapshot.state = splitflap_task_.getState();
+    snapshot.mailbox = splitflap_task_.getMailboxStats();
+    snapshot.priority = splitflap_task_.getPriorityLaneStats();
+    snapshot.serial = serial_task_.getProtoStats();
+    snapshot.request_duration = request_duration_;
+    snapshot.text = text_admission_.getStats();
+
+    snapshot.uptime_seconds = millis() / 1000;
+    snapshot.heap_free = ESP.getFreeHeap();
+    snapshot.heap_min_free = ESP.getMinFreeHeap();
+    snapshot.heap_max_alloc = ESP.getMaxAllocHeap();
+    snapshot.network = network_task_.getStats();
+    snapshot.wifi_rssi = snapshot.network.connected ? WiFi.RSSI() : 0;
+
+    // Handlers run on the AsyncTCP task, so that's the current one
+    snapshot.stack_min_free[0] = uxTaskGetStackHighWaterMark(splitflap_task_.getHandle());
+    snapshot.stack_min_free[1] = uxTaskGetStackHighWaterMark(serial_task_.getHandle());
+    snapshot.stack_min_free[2] = uxTaskGetStackHighWaterMark(getHandle());
+    snapshot.stack_min_free[3] = uxTaskGetStackHighWaterMark(network_task_.getHandle());
+    snapshot.stack_min_free[4] = uxTaskGetStackHighWaterMark(xTaskGetCurrentTaskHandle());
+
+#ifdef CHAINLINK_BASE
+    snapshot.supervisor = {};
+    serial_task_.getSupervisorState(snapshot.supervisor);
+#endif
+}
+
+void WebServerTask::writeMetrics(PrometheusWriter& metrics, const MetricsSnapshot& snapshot) {
+    writeSplitflapMetrics(metrics, snapshot);
+
+    const SerialProtoProtocol::Stats& serial = snapshot.serial;
+    metrics.family("splitflap_serial_rx_bytes_total", "counter", "Bytes received over serial (proto protocol)")
+        .sample(serial.rx_bytes);
+    metrics.family("splitflap_serial_rx_packets_total", "counter", "Valid packets received over serial")
+        .sample(serial.rx_packets);
+    metrics.family("splitflap_serial_bad_packets_total", "counter", "Corrupt packets received over serial, including CRC errors")
+        .sample(serial.bad_packets);
+    metrics.family("splitflap_serial_crc_errors_total", "counter", "Packets received over serial with a bad CRC")
+        .sample(serial.crc_errors);
+    metrics.family("splitflap_serial_tx_bytes_total", "counter", "Bytes sent over serial, by message class");
+    for (uint8_t i = 0; i < SerialProtoProtocol::NUM_TX_CLASSES; i++) {
+        metrics.sample("class", SerialProtoProtocol::txClassName(i), serial.tx_classes[i].bytes);
+    }
+    metrics.family("splitflap_serial_tx_messages_total", "counter", "Messages sent over serial, by message class");
+    for (uint8_t i = 0; i < SerialProtoProtocol::NUM_TX_CLASSES; i++) {
+        metrics.sample("class", SerialProtoProtocol::txClassName(i), serial.tx_classes[i].messages);
+    }
+    metrics.family("splitflap_serial_tx_held_back_total", "counter", "Messages held back because the serial TX buffer was too full, by message class");
+    for (uint8_t i = 0; i < SerialProtoProtocol::NUM_TX_CLASSES; i++) {
+        metrics.sample("class", SerialProtoProtocol::txClassName(i), serial.tx_classes[i].held_back);
+    }
+    metrics.family("splitflap_serial_tx_discarded_total", "counter", "Messages discarded rather than sent over serial, by message class");
+    for (uint8_t i = 0; i < SerialProtoProtocol::NUM_TX_CLASSES; i++) {
+        metrics.sample("class", SerialProtoProtocol::txClassName(i), serial.tx_classes[i].discarded);
+    }
+
+    metrics.histogram("splitflap_web_request_duration_seconds", "Time taken to handle web requests", snapshot.request_duration);
+    const TextAdmissionStats& text_stats = snapshot.text;
+    metrics.family("splitflap_web_text_accepted_total", "counter", "Messages accepted by /text (shown or queued)")
+        .sample(text_stats.accepted);
+    metrics.family("splitflap_web_text_shown_total", "counter", "Messages from /text sent to the display")
+        .sample(text_stats.shown);
+    metrics.family("splitflap_web_text_coalesced_total", "counter", "Queued /text messages replaced by a later one")
+        .sample(text_stats.coalesced);
+    metrics.family("splitflap_web_text_rate_limited_total", "counter", "Messages rejected by /text because the client sent too many")
+        .sample(text_stats.rate_limited);
+
+    writeSystemMetrics(metrics, snapshot);
+}
+
+void WebServerTask::writeSplitflapMetrics(PrometheusWriter& metrics, const MetricsSnapshot& snapshot) {
+    const SplitflapMetrics& splitflap_metrics = snapshot.splitflap;
+    const SplitflapState& state = snapshot.state;
+    const MailboxStats& mailbox_stats = snapshot.mailbox;
+    const PriorityLaneStats& priority_stats = snapshot.priority;
+
+    metrics.histogram("splitflap_loop_period_seconds", "Time between successive passes of the module update loop",
+        splitflap_metrics.loop_period);
+    metrics.histogram("splitflap_io_transfer_seconds", "Time taken by each motor and sensor shift register (SPI) transfer",
+        splitflap_metrics.io_transfer);
+
+    metrics.family("splitflap_command_mailbox_depth", "gauge", "Command mailbox slots pending")
+        .sample(mailbox_stats.depth);
+    metrics.family("splitflap_command_mailbox_max_depth", "gauge", "Most command mailbox slots pending at once")
+        .sample(mailbox_stats.max_depth);
+    metrics.family("splitflap_command_mailbox_max_batch", "gauge", "Most command mailbox slots handled in one pass")
+        .sample(mailbox_stats.max_batch);
+    metrics.family("splitflap_commands_submitted_total", "counter", "Command mailbox slot updates accepted")
+        .sample(mailbox_stats.submitted);
+    metrics.family("splitflap_commands_coalesced_total", "counter", "Command mailbox slot updates merged into a pending one")
+        .sample(mailbox_stats.coalesced);
+    metrics.family("splitflap_commands_rejected_total", "counter", "Commands rejected as invalid")
+        .sample(mailbox_stats.rejected);
+    metrics.family("splitflap_command_drains_total", "counter", "Module update passes that found pending commands")
+        .sample(mailbox_stats.drains);
+    metrics.family("splitflap_priority_requests_total", "counter", "Pause, resume and emergency stop requests handled")
+        .sample(priority_stats.requests_handled);
+    metrics.family("splitflap_priority_latency_max_seconds", "gauge", "Longest time taken to handle a pause, resume or emergency stop")
+        .sampleSeconds(priority_stats.max_latency_micros);
+
+    metrics.family("splitflap_modules", "gauge", "Number of connected modules")
+        .sample(state.num_modules);
+    metrics.family("splitflap_module_moves_total", "counter", "Times each module has started moving");
+    for (uint8_t i = 0; i < state.num_modules; i++) {
+        metrics.sample("module", i, splitflap_metrics.module_moves[i]);
+    }
+    metrics.family("splitflap_module_steps_total", "counter", "Motor steps taken by each module");
+    for (uint8_t i = 0; i < state.num_modules; i++) {
+        metrics.sample("module", i, splitflap_metrics.module_steps[i]);
+    }
+    metrics.family("splitflap_module_missed_home_total", "counter", "Times each module missed the home sensor (reset with the module)");
+    for (uint8_t i = 0; i < state.num_modules; i++) {
+        metrics.sample("module", i, state.counters[i].count_missed_home);
+    }
+    metrics.family("splitflap_module_unexpected_home_total", "counter", "Times each module found the home sensor unexpectedly (reset with the module)");
+    for (uint8_t i = 0; i < state.num_modules; i++) {
+        metrics.sample("module", i, state.counters[i].count_unexpected_home);
+    }
+}
+
+void WebServerTask::writeSystemMetrics(PrometheusWriter& metrics, const MetricsSnapshot& snapshot) {
+    metrics.family("splitflap_uptime_seconds", "gauge", "Time since boot")
+        .sample(snapshot.uptime_seconds);
+    metrics.family("splitflap_heap_free_bytes", "gauge", "Free heap")
+        .sample(snapshot.heap_free);
+    metrics.family("splitflap_heap_min_free_bytes", "gauge", "Lowest free heap since boot")
+        .sample(snapshot.heap_min_free);
+    metrics.family("splitflap_heap_max_alloc_bytes", "gauge", "Largest block that can currently be allocated")
+        .sample(snapshot.heap_max_alloc);
+
+    const NetworkStats& network = snapshot.network;
+    metrics.family("splitflap_wifi_connected", "gauge", "Whether WiFi is connected")
+        .sample(network.connected);
+    if (network.connected) {
+        metrics.family("splitflap_wifi_rssi_dbm", "gauge", "WiFi signal strength")
+            .sample(snapshot.wifi_rssi);
+    }
+    metrics.family("splitflap_wifi_connect_attempts_total", "counter", "WiFi connection attempts")
+        .sample(network.connect_attempts);
+    metrics.family("splitflap_wifi_connects_total", "counter", "Successful WiFi connections")
+        .sample(network.connects);
+    metrics.family("splitflap_wifi_disconnects_total", "counter", "WiFi connections lost")
+        .sample(network.disconnects);
+    metrics.family("splitflap_time_synced", "gauge", "Whether the clock has been set by SNTP")
+        .sample(network.time_synced);
+
+    metrics.family("splitflap_task_stack_min_free_bytes", "gauge", "Lowest free stack space since each task started")
+        .sample("task", "splitflap", snapshot.stack_min_free[0])
+        .sample("task", "serial", snapshot.stack_min_free[1])
+        .sample("task", "web_server", snapshot.stack_min_free[2])
+        .sample("task", "network", snapshot.stack_min_free[3])
+        .sample("task", "async_tcp", snapshot.stack_min_free[4]);
+
+#ifdef CHAINLINK_BASE
+    const PB_SupervisorState& supervisor = snapshot.supervisor;
+    metrics.family("splitflap_supervisor_state", "gauge", "Supervisor state (a SupervisorState.State value)")
+        .sample(supervisor.state);
+    metrics.family("splitflap_supervisor_channel_voltage_volts", "gauge", "Power channel voltage");
+    for (uint8_t i = 0; i < supervisor.power_channels_count; i++) {
+        metrics.sample("channel", i, supervisor.power_channels[i].voltage_volts);
+    }
+    metrics.family("splitflap_supervisor_channel_current_amps", "gauge", "Power channel current");
+    for (uint8_t i = 0; i < supervisor.power_channels_count; i++) {
+        metrics.sample("channel", i, supervisor.power_channels[i].current_amps);
+    }
+    metrics.family("splitflap_supervisor_channel_on", "gauge", "Whether each power channel is switched on");
+    for (uint8_t i = 0; i < supervisor.power_channels_count; i++) {
+        metrics.sample("channel", i, supervisor.power_channels[i].on);
+    }
+#endif
+}
+
+void WebServerTask::addToHistory(const char* text, size_t length) {
+    if (length == 0) return;
+    history_.add(text, length);
+    // Have the web server task schedule saving it
+    xTaskNotifyGive(getHandle());
 }
-
-void WebServerTask::addToHistory(const String& text) {
-    if (text.length() == 0) return;
-    
-    // Shift existing history down
-    for (int i = MAX_HISTORY - 1; i > 0; i--) {
-        history_[i] = history_[i - 1];
-    }
-    
-    // Add new text at the beginning
-    history_[0] = text;
-    
-    // Update count (max 10)
-    if (history_count_ < MAX_HISTORY) {
-        history_count_++;
-    }
-}
\ No newline at end of file
@@ -17,45 +17,129 @@
 
 #include <Arduino.h>
 #include <WiFi.h>
-#include <WebServer.h>
+#include <ESPAsyncWebServer.h>
 #include <ArduinoJson.h>
+#include <atomic>
+#include <memory>
 
+#include "../core/json_writer.h"
 #include "../core/logger.h"
+#include "../core/network_task.h"
+#include "../core/prometheus_writer.h"
 #include "../core/splitflap_task.h"
 #include "../core/task.h"
 
+#include "serial_task.h"
+#include "text_admission.h"
+#include "text_history.h"
+#include "web_assets.h"
+
 class WebServerTask : public Task<WebServerTask> {
     friend class Task<WebServerTask>; // Allow base Task to invoke protected run()
 
     public:
-        WebServerTask(SplitflapTask& splitflap_task, Logger& logger, const uint8_t task_core, const uint16_t port = 80);
+        WebServerTask(SplitflapTask& splitflap_task, SerialTask& serial_task, NetworkTask& network_task, const uint8_t task_core, const uint16_t port = 80);
 
     protected:
         void run();
 
     private:
+        // Request bodies larger than this are rejected rather than buffered
+        static const size_t MAX_BODY_SIZE = 1024;
+
+        // Live state events are sent at most this often (changes in between are merged), and module updates are
+        // split into events of at most MODULES_PER_EVENT modules
+        static const uint32_t MIN_EVENT_INTERVAL_MILLIS = 100;
+        static const uint8_t MODULES_PER_EVENT = 8;
+        static const size_t EVENT_BUFFER_SIZE = 2048;
+
+        // Number of /history entries returned by default, and at most
+        static const uint32_t DEFAULT_HISTORY_PAGE = 10;
+        static const uint32_t MAX_HISTORY_PAGE = 50;
+
+        // Typical sizes of buffered JSON responses, so their buffers start out big enough rather than growing
+        static const size_t HISTORY_ENTRY_JSON_SIZE = NUM_MODULES + 48;
+        static const size_t ADMIN_STATUS_JSON_SIZE = 512;
+
+        // Everything /metrics reports, read when the request arrives so the response can be streamed from it
+        struct MetricsSnapshot {
+            SplitflapMetrics splitflap;
+            SplitflapState state;
+            MailboxStats mailbox;
+            PriorityLaneStats priority;
+            SerialProtoProtocol::Stats serial;
+            MicrosHistogram request_duration;
+            TextAdmissionStats text;
+            uint32_t uptime_seconds;
+            uint32_t heap_free;
+            uint32_t heap_min_free;
+            uint32_t heap_max_alloc;
+            NetworkStats network;
+            int32_t wifi_rssi;
+            // Lowest free stack space of the splitflap, serial, web server, network and AsyncTCP tasks
+            uint32_t stack_min_free[5];
+#ifdef CHAINLINK_BASE
+            PB_SupervisorState supervisor;
+#endif
+        };
+
+        typedef std::function<void(AsyncWebServerRequest* request, JsonDocument& doc)> JsonRequestHandler;
+        typedef std::function<void(JsonWriter& json)> JsonContent;
+        typedef std::function<void(Print& out)> ChunkedContent;
+
         void setupWebServer();
-        String getAlphabetString();
-        String getStatusJSON();
-        String getHistoryJSON();
-        String getAdminStatusJSON();
-        void addToHistory(const String& text);
-        bool checkAuthentication();
-        bool checkAdminAuthentication();
+        // Wraps a request handler to record how long it takes
+        ArRequestHandlerFunction timed(ArRequestHandlerFunction handler);
+        // Registers a POST route whose JSON body is collected as it arrives and parsed once it's complete; the
+        // handler is only called (after authentication) with a valid document
+        void onJsonPost(const char* uri, bool admin, JsonRequestHandler handler);
+        static void bufferBody(AsyncWebServerRequest* request, uint8_t* data, size_t len, size_t index, size_t total);
+        bool parseJsonBody(AsyncWebServerRequest* request, JsonDocument& doc);
+        void sendJSON(AsyncWebServerRequest* request, size_t size_hint, JsonContent content);
+        static void sendChunked(AsyncWebServerRequest* request, const char* content_type, ChunkedContent content);
+        void serveAsset(AsyncWebServerRequest* request, const WebAsset& asset);
+        void pushStateEvents(const SplitflapState& state, const StateChanges& changes, bool snapshot);
+        void sendModuleEvents(const SplitflapState& state, const StateChanges& changes, bool snapshot);
+        void sendModuleBatch(const SplitflapState& state, const uint8_t* modules, uint8_t count);
+        void sendEvent(BufferPrint& event_data, const char* event);
+        static void writeModuleJSON(JsonWriter& json, const SplitflapState& state, uint8_t i);
+        static void writeDisplayedText(JsonWriter& json, const SplitflapState& state);
+        static void writeStatusJSON(JsonWriter& json, const SplitflapState& state);
+        void writeHistoryJSON(JsonWriter& json, uint32_t since, uint32_t before, uint32_t limit);
+        void writeAdminStatusJSON(JsonWriter& json);
+        void takeMetricsSnapshot(MetricsSnapshot& snapshot);
+        static void writeMetrics(PrometheusWriter& metrics, const MetricsSnapshot& snapshot);
+        static void writeSplitflapMetrics(PrometheusWriter& metrics, const MetricsSnapshot& snapshot);
+        static void writeSystemMetrics(PrometheusWriter& metrics, const MetricsSnapshot& snapshot);
+        void addToHistory(const char* text, size_t length);
+        bool checkAuthentication(AsyncWebServerRequest* request);
+        bool checkAdminAuthentication(AsyncWebServerRequest* request);
 
         SplitflapTask& splitflap_task_;
+        SerialTask& serial_task_;
+        NetworkTask& network_task_;
         Logger& logger_;
-        WebServer server_;
+        AsyncWebServer server_;
         bool server_started_ = false;
+
+        // Request handling time; only used by handlers, which all run on the AsyncTCP task
+        MicrosHistogram request_duration_ = {};
+
+        // Rate limiting and coalescing of /text messages
+        TextAdmission text_admission_;
+
+        // Live state (per-module changes, settled messages and module errors) pushed to clients as Server-Sent Events
+        AsyncEventSource events_;
+        // Set when a client connects, so the next push includes a full snapshot
+        std::atomic<bool> events_snapshot_requested_ = {};
+        // Set when an event couldn't be queued for every client, so they're sent a snapshot once caught up
+        bool events_resync_ = false;
+        SplitflapState last_pushed_state_ = {};
+        char event_buffer_[EVENT_BUFFER_SIZE];
+        uint32_t last_push_millis_ = 0;
         
-        // History storage
-        static const int MAX_HISTORY = 10;
-        String history_[MAX_HISTORY];
-        int history_count_ = 0;
+        TextHistory history_;
         
         // Display state
         bool display_enabled_ = true;
-        
-        // Embedded frontend files
-        static const char HTML_CONTENT[];
 };
@@ -14,7 +14,6 @@
    limitations under the License.
 */
 #include <esp_task_wdt.h>
-#include <lwip/apps/sntp.h>
 
 #include <WiFi.h>
 #include <HTTPClient.h>
@@ -46,6 +45,7 @@ using namespace json11;
 TesterTask::TesterTask(SplitflapTask& splitflap_task, const uint8_t task_core) :
         Task{"Tester", 16000, 1, task_core},
         splitflap_task_{splitflap_task},
+        network_task_{WIFI_SSID, WIFI_PASSWORD, task_core},
         jwt_("https://firestore.googleapis.com/", service_key_id, service_email, service_private_key, service_private_key_len),
         firestore_(project_id, jwt_),
         firestore_test_reporter_(firestore_) {
@@ -389,8 +389,8 @@ Result TesterTask::testHoming() {
         String description = "Homing...\n";
         for (uint8_t i = 0; i < TEST_MODULES; i++) {
             bool module_ready = splitflap_state.modules[i].state == NORMAL
-                    && splitflap_state.modules[i].count_missed_home == 0
-                    && splitflap_state.modules[i].count_unexpected_home == 0
+                    && splitflap_state.counters[i].count_missed_home == 0
+                    && splitflap_state.counters[i].count_unexpected_home == 0
                     && splitflap_state.modules[i].moving == false;
             ready &= module_ready;
             description += String(i) + ": ";
@@ -418,18 +418,18 @@ Result TesterTask::testHoming() {
             if (!any_moving) {
                 String failure = "Some modules failed home calibration:\n";
                 for (uint8_t i = 0; i < TEST_MODULES; i++) {
-                    if (splitflap_state.modules[i].state != NORMAL || splitflap_state.modules[i].count_missed_home != 0 || splitflap_state.modules[i].count_unexpected_home != 0) {
+                    if (splitflap_state.modules[i].state != NORMAL || splitflap_state.counters[i].count_missed_home != 0 || splitflap_state.counters[i].count_unexpected_home != 0) {
                         failure.concat("Module ");
                         failure.concat(i);
                         if (splitflap_state.modules[i].state != NORMAL) {
                             failure.concat(" is in incorrect state ");
                             failure.concat(splitflap_state.modules[i].state);
                         }
-                        if (splitflap_state.modules[i].count_missed_home != 0 || splitflap_state.modules[i].count_unexpected_home != 0) {
+                        if (splitflap_state.counters[i].count_missed_home != 0 || splitflap_state.counters[i].count_unexpected_home != 0) {
                             failure.concat(" has errors: missed_home=");
-                            failure.concat(splitflap_state.modules[i].count_missed_home);
+                            failure.concat(splitflap_state.counters[i].count_missed_home);
                             failure.concat(" unexpected_home=");
-                            failure.concat(splitflap_state.modules[i].count_unexpected_home);
+                            failure.concat(splitflap_state.counters[i].count_unexpected_home);
                         }
                         failure.concat("\n");
                     }
@@ -468,8 +468,8 @@ Result TesterTask::testMovements() {
             bool ready = true;
             for (uint8_t i = 0; i < TEST_MODULES; i++) {
                 ready &= splitflap_state.modules[i].state == NORMAL
-                        && splitflap_state.modules[i].count_missed_home == 0
-                        && splitflap_state.modules[i].count_unexpected_home == 0
+                        && splitflap_state.counters[i].count_missed_home == 0
+                        && splitflap_state.counters[i].count_unexpected_home == 0
                         && splitflap_state.modules[i].moving == false;
             }
 
@@ -488,18 +488,18 @@ Result TesterTask::testMovements() {
                 if (!any_moving) {
                     String failure = "Some modules failed movement on iteration " + String(movement) + ":\n";
                     for (uint8_t i = 0; i < TEST_MODULES; i++) {
-                        if (splitflap_state.modules[i].state != NORMAL || splitflap_state.modules[i].count_missed_home != 0 || splitflap_state.modules[i].count_unexpected_home != 0) {
+                        if (splitflap_state.modules[i].state != NORMAL || splitflap_state.counters[i].count_missed_home != 0 || splitflap_state.counters[i].count_unexpected_home != 0) {
                             failure.concat("Module ");
                             failure.concat(i);
                             if (splitflap_state.modules[i].state != NORMAL) {
                                 failure.concat(" is in incorrect state ");
                                 failure.concat(splitflap_state.modules[i].state);
                             }
-                            if (splitflap_state.modules[i].count_missed_home != 0 || splitflap_state.modules[i].count_unexpected_home != 0) {
+                            if (splitflap_state.counters[i].count_missed_home != 0 || splitflap_state.counters[i].count_unexpected_home != 0) {
                                 failure.concat(" has errors: missed_home=");
-                                failure.concat(splitflap_state.modules[i].count_missed_home);
+                                failure.concat(splitflap_state.counters[i].count_missed_home);
                                 failure.concat(" unexpected_home=");
-                                failure.concat(splitflap_state.modules[i].count_unexpected_home);
+                                failure.concat(splitflap_state.counters[i].count_unexpected_home);
                             }
                             failure.concat("\n");
                         }
@@ -545,11 +545,8 @@ Status TesterTask::runStartupSelfTest() {
     }
 }
 
-void TesterTask::connectWifi() {
-    WiFi.mode(WIFI_STA);
-    WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
-
-    while (WiFi.status() != WL_CONNECTED) {
+void TesterTask::waitForWifi() {
+    while (!network_task_.waitForConnection(pdMS_TO_TICKS(1000))) {
         esp_err_t result = esp_task_wdt_reset();
         ESP_ERROR_CHECK(result);
 
@@ -563,19 +560,11 @@ void TesterTask::connectWifi() {
             }
         }
         drawSimpleText(TFT_WHITE, TFT_ORANGE, "Starting", waitString);
-
-        delay(1000);
     }
 }
 
-void TesterTask::syncTime() {
-    sntp_setoperatingmode(SNTP_OPMODE_POLL);
-
-    char server[] = "time.nist.gov"; // sntp_setservername takes a non-const char*, so use a non-const variable to avoid warning
-    sntp_setservername(0, server);
-    sntp_init();
-    time_t now = 0;
-    while(time(&now), now < 1625099485) {
+void TesterTask::waitForTimeSync() {
+    while (!network_task_.waitForTimeSync(pdMS_TO_TICKS(1000))) {
         esp_err_t result = esp_task_wdt_reset();
         ESP_ERROR_CHECK(result);
 
@@ -589,9 +578,9 @@ void TesterTask::syncTime() {
             }
         }
         drawSimpleText(TFT_WHITE, TFT_ORANGE, "Starting", waitString);
-        delay(1000);
     }
 
+    time_t now = time(nullptr);
     char buf[20];
     strftime(buf, 20, "%Y-%m-%d %H:%M:%S", localtime(&now));
     Serial.printf("Got time: %s\n", buf);
@@ -601,6 +590,9 @@ void TesterTask::run() {
     esp_err_t result = esp_task_wdt_add(NULL);
     ESP_ERROR_CHECK(result);
 
+    // Connects in the background while the hardware is set up
+    network_task_.begin();
+
     initializeIo();
     initializeMcp();
     ina219_.setCalibrationSplitflap();
@@ -689,8 +681,8 @@ Result TesterTask::runTestSuite() {
 }
 
 Status TesterTask::runTestSuitesForever() {
-    connectWifi();
-    syncTime();
+    waitForWifi();
+    waitForTimeSync();
     
     drawSimpleText(TFT_WHITE, TFT_ORANGE, "Starting", "Checking Firestore access...");
     esp_err_t result = esp_task_wdt_delete(NULL);
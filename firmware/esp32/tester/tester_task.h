@@ -23,6 +23,7 @@
 #include "Adafruit_INA219.h"
 
 #include "result.h"
+#include "../core/network_task.h"
 #include "../core/splitflap_task.h"
 #include "../core/task.h"
 #include "firestore_test_reporter.h"
@@ -65,6 +66,7 @@ class TesterTask : public Task<TesterTask> {
 
     private:
         SplitflapTask& splitflap_task_;
+        NetworkTask network_task_;
         Adafruit_MCP23017 mcp_;
         Adafruit_INA219 ina219_;
 
@@ -88,8 +90,8 @@ class TesterTask : public Task<TesterTask> {
         void initializeMcp();
         void initializeDisplay();
 
-        void connectWifi();
-        void syncTime();
+        void waitForWifi();
+        void waitForTimeSync();
 
         void disableHardware();
         void drawSimpleText(uint32_t background, uint32_t foreground, String title, String details, String bottom_button_label);
@@ -0,0 +1,41 @@
+// Just enough of the Arduino core for the firmware code built by the host tests
+#pragma once
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+template <typename T>
+T min(T a, T b) {
+    return a < b ? a : b;
+}
+
+class Print {
+    public:
+        virtual ~Print() {}
+        virtual size_t write(uint8_t b) {
+            return write(&b, 1);
+        }
+        virtual size_t write(const uint8_t* buffer, size_t size) = 0;
+
+        size_t print(const char* str) {
+            return write((const uint8_t*)str, strlen(str));
+        }
+        size_t print(long number) {
+            char buf[24];
+            snprintf(buf, sizeof(buf), "%ld", number);
+            return print(buf);
+        }
+        size_t print(unsigned long number) {
+            char buf[24];
+            snprintf(buf, sizeof(buf), "%lu", number);
+            return print(buf);
+        }
+        size_t print(double number, int digits = 2) {
+            char buf[48];
+            snprintf(buf, sizeof(buf), "%.*f", digits, number);
+            return print(buf);
+        }
+};
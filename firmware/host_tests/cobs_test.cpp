@@ -0,0 +1,325 @@
+/*
+   Copyright 2024 Scott Bezek and the splitflap contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+// Checks CobsWriter and cobsDecodeInPlace() byte for byte against PacketSerial's COBS implementation, then compares
+// the framing cost (time and RAM) of a 108-module command with the PacketSerial-style framing they replaced.
+
+#include <chrono>
+#include <functional>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+#ifdef HAVE_PACKETSERIAL
+#include <Encoding/COBS.h>
+#else
+#include "packetserial_cobs.h"
+#endif
+
+#include "../esp32/splitflap/cobs.h"
+#include "../esp32/splitflap/crc32.h"
+
+// From proto_gen/splitflap.pb.h (which needs nanopb to include)
+static const size_t PB_TO_SPLITFLAP_SIZE = 2814;
+static const size_t PB_FROM_SPLITFLAP_SIZE = 5113;
+
+class CapturePrint : public Print {
+    public:
+        std::vector<uint8_t> data;
+
+        size_t write(const uint8_t* buffer, size_t size) override {
+            data.insert(data.end(), buffer, buffer + size);
+            return size;
+        }
+};
+
+class NullPrint : public Print {
+    public:
+        size_t bytes = 0;
+
+        using Print::write;
+        size_t write(const uint8_t*, size_t size) override {
+            bytes += size;
+            return size;
+        }
+};
+
+static std::vector<uint8_t> randomPacket() {
+    // Vary how often zeros turn up, including none at all (so maximum-length blocks get split)
+    size_t size = 1 + rand() % 3000;
+    int zero_one_in = (int[]){1, 2, 50, 0}[rand() % 4];
+    std::vector<uint8_t> packet(size);
+    for (uint8_t& b : packet) {
+        b = zero_one_in != 0 && rand() % zero_one_in == 0 ? 0 : 1 + rand() % 255;
+    }
+    return packet;
+}
+
+static bool crossCheck() {
+    const int RUNS = 20000;
+    srand(1);
+    CapturePrint capture;
+    CobsWriter writer(capture);
+    for (int run = 0; run < RUNS; run++) {
+        std::vector<uint8_t> packet = randomPacket();
+
+        // Encode in random pieces, as the firmware does (e.g. the payload and then its CRC)
+        capture.data.clear();
+        for (size_t offset = 0; offset < packet.size();) {
+            size_t piece = std::min(packet.size() - offset, (size_t)(1 + rand() % 600));
+            writer.write(&packet[offset], piece);
+            offset += piece;
+        }
+        writer.end();
+
+        std::vector<uint8_t> expected(COBS::getEncodedBufferSize(packet.size()) + 1);
+        expected.resize(COBS::encode(packet.data(), packet.size(), expected.data()));
+        expected.push_back(0);
+        if (capture.data != expected) {
+            printf("FAIL: run %d (%zu bytes): CobsWriter output differs from PacketSerial's\n", run, packet.size());
+            return false;
+        }
+        if (capture.data.size() > CobsWriter::maxEncodedSize(packet.size())) {
+            printf("FAIL: run %d (%zu bytes): encoded to %zu bytes, more than maxEncodedSize()\n", run, packet.size(),
+                capture.data.size());
+            return false;
+        }
+
+        // Decode without the delimiter, both ways
+        std::vector<uint8_t> encoded(capture.data.begin(), capture.data.end() - 1);
+        std::vector<uint8_t> expected_decoded(encoded.size());
+        expected_decoded.resize(COBS::decode(encoded.data(), encoded.size(), expected_decoded.data()));
+        size_t decoded_size = cobsDecodeInPlace(encoded.data(), encoded.size());
+        encoded.resize(decoded_size);
+        if (encoded != packet || encoded != expected_decoded) {
+            printf("FAIL: run %d (%zu bytes): decoded to %zu bytes, differing from the original\n", run, packet.size(),
+                decoded_size);
+            return false;
+        }
+
+        // A truncated packet's last block claims more bytes than are left, so it must be rejected rather than read
+        // past the end
+        std::vector<uint8_t> truncated(capture.data.begin(), capture.data.end() - 2);
+        size_t last_code = 0;
+        for (size_t i = 0; i < truncated.size(); i += truncated[i]) {
+            last_code = i;
+        }
+        if (truncated.size() - last_code < capture.data[last_code] && cobsDecodeInPlace(truncated.data(), truncated.size()) != 0) {
+            printf("FAIL: run %d (%zu bytes): truncated packet wasn't rejected\n", run, packet.size());
+            return false;
+        }
+    }
+    printf("Cross-check: %d random packets encode and decode byte for byte as PacketSerial's COBS does\n", RUNS);
+    return true;
+}
+
+// ToSplitflap { nonce, splitflap_command { modules: [{action: GO_TO_FLAP, param}...] } } for 108 modules, plus CRC32,
+// encoded by hand since the host tests don't build nanopb
+static std::vector<uint8_t> commandPacket() {
+    const int NUM_MODULES = 108;
+    std::vector<uint8_t> command;
+    for (int i = 0; i < NUM_MODULES; i++) {
+        uint8_t param = i % 40;
+        command.push_back(0x12); // modules, length-delimited
+        if (param == 0) {
+            command.insert(command.end(), {2, 0x08, 1});
+        } else {
+            command.insert(command.end(), {4, 0x08, 1, 0x10, param});
+        }
+    }
+    std::vector<uint8_t> packet = {0x08, 0xE9, 0x07, 0x12}; // nonce 1001, then splitflap_command
+    for (size_t size = command.size(); ; size >>= 7) {
+        packet.push_back((size & 0x7F) | (size >= 0x80 ? 0x80 : 0));
+        if (size < 0x80) {
+            break;
+        }
+    }
+    packet.insert(packet.end(), command.begin(), command.end());
+    uint32_t crc = 0;
+    crc32(packet.data(), packet.size(), &crc);
+    for (int i = 0; i < 4; i++) {
+        packet.push_back(crc >> (8 * i));
+    }
+    return packet;
+}
+
+static bool checkCrc(const uint8_t* packet, size_t size) {
+    if (size <= 4) {
+        return false;
+    }
+    uint32_t crc = 0;
+    crc32(packet, size - 4, &crc);
+    return memcmp(&crc, packet + size - 4, 4) == 0;
+}
+
+// Receive buffers, sized as in the firmware: PacketSerial_<COBS, 0, (PB_ToSplitflap_size + 4) * 2 + 10> before, and
+// SerialProtoProtocol::rx_buffer_ now
+static uint8_t packet_serial_rx_buffer[(PB_TO_SPLITFLAP_SIZE + 4) * 2 + 10];
+static size_t packet_serial_rx_size;
+static uint8_t rx_buffer[PB_TO_SPLITFLAP_SIZE + 4 + (PB_TO_SPLITFLAP_SIZE + 4) / 254 + 1];
+static size_t rx_size;
+
+// Max FromSplitflap message plus CRC32, shared by both transmit paths
+static uint8_t tx_buffer[PB_FROM_SPLITFLAP_SIZE + 4];
+
+static NullPrint sink;
+static CobsWriter cobs_writer(sink);
+
+// PacketSerial::update(): collect the encoded packet, then decode it into a second buffer on the stack
+__attribute__((noinline)) static bool receivePacketSerial(const std::vector<uint8_t>& frame) {
+    bool ok = false;
+    for (uint8_t b : frame) {
+        if (b != 0) {
+            if (packet_serial_rx_size < sizeof(packet_serial_rx_buffer)) {
+                packet_serial_rx_buffer[packet_serial_rx_size++] = b;
+            }
+            continue;
+        }
+        uint8_t decode_buffer[packet_serial_rx_size];
+        size_t size = COBS::decode(packet_serial_rx_buffer, packet_serial_rx_size, decode_buffer);
+        ok = checkCrc(decode_buffer, size);
+        packet_serial_rx_size = 0;
+    }
+    return ok;
+}
+
+// SerialProtoProtocol::loop(): collect the encoded packet, then decode it in place
+__attribute__((noinline)) static bool receiveInPlace(const std::vector<uint8_t>& frame) {
+    bool ok = false;
+    for (uint8_t b : frame) {
+        if (b != 0) {
+            if (rx_size < sizeof(rx_buffer)) {
+                rx_buffer[rx_size++] = b;
+            }
+            continue;
+        }
+        size_t size = cobsDecodeInPlace(rx_buffer, rx_size);
+        ok = checkCrc(rx_buffer, size);
+        rx_size = 0;
+    }
+    return ok;
+}
+
+// PacketSerial::send(): encode the whole packet into a buffer on the stack, then write it and the delimiter
+__attribute__((noinline)) static void sendPacketSerial(size_t size) {
+    uint8_t encode_buffer[COBS::getEncodedBufferSize(size)];
+    size_t encoded_size = COBS::encode(tx_buffer, size, encode_buffer);
+    sink.write(encode_buffer, encoded_size);
+    sink.write((uint8_t)0);
+}
+
+// SerialProtoProtocol::sendTxBuffer(): encode through CobsWriter's fixed buffer
+__attribute__((noinline)) static void sendCobsWriter(size_t size) {
+    cobs_writer.write(tx_buffer, size);
+    cobs_writer.end();
+}
+
+static void* runOnStack(void* fn) {
+    (*(std::function<void()>*)fn)();
+    return nullptr;
+}
+
+// Runs fn on a thread whose stack is filled with a marker byte beforehand, and returns how much of it was used
+static size_t stackUsed(std::function<void()> fn) {
+    const size_t STACK_SIZE = 256 * 1024;
+    const uint8_t MARKER = 0xA5;
+    void* stack;
+    if (posix_memalign(&stack, 4096, STACK_SIZE) != 0) {
+        abort();
+    }
+    memset(stack, MARKER, STACK_SIZE);
+
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setstack(&attr, stack, STACK_SIZE);
+    pthread_t thread;
+    if (pthread_create(&thread, &attr, runOnStack, &fn) != 0) {
+        abort();
+    }
+    pthread_join(thread, nullptr);
+    pthread_attr_destroy(&attr);
+
+    // The stack grows down, so everything above the lowest overwritten byte was used
+    size_t untouched = 0;
+    while (untouched < STACK_SIZE && ((uint8_t*)stack)[untouched] == MARKER) {
+        untouched++;
+    }
+    free(stack);
+    return STACK_SIZE - untouched;
+}
+
+static size_t stackUsedBeyondThread(std::function<void()> fn) {
+    static const size_t baseline = stackUsed([]() {});
+    size_t used = stackUsed(fn);
+    return used > baseline ? used - baseline : 0;
+}
+
+template <typename F>
+static double framesPerSecond(int frames, F fn) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < frames; i++) {
+        fn();
+    }
+    return frames / std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static bool benchmark() {
+    std::vector<uint8_t> packet = commandPacket();
+    std::vector<uint8_t> frame(CobsWriter::maxEncodedSize(packet.size()));
+    frame.resize(COBS::encode(packet.data(), packet.size(), frame.data()));
+    frame.push_back(0);
+    memcpy(tx_buffer, packet.data(), packet.size());
+
+    if (!receivePacketSerial(frame) || !receiveInPlace(frame)) {
+        printf("FAIL: benchmark frame didn't decode\n");
+        return false;
+    }
+
+    const int FRAMES = 200000;
+    printf("108-module command: %zu byte packet, %zu bytes framed\n", packet.size(), frame.size());
+    printf("  %-28s %12s %14s %12s\n", "", "frames/s", "buffers (B)", "stack (B)");
+    printf("  %-28s %12.0f %14zu %12zu\n", "receive, PacketSerial",
+        framesPerSecond(FRAMES, [&]() { receivePacketSerial(frame); }),
+        sizeof(packet_serial_rx_buffer),
+        stackUsedBeyondThread([&]() { receivePacketSerial(frame); }));
+    printf("  %-28s %12.0f %14zu %12zu\n", "receive, cobsDecodeInPlace",
+        framesPerSecond(FRAMES, [&]() { receiveInPlace(frame); }),
+        sizeof(rx_buffer),
+        stackUsedBeyondThread([&]() { receiveInPlace(frame); }));
+    printf("  %-28s %12.0f %14zu %12zu\n", "send, PacketSerial",
+        framesPerSecond(FRAMES, [&]() { sendPacketSerial(packet.size()); }),
+        sizeof(tx_buffer),
+        stackUsedBeyondThread([&]() { sendPacketSerial(packet.size()); }));
+    printf("  %-28s %12.0f %14zu %12zu\n", "send, CobsWriter",
+        framesPerSecond(FRAMES, [&]() { sendCobsWriter(packet.size()); }),
+        sizeof(tx_buffer) + sizeof(CobsWriter),
+        stackUsedBeyondThread([&]() { sendCobsWriter(packet.size()); }));
+
+    // The stack used to send grows with the packet for PacketSerial, up to the largest FromSplitflap message
+    printf("  %-28s %12s %14s %12zu\n", "send largest, PacketSerial", "", "",
+        stackUsedBeyondThread([]() { sendPacketSerial(sizeof(tx_buffer)); }));
+    printf("  %-28s %12s %14s %12zu\n", "send largest, CobsWriter", "", "",
+        stackUsedBeyondThread([]() { sendCobsWriter(sizeof(tx_buffer)); }));
+    return true;
+}
+
+int main() {
+    if (!crossCheck() || !benchmark()) {
+        return 1;
+    }
+    return 0;
+}
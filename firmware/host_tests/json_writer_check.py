@@ -0,0 +1,62 @@
+#!/usr/bin/env python3
+"""Parses the documents written by json_writer_test (one per line, on stdin) with Python's json module, which is
+strict about escaping, and checks they contain what they should."""
+
+import json
+import sys
+
+FLAPS = " abcdefghijklmnopqrstuvwxyz0123456789.,'\"\\"
+ALL_ASCII = ''.join(chr(c) for c in range(128))
+
+EXPECTED = [
+    {
+        'str': 'plain',
+        'char': '"',
+        'true': True,
+        'false': False,
+        'null': None,
+        'u8': 255,
+        'i8': -128,
+        'u16': 65535,
+        'i16': -32768,
+        'u32': 4294967295,
+        'i32': -2147483648,
+        'nested': {
+            'empty_object': {},
+            'empty_array': [],
+            'array': [1, 'two', [3], {'four': 4}],
+        },
+    },
+    {
+        'all': ALL_ASCII,
+        ALL_ASCII[1:]: 1,
+    },
+    {
+        'modules': [
+            {'index': i, 'flap': FLAPS[i % len(FLAPS)], 'moving': i % 3 == 0, 'count_missed_home': i * 1000}
+            for i in range(108)
+        ],
+    },
+]
+
+
+def main():
+    lines = sys.stdin.read().splitlines()
+    if len(lines) != len(EXPECTED):
+        print(f'FAIL: expected {len(EXPECTED)} documents, got {len(lines)}')
+        return 1
+    for i, (line, expected) in enumerate(zip(lines, EXPECTED)):
+        try:
+            actual = json.loads(line)
+        except ValueError as e:
+            print(f'FAIL: document {i} is not valid JSON: {e}')
+            return 1
+        if actual != expected:
+            print(f'FAIL: document {i} differs: {actual!r}')
+            return 1
+    print(f'{len(lines)} documents parsed by Python\'s json module match')
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,146 @@
+/*
+   Copyright 2024 Scott Bezek and the splitflap contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+// Writes JsonWriter documents to stdout, one per line, for json_writer_check.py to parse with Python's json module
+// and compare with what they should contain. Also checks BufferPrint and WindowPrint, which don't need parsing.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+
+#include "../esp32/core/json_writer.h"
+
+class StringPrint : public Print {
+    public:
+        std::string str;
+
+        using Print::write;
+        size_t write(const uint8_t* buffer, size_t size) override {
+            str.append((const char*)buffer, size);
+            return size;
+        }
+};
+
+static void writeTypes(Print& out) {
+    JsonWriter json(out);
+    json.beginObject()
+        .field("str", "plain")
+        .field("char", '"')
+        .field("true", true)
+        .field("false", false)
+        .key("null").nullValue()
+        .field("u8", (uint8_t)255)
+        .field("i8", (int8_t)-128)
+        .field("u16", (uint16_t)65535)
+        .field("i16", (int16_t)-32768)
+        .field("u32", (uint32_t)4294967295u)
+        .field("i32", (int32_t)-2147483647 - 1)
+        .beginObject("nested")
+            .beginObject("empty_object").endObject()
+            .beginArray("empty_array").endArray()
+            .beginArray("array")
+                .value(1)
+                .value("two")
+                .beginArray().value(3).endArray()
+                .beginObject().field("four", 4).endObject()
+            .endArray()
+        .endObject()
+        .endObject();
+}
+
+static void writeEscapes(Print& out) {
+    // Every ASCII character, including null, as a value; and all but null as a key
+    char all[128];
+    for (int i = 0; i < 128; i++) {
+        all[i] = i;
+    }
+    JsonWriter json(out);
+    json.beginObject()
+        .key("all").value(all, sizeof(all));
+    std::string key(all + 1, sizeof(all) - 1);
+    json.field(key.c_str(), 1)
+        .endObject();
+}
+
+// Shaped like /status for 108 modules
+static void writeModules(Print& out) {
+    const char FLAPS[] = " abcdefghijklmnopqrstuvwxyz0123456789.,'\"\\";
+    JsonWriter json(out);
+    json.beginObject().beginArray("modules");
+    for (uint8_t i = 0; i < 108; i++) {
+        json.beginObject()
+            .field("index", i)
+            .field("flap", FLAPS[i % (sizeof(FLAPS) - 1)])
+            .field("moving", i % 3 == 0)
+            .field("count_missed_home", (uint32_t)i * 1000)
+            .endObject();
+    }
+    json.endArray().endObject();
+}
+
+static bool checkBufferPrint() {
+    char buffer[10];
+    BufferPrint out(buffer, sizeof(buffer));
+    JsonWriter(out).beginObject().field("abc", "defghij").endObject();
+    if (!out.overflowed() || out.length() != sizeof(buffer) - 1 || strcmp(out.c_str(), "{\"abc\":\"d") != 0) {
+        fprintf(stderr, "FAIL: BufferPrint kept \"%s\" (%zu bytes, overflowed %d)\n", out.c_str(), out.length(), out.overflowed());
+        return false;
+    }
+    return true;
+}
+
+// Reassembles a document from windows of random sizes, as a chunked response does
+static bool checkWindowPrint(void (*write)(Print&)) {
+    StringPrint whole;
+    write(whole);
+    srand(1);
+    for (int run = 0; run < 100; run++) {
+        std::string chunks;
+        uint8_t buffer[1500];
+        while (true) {
+            size_t size = 1 + rand() % sizeof(buffer);
+            WindowPrint window(buffer, size, chunks.size());
+            write(window);
+            if (window.length() == 0) {
+                break;
+            }
+            if (window.length() != size && chunks.size() + window.length() != whole.str.size()) {
+                fprintf(stderr, "FAIL: WindowPrint returned a short chunk before the end\n");
+                return false;
+            }
+            chunks.append((const char*)buffer, window.length());
+        }
+        if (chunks != whole.str) {
+            fprintf(stderr, "FAIL: document reassembled from WindowPrint chunks differs\n");
+            return false;
+        }
+    }
+    return true;
+}
+
+int main() {
+    if (!checkBufferPrint() || !checkWindowPrint(writeModules)) {
+        return 1;
+    }
+
+    void (*const DOCUMENTS[])(Print&) = {writeTypes, writeEscapes, writeModules};
+    for (auto write : DOCUMENTS) {
+        StringPrint out;
+        write(out);
+        printf("%s\n", out.str.c_str());
+    }
+    return 0;
+}
@@ -177,7 +177,7 @@ const uint8_t flaps[NUM_FLAPS] = {
 #endif
 #ifdef CHAINLINK
 #if NUM_MODULES % 6 != 0
-#error NUM_MODULES must be a multiple of 6, to match the capacity of the connected Chainlink Drivers. You can use fewer than this number of modules, but the setting must match the Chainlink Driver outputs.
+#error NUM_MODULES must be a multiple of 6, to match the capacity of the connected Chainlink Drivers. For Chainlink, NUM_MODULES is the maximum supported chain length; the number of connected Chainlink Drivers is detected at startup.
 #endif
 
 #define NUM_LOOPBACKS (NUM_MODULES / 3)
@@ -104,6 +104,14 @@
 BUFFER_ATTRS uint8_t motor_buffer[MOTOR_BUFFER_LENGTH];
 BUFFER_ATTRS uint8_t sensor_buffer[SENSOR_BUFFER_LENGTH];
 
+#ifdef CHAINLINK
+// NUM_MODULES is the maximum supported chain length; the number of Chainlink Drivers actually
+// connected is detected at runtime (see chainlink_detect_num_drivers) and only that portion of
+// the chain is clocked on each transfer.
+#define MAX_CHAINLINK_DRIVERS (NUM_MODULES / 6)
+uint8_t chainlink_num_drivers = MAX_CHAINLINK_DRIVERS;
+#endif
+
 #ifdef __AVR__
 // Define placement new so we can initialize SplitflapModules at runtime into a static buffer.
 // (see https://arduino.stackexchange.com/a/1499)
@@ -295,6 +303,68 @@ static uint8_t chainlink_loopbackSensorBitMask(uint8_t loopbackIndex) {
   return (loopbackIndex % 2) == 0 ? 1 << 6 : 1 << 7;
 }
 
+static uint8_t chainlink_num_loopbacks() {
+  return chainlink_num_drivers * 2;
+}
+
+/**
+ * Limit SPI transfers to the first num_drivers Chainlink Drivers in the chain. The first driver's motor bytes are
+ * shifted out last, so the populated portion is the tail of motor_buffer; sensor bytes are read in chain order.
+ */
+void chainlink_set_num_drivers(uint8_t num_drivers) {
+  assert(num_drivers > 0 && num_drivers <= MAX_CHAINLINK_DRIVERS);
+  chainlink_num_drivers = num_drivers;
+
+  // Unused sensor bytes are never read again; clear them so those modules don't see a stale home sensor
+  memset(sensor_buffer, 0, SENSOR_BUFFER_LENGTH);
+
+#ifdef ESP32
+  tx_transaction.length = num_drivers * 4 * 8;
+  tx_transaction.tx_buffer = &motor_buffer[MOTOR_BUFFER_LENGTH - num_drivers * 4];
+
+  rx_transaction.length = num_drivers * 8;
+  rx_transaction.rxlength = num_drivers * 8;
+#endif
+}
+
+static bool chainlink_read_loopback(uint8_t loopbackIndex) {
+  return (sensor_buffer[chainlink_loopbackSensorByte(loopbackIndex)] & chainlink_loopbackSensorBitMask(loopbackIndex)) != 0;
+}
+
+/**
+ * Detect how many Chainlink Drivers are connected by walking the full-length chain and checking that both loopbacks
+ * on each driver follow their outputs (0 when off, 1 when on). Returns the number of consecutive working drivers,
+ * starting from the one nearest the controller. Leaves all outputs off and the transfer length set to the maximum.
+ */
+uint8_t chainlink_detect_num_drivers() {
+    chainlink_set_num_drivers(MAX_CHAINLINK_DRIVERS);
+    memset(motor_buffer, 0, MOTOR_BUFFER_LENGTH);
+    motor_sensor_io();
+    motor_sensor_io();
+
+    uint8_t num_drivers = 0;
+    for (uint8_t driver = 0; driver < MAX_CHAINLINK_DRIVERS; driver++) {
+      bool present = true;
+      for (uint8_t i = driver * 2; i < driver * 2 + 2; i++) {
+        present &= !chainlink_read_loopback(i);
+
+        motor_buffer[chainlink_loopbackMotorByte(i)] |= chainlink_loopbackMotorBitMask(i);
+        motor_sensor_io();
+        motor_sensor_io();
+        present &= chainlink_read_loopback(i);
+
+        motor_buffer[chainlink_loopbackMotorByte(i)] &= ~chainlink_loopbackMotorBitMask(i);
+        motor_sensor_io();
+        motor_sensor_io();
+      }
+      if (!present) {
+        break;
+      }
+      num_drivers++;
+    }
+    return num_drivers;
+}
+
 bool chainlink_test_startup_loopback(bool results[NUM_LOOPBACKS]) {
     bool success = true;
 
@@ -303,7 +373,7 @@ bool chainlink_test_startup_loopback(bool results[NUM_LOOPBACKS]) {
     motor_sensor_io();
     motor_sensor_io();
 
-    for (uint8_t i = 0; i < NUM_LOOPBACKS; i++) {
+    for (uint8_t i = 0; i < chainlink_num_loopbacks(); i++) {
       results[i] = ((sensor_buffer[chainlink_loopbackSensorByte(i)] & chainlink_loopbackSensorBitMask(i))) == 0;
       success &= results[i];
     }
@@ -322,7 +392,7 @@ void chainlink_set_loopback(uint8_t loop_out_index) {
  */
 bool chainlink_validate_loopback(uint8_t loop_out_index, bool results[NUM_LOOPBACKS]) {
     bool success = true;
-    for (uint8_t loop_in_index = 0; loop_in_index < NUM_LOOPBACKS; loop_in_index++) {
+    for (uint8_t loop_in_index = 0; loop_in_index < chainlink_num_loopbacks(); loop_in_index++) {
       uint8_t expected_bit_mask = (loop_out_index == loop_in_index) ? chainlink_loopbackSensorBitMask(loop_in_index) : 0;
       uint8_t actual_bit_mask = sensor_buffer[chainlink_loopbackSensorByte(loop_in_index)] & chainlink_loopbackSensorBitMask(loop_in_index);
 
@@ -342,7 +412,7 @@ bool chainlink_test_all_loopbacks(bool loopback_result[NUM_LOOPBACKS][NUM_LOOPBA
     bool loopback_success = true;
 
     // Turn one loopback bit on at a time and make sure only that loopback bit is set
-    for (uint8_t loop_out_index = 0; loop_out_index < NUM_LOOPBACKS; loop_out_index++) {
+    for (uint8_t loop_out_index = 0; loop_out_index < chainlink_num_loopbacks(); loop_out_index++) {
       chainlink_set_loopback(loop_out_index);
       motor_sensor_io();
       motor_sensor_io();
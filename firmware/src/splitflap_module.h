@@ -87,7 +87,7 @@ class SplitflapModule {
   uint8_t current_phase = 0;
   uint16_t current_period = Acceleration::ACCEL_STEP_PERIODS[0];
 
-  void Panic(String message);
+  void Panic(const char* message);
   bool CheckSensor();
   void SetMotor(uint8_t out);
 
@@ -121,6 +121,7 @@ class SplitflapModule {
   void Init();
   bool GetHomeState();
   void Disable();
+  void Hold();
 
   void IncreaseOffset(uint8_t flap_tenths);
   void SetOffset();
@@ -129,6 +130,14 @@ class SplitflapModule {
   
   uint8_t count_unexpected_home = 0;
   uint8_t count_missed_home = 0;
+
+#ifdef ESP32
+  // Reason for the last PANIC, for the owning task to log (printing from Update() would stall the motor loop)
+  const char* panic_message = "";
+
+  // Total steps taken, for metrics
+  uint32_t step_count = 0;
+#endif
 };
 
 
@@ -169,11 +178,25 @@ void SplitflapModule::Disable() {
   state = STATE_DISABLED;
 }
 
-void SplitflapModule::Panic(String message) {
+/**
+ * Stop immediately without changing state or target; motion restarts from standstill (with normal acceleration)
+ * on the next Update().
+ */
+void SplitflapModule::Hold() {
+  SetMotor(0);
+  current_accel_step = 0;
+  current_period = pgm_read_word_near(Acceleration::ACCEL_STEP_PERIODS);
+}
+
+void SplitflapModule::Panic(const char* message) {
   SetMotor(0);
   state = PANIC;
+#ifdef ESP32
+  panic_message = message;
+#else
   Serial.print("#### PANIC! ####\n");
   Serial.print(message);
+#endif
 }
 
 __attribute__((always_inline))
@@ -387,6 +410,9 @@ inline void SplitflapModule::Update() {
             if (current_step == STEPS_PER_REVOLUTION) {
                 current_step = 0;
             }
+#ifdef ESP32
+            step_count++;
+#endif
             current_phase++;
             if (current_phase == 4) {
                 current_phase = 0;
@@ -0,0 +1,695 @@
+// Configuration
+const API_BASE_URL = window.location.origin;
+const UPDATE_INTERVAL = 5000; // 5 seconds (only used if live events aren't available)
+const HISTORY_LENGTH = 10; // Words shown in the history sidebar
+
+// State
+let currentStatus = null;
+let currentText = [];
+let currentFocusIndex = 0;
+let numModules = 6; // Default, will be updated from server
+let history = []; // Array to store last 10 words sent
+let historyLatestSequence = 0; // Sequence number of the newest history entry loaded
+let currentDisplayedWord = '---'; // Currently displayed word on splitflap
+let moduleStates = []; // Latest state of each module, from /status and then live `modules` events
+let isAdminMode = false; // Whether user is in admin mode
+let displayEnabled = true; // Whether display is enabled
+
+// DOM Elements
+const statusIndicator = document.getElementById('statusIndicator');
+const statusText = document.getElementById('statusText');
+const displayGrid = document.getElementById('displayGrid');
+const alphabetKeyboard = document.getElementById('alphabetKeyboard');
+const sendButton = document.getElementById('sendButton');
+const clearButton = document.getElementById('clearButton');
+const forceMovementButton = document.getElementById('forceMovementButton');
+const toast = document.getElementById('toast');
+const historyToggle = document.getElementById('historyToggle');
+const historySidebar = document.getElementById('historySidebar');
+const historyClose = document.getElementById('historyClose');
+const historyList = document.getElementById('historyList');
+const currentWordEl = document.getElementById('currentWord');
+const adminLoginSection = document.getElementById('adminLoginSection');
+const adminLoginBtn = document.getElementById('adminLoginBtn');
+const adminStatus = document.getElementById('adminStatus');
+const adminSection = document.getElementById('adminSection');
+const enableBtn = document.getElementById('enableBtn');
+const disableBtn = document.getElementById('disableBtn');
+const adminLogoutBtn = document.getElementById('adminLogoutBtn');
+const disabledOverlay = document.getElementById('disabledOverlay');
+
+// API Functions
+async function fetchStatus() {
+    try {
+        const response = await fetch(`${API_BASE_URL}/status`);
+        if (!response.ok) {
+            throw new Error(`HTTP error! status: ${response.status}`);
+        }
+        return await response.json();
+    } catch (error) {
+        console.error('Error fetching status:', error);
+        throw error;
+    }
+}
+
+async function fetchHistory(since = 0) {
+    try {
+        const response = await fetch(`${API_BASE_URL}/history?since=${since}&limit=${HISTORY_LENGTH}`);
+        if (!response.ok) {
+            throw new Error(`HTTP error! status: ${response.status}`);
+        }
+        return await response.json();
+    } catch (error) {
+        console.error('Error fetching history:', error);
+        throw error;
+    }
+}
+
+async function fetchAdminStatus() {
+    try {
+        const response = await fetch(`${API_BASE_URL}/admin/status`);
+        if (!response.ok) {
+            if (response.status === 401) {
+                // User is not authenticated as admin - guest mode
+                return { admin_mode: false, guest_mode: true };
+            }
+            throw new Error(`HTTP error! status: ${response.status}`);
+        }
+        return await response.json();
+    } catch (error) {
+        console.error('Error fetching admin status:', error);
+        return { admin_mode: false, guest_mode: true };
+    }
+}
+
+async function sendAdminAction(action) {
+    try {
+        const response = await fetch(`${API_BASE_URL}/admin/control`, {
+            method: 'POST',
+            headers: {
+                'Content-Type': 'application/json',
+            },
+            body: JSON.stringify({ action: action })
+        });
+        
+        if (!response.ok) {
+            throw new Error(`HTTP error! status: ${response.status}`);
+        }
+        
+        return await response.json();
+    } catch (error) {
+        console.error('Error sending admin action:', error);
+        throw error;
+    }
+}
+
+async function sendText(text, forceMovement = false) {
+    try {
+        const response = await fetch(`${API_BASE_URL}/text`, {
+            method: 'POST',
+            headers: {
+                'Content-Type': 'application/json',
+            },
+            body: JSON.stringify({
+                message: text,
+                force_movement: forceMovement
+            })
+        });
+        
+        if (!response.ok) {
+            if (response.status === 403) {
+                // Display is disabled
+                const errorData = await response.json();
+                throw new Error(errorData.message || 'Display is disabled by admin');
+            }
+            if (response.status === 429) {
+                // Too many messages from this client
+                const retryAfter = response.headers.get('Retry-After');
+                throw new Error(`Too many messages; try again in ${retryAfter || 'a few'} seconds`);
+            }
+            throw new Error(`HTTP error! status: ${response.status}`);
+        }
+        
+        return await response.json();
+    } catch (error) {
+        console.error('Error sending text:', error);
+        throw error;
+    }
+}
+
+// History Management Functions
+async function loadHistory() {
+    try {
+        // Only fetch entries newer than the ones already loaded
+        let response = await fetchHistory(historyLatestSequence);
+        if (response.latest < historyLatestSequence) {
+            // The device's history was reset
+            history = [];
+            response = await fetchHistory(0);
+        }
+        const words = (response.history || []).map(entry => entry.text);
+        // If there were more new entries than fit, the page holds the newest ones
+        history = response.more ? words : words.concat(history).slice(0, HISTORY_LENGTH);
+        historyLatestSequence = response.latest;
+        updateHistoryDisplay();
+    } catch (error) {
+        console.error('Failed to load history:', error);
+        historyList.innerHTML = '<div class="history-item">Failed to load history</div>';
+    }
+}
+
+function updateHistoryDisplay() {
+    if (history.length === 0) {
+        historyList.innerHTML = '<div class="history-item">No history yet</div>';
+        // Update current word display
+        currentDisplayedWord = '---';
+        currentWordEl.textContent = '---';
+        return;
+    }
+    
+    historyList.innerHTML = history.map(item => 
+        `<div class="history-item">${escapeHtml(item)}</div>`
+    ).join('');
+    
+    // Update current word display with the most recent history item
+    currentDisplayedWord = history[0] || '---';
+    currentWordEl.textContent = currentDisplayedWord;
+}
+
+function escapeHtml(text) {
+    const div = document.createElement('div');
+    div.textContent = text;
+    return div.innerHTML;
+}
+
+function toggleHistorySidebar() {
+    historySidebar.classList.toggle('closed');
+}
+
+function closeHistorySidebar() {
+    historySidebar.classList.add('closed');
+}
+
+
+// Admin Functions
+async function checkAdminMode() {
+    try {
+        const adminStatusResponse = await fetchAdminStatus();
+        isAdminMode = adminStatusResponse.admin_mode || false;
+        displayEnabled = adminStatusResponse.enabled !== false;
+        
+        // Update UI based on admin status
+        if (isAdminMode) {
+            adminLoginSection.style.display = 'none';
+            adminSection.style.display = 'block';
+            adminStatus.textContent = 'Admin Mode';
+            
+            // Show admin-only sections
+            const currentStateSection = document.getElementById('currentStateSection');
+            const historySection = document.getElementById('historySection');
+            if (currentStateSection) currentStateSection.classList.add('show');
+            if (historySection) historySection.classList.add('show');
+            
+            updateAdminButtons();
+            
+            // Update disabled overlay based on display state
+            if (displayEnabled) {
+                hideDisabledOverlay();
+            } else {
+                showDisabledOverlay();
+            }
+        } else {
+            adminLoginSection.style.display = 'block';
+            adminSection.style.display = 'none';
+            adminStatus.textContent = 'Guest Mode';
+            
+            // Hide admin-only sections
+            const currentStateSection = document.getElementById('currentStateSection');
+            const historySection = document.getElementById('historySection');
+            if (currentStateSection) currentStateSection.classList.remove('show');
+            if (historySection) historySection.classList.remove('show');
+        }
+        
+        return isAdminMode;
+    } catch (error) {
+        console.error('Failed to check admin mode:', error);
+        isAdminMode = false;
+        adminLoginSection.style.display = 'block';
+        adminSection.style.display = 'none';
+        adminStatus.textContent = 'Guest Mode';
+        
+        // Hide admin-only sections on error
+        const currentStateSection = document.getElementById('currentStateSection');
+        const historySection = document.getElementById('historySection');
+        if (currentStateSection) currentStateSection.classList.remove('show');
+        if (historySection) historySection.classList.remove('show');
+        
+        return false;
+    }
+}
+
+function updateAdminButtons() {
+    if (displayEnabled) {
+        enableBtn.disabled = true;
+        disableBtn.disabled = false;
+    } else {
+        enableBtn.disabled = false;
+        disableBtn.disabled = true;
+    }
+}
+
+async function handleAdminAction(action) {
+    try {
+        const response = await sendAdminAction(action);
+        if (response.success) {
+            displayEnabled = (action === 'enable');
+            updateAdminButtons();
+            
+            // Update disabled overlay
+            if (displayEnabled) {
+                hideDisabledOverlay();
+            } else {
+                showDisabledOverlay();
+            }
+            
+            showToast(response.message, 'success');
+        } else {
+            showToast(response.message, 'error');
+        }
+    } catch (error) {
+        showToast(`Error: ${error.message}`, 'error');
+    }
+}
+
+async function loginAsAdmin() {
+    // Trigger admin authentication by trying to access admin endpoint
+    try {
+        const response = await fetch(`${API_BASE_URL}/admin/status`);
+        if (response.ok) {
+            // Successfully authenticated as admin
+            await checkAdminMode();
+            showToast('Logged in as admin', 'success');
+        } else if (response.status === 401) {
+            // Authentication required - browser will show login prompt
+            showToast('Please enter admin credentials', 'error');
+        } else {
+            showToast('Login failed', 'error');
+        }
+    } catch (error) {
+        showToast(`Login error: ${error.message}`, 'error');
+    }
+}
+
+function logoutAdmin() {
+    // Clear admin credentials and refresh
+    window.location.href = `${API_BASE_URL}/logout`;
+}
+
+function showDisabledOverlay() {
+    if (disabledOverlay) {
+        disabledOverlay.classList.add('show');
+    }
+}
+
+function hideDisabledOverlay() {
+    if (disabledOverlay) {
+        disabledOverlay.classList.remove('show');
+    }
+}
+
+// UI Functions
+function showToast(message, type = 'success') {
+    toast.textContent = message;
+    toast.className = `toast ${type}`;
+    toast.classList.add('show');
+    
+    setTimeout(() => {
+        toast.classList.remove('show');
+    }, 3000);
+}
+
+function updateStatusDisplay(status) {
+    currentStatus = status;
+    
+    if (status.connected) {
+        statusIndicator.classList.add('connected');
+        statusText.textContent = `Connected (${status.num_modules} modules)`;
+        numModules = status.num_modules;
+        sendButton.disabled = false;
+        
+        // Always create alphabet keyboard when connected
+        createAlphabetKeyboard();
+        
+        // Update history and current word from status
+        if (status.history) {
+            history = status.history;
+            updateHistoryDisplay();
+        }
+        
+        if (status.modules) {
+            moduleStates = status.modules.slice();
+        }
+        
+        if (status.current_word) {
+            currentDisplayedWord = status.current_word;
+            currentWordEl.textContent = status.current_word;
+        }
+        
+        // Handle display enabled/disabled state
+        if (status.display_enabled === false) {
+            showDisabledOverlay();
+        } else {
+            hideDisabledOverlay();
+        }
+    } else {
+        statusIndicator.classList.remove('connected');
+        statusText.textContent = `Disconnected: ${status.error || 'Unknown error'}`;
+        sendButton.disabled = true;
+        
+        // Update current word display
+        currentWordEl.textContent = '---';
+        hideDisabledOverlay();
+    }
+    
+    // Update display grid if number of modules changed
+    if (status.connected && status.num_modules !== currentText.length) {
+        initializeDisplay();
+    }
+}
+
+function initializeDisplay() {
+    // Clear existing boxes
+    displayGrid.innerHTML = '';
+    
+    // Create boxes for each module
+    currentText = new Array(numModules).fill(' ');
+    
+    for (let i = 0; i < numModules; i++) {
+        const box = document.createElement('div');
+        box.className = 'display-box';
+        box.textContent = ' ';
+        box.dataset.index = i.toString();
+        box.tabIndex = 0; // Make focusable
+        
+        // Add click handler
+        box.addEventListener('click', () => focusBox(i));
+        
+        // Add keyboard input handler
+        box.addEventListener('keydown', (e) => handleBoxKeydown(e, i));
+        
+        displayGrid.appendChild(box);
+    }
+    
+    // Focus first box
+    focusBox(0);
+}
+
+function focusBox(index) {
+    // Remove focus from all boxes
+    document.querySelectorAll('.display-box').forEach(box => {
+        box.classList.remove('focused');
+    });
+    
+    // Add focus to selected box
+    const box = document.querySelector(`[data-index="${index}"]`);
+    if (box) {
+        box.classList.add('focused');
+        box.focus();
+        currentFocusIndex = index;
+    }
+}
+
+function updateDisplayBox(index, char) {
+    const box = document.querySelector(`[data-index="${index}"]`);
+    if (box) {
+        box.textContent = char;
+        box.classList.toggle('filled', char !== ' ');
+    }
+}
+
+function handleBoxKeydown(event, index) {
+    event.preventDefault();
+    
+    const key = event.key.toLowerCase();
+    
+    // Handle special keys
+    if (key === 'backspace') {
+        if (currentText[index] !== ' ') {
+            currentText[index] = ' ';
+            updateDisplayBox(index, ' ');
+        } else if (index > 0) {
+            focusBox(index - 1);
+        }
+        return;
+    }
+    
+    if (key === 'arrowleft' && index > 0) {
+        focusBox(index - 1);
+        return;
+    }
+    
+    if (key === 'arrowright' && index < numModules - 1) {
+        focusBox(index + 1);
+        return;
+    }
+    
+    if (key === 'enter') {
+        sendCurrentText();
+        return;
+    }
+    
+    // Handle character input
+    if (currentStatus?.alphabet.includes(key.toUpperCase())) {
+        currentText[index] = key.toUpperCase();
+        updateDisplayBox(index, key.toUpperCase());
+        
+        // Move to next box if not the last one
+        if (index < numModules - 1) {
+            focusBox(index + 1);
+        }
+    }
+}
+
+function createAlphabetKeyboard() {
+    // Use server alphabet if available, otherwise use default
+    const alphabet = currentStatus?.alphabet || [' ', 'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M', 'N', 'O', 'P', 'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z', '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '.', ',', "'"];
+    
+    console.log('Creating alphabet keyboard with:', alphabet);
+    alphabetKeyboard.innerHTML = '';
+    
+    alphabet.forEach(char => {
+        const key = document.createElement('div');
+        key.className = 'key';
+        key.textContent = char;
+        
+        if (char === ' ') {
+            key.classList.add('space');
+            key.textContent = 'SPACE';
+        }
+        
+        key.addEventListener('click', () => {
+            console.log('Clicked key:', char);
+            if (currentText[currentFocusIndex] !== ' ') {
+                key.classList.add('used');
+            }
+            
+            currentText[currentFocusIndex] = char;
+            updateDisplayBox(currentFocusIndex, char);
+            
+            // Move to next box if not the last one
+            if (currentFocusIndex < numModules - 1) {
+                focusBox(currentFocusIndex + 1);
+            }
+        });
+        
+        alphabetKeyboard.appendChild(key);
+    });
+    
+    console.log('Alphabet keyboard created with', alphabet.length, 'keys');
+}
+
+function sendCurrentText() {
+    if (!currentStatus?.connected) {
+        showToast('Not connected to splitflap display', 'error');
+        return;
+    }
+    
+    const text = currentText.join('');
+    sendText(text)
+        .then(response => {
+            if (response.success) {
+                showToast(`Sent "${text}"`, 'success');
+                // Reload history from device (this will update current word display)
+                loadHistory();
+            } else {
+                showToast(response.message, 'error');
+            }
+        })
+        .catch(error => {
+            showToast(`Error: ${error.message}`, 'error');
+        });
+}
+
+function sendCurrentTextWithForceMovement() {
+    if (!currentStatus?.connected) {
+        showToast('Not connected to splitflap display', 'error');
+        return;
+    }
+    
+    const text = currentText.join('');
+    sendText(text, true)
+        .then(response => {
+            if (response.success) {
+                showToast(`Sent "${text}" (force movement)`, 'success');
+                // Reload history from device (this will update current word display)
+                loadHistory();
+            } else {
+                showToast(response.message, 'error');
+            }
+        })
+        .catch(error => {
+            showToast(`Error: ${error.message}`, 'error');
+        });
+}
+
+function clearDisplay() {
+    currentText = new Array(numModules).fill(' ');
+    
+    for (let i = 0; i < numModules; i++) {
+        updateDisplayBox(i, ' ');
+    }
+    
+    focusBox(0);
+    
+    // Reset keyboard key states
+    document.querySelectorAll('.key').forEach(key => {
+        key.classList.remove('used');
+    });
+}
+
+// Event Listeners
+sendButton.addEventListener('click', sendCurrentText);
+clearButton.addEventListener('click', clearDisplay);
+forceMovementButton.addEventListener('click', sendCurrentTextWithForceMovement);
+
+// History sidebar event listeners
+historyToggle.addEventListener('click', toggleHistorySidebar);
+historyClose.addEventListener('click', closeHistorySidebar);
+
+// Admin control event listeners
+enableBtn.addEventListener('click', () => handleAdminAction('enable'));
+disableBtn.addEventListener('click', () => handleAdminAction('disable'));
+adminLoginBtn.addEventListener('click', loginAsAdmin);
+adminLogoutBtn.addEventListener('click', logoutAdmin);
+
+// Global keyboard shortcuts
+document.addEventListener('keydown', (e) => {
+    if (e.ctrlKey || e.metaKey) {
+        switch (e.key) {
+            case 'Enter':
+                e.preventDefault();
+                sendCurrentText();
+                break;
+            case 'Backspace':
+                e.preventDefault();
+                clearDisplay();
+                break;
+        }
+    }
+});
+
+// Status update loop
+async function updateStatus() {
+    try {
+        console.log('Fetching status...');
+        const status = await fetchStatus();
+        console.log('Status received:', status);
+        updateStatusDisplay(status);
+    } catch (error) {
+        console.error('Failed to fetch status:', error);
+        statusText.textContent = 'Connection error';
+        statusIndicator.classList.remove('connected');
+        sendButton.disabled = true;
+    }
+}
+
+// Apply module changes, showing the flaps as they turn until the `settled` event gives the final text
+function updateModules(modules) {
+    for (const module of modules) {
+        moduleStates[module.index] = module;
+    }
+    if (moduleStates.some((module) => module && module.moving)) {
+        currentWordEl.textContent = moduleStates.map((module) => (module ? module.flap : ' ')).join('');
+    }
+}
+
+// Live events: the device pushes state changes, so there's no need to poll while connected
+function connectEvents() {
+    const events = new EventSource(`${API_BASE_URL}/events`);
+    
+    // Sent when connecting (including reconnecting) and whenever the module count or mode changes
+    events.addEventListener('state', () => {
+        updateStatus();
+    });
+    
+    // Only the modules that changed, except after (re)connecting or falling behind, when all of them are sent
+    events.addEventListener('modules', (event) => {
+        updateModules(JSON.parse(event.data).modules);
+    });
+    
+    events.addEventListener('settled', (event) => {
+        const data = JSON.parse(event.data);
+        const text = data.text.trim();
+        if (text.length > 0) {
+            currentDisplayedWord = text;
+            currentWordEl.textContent = text;
+        }
+    });
+    
+    events.addEventListener('module_error', (event) => {
+        const data = JSON.parse(event.data);
+        showToast(`Module ${data.index}: ${data.state.replace(/_/g, ' ')}`, 'error');
+    });
+    
+    events.onerror = () => {
+        // EventSource reconnects by itself
+        statusText.textContent = 'Connection error';
+        statusIndicator.classList.remove('connected');
+        sendButton.disabled = true;
+    };
+}
+
+// Initialize app
+async function init() {
+    console.log('Initializing app...');
+    
+    // Initialize display first
+    initializeDisplay();
+    
+    // Create alphabet keyboard with default alphabet
+    createAlphabetKeyboard();
+    
+    // Initialize current word display
+    currentWordEl.textContent = '---';
+    
+    // Load history from device
+    await loadHistory();
+    
+    // Check admin mode
+    await checkAdminMode();
+    
+    // Initial status check
+    await updateStatus();
+    
+    // Follow live events, or fall back to periodic status updates
+    if (window.EventSource) {
+        connectEvents();
+    } else {
+        setInterval(updateStatus, UPDATE_INTERVAL);
+    }
+    
+    console.log('App initialized');
+}
+
+// Start the app
+document.addEventListener('DOMContentLoaded', init);
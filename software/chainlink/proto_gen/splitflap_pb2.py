@@ -20,7 +20,7 @@ DESCRIPTOR = _descriptor.FileDescriptor(
   syntax='proto3',
   serialized_options=None,
   create_key=_descriptor._internal_create_key,
-  serialized_pb=b'\n\x0fsplitflap.proto\x12\x02PB\x1a\x0cnanopb.proto\"\x84\x03\n\x0eSplitflapState\x12\x37\n\x07modules\x18\x01 \x03(\x0b\x32\x1e.PB.SplitflapState.ModuleStateB\x06\x92?\x03\x10\xff\x01\x12\x14\n\x0cloopbacks_ok\x18\x02 \x01(\x08\x1a\xa2\x02\n\x0bModuleState\x12\x33\n\x05state\x18\x01 \x01(\x0e\x32$.PB.SplitflapState.ModuleState.State\x12\x19\n\nflap_index\x18\x02 \x01(\rB\x05\x92?\x02\x38\x08\x12\x0e\n\x06moving\x18\x03 \x01(\x08\x12\x12\n\nhome_state\x18\x04 \x01(\x08\x12$\n\x15\x63ount_unexpected_home\x18\x05 \x01(\rB\x05\x92?\x02\x38\x08\x12 \n\x11\x63ount_missed_home\x18\x06 \x01(\rB\x05\x92?\x02\x38\x08\"W\n\x05State\x12\n\n\x06NORMAL\x10\x00\x12\x11\n\rLOOK_FOR_HOME\x10\x01\x12\x10\n\x0cSENSOR_ERROR\x10\x02\x12\t\n\x05PANIC\x10\x03\x12\x12\n\x0eSTATE_DISABLED\x10\x04\"\x1a\n\x03Log\x12\x13\n\x03msg\x18\x01 \x01(\tB\x06\x92?\x03p\xff\x01\"\x14\n\x03\x41\x63k\x12\r\n\x05nonce\x18\x01 \x01(\r\"\xa4\x05\n\x0fSupervisorState\x12\x15\n\ruptime_millis\x18\x01 \x01(\r\x12(\n\x05state\x18\x02 \x01(\x0e\x32\x19.PB.SupervisorState.State\x12\x44\n\x0epower_channels\x18\x03 \x03(\x0b\x32%.PB.SupervisorState.PowerChannelStateB\x05\x92?\x02\x10\x05\x12\x31\n\nfault_info\x18\x04 \x01(\x0b\x32\x1d.PB.SupervisorState.FaultInfo\x1aL\n\x11PowerChannelState\x12\x15\n\rvoltage_volts\x18\x01 \x01(\x02\x12\x14\n\x0c\x63urrent_amps\x18\x02 \x01(\x02\x12\n\n\x02on\x18\x03 \x01(\x08\x1a\x81\x02\n\tFaultInfo\x12\x35\n\x04type\x18\x01 \x01(\x0e\x32\'.PB.SupervisorState.FaultInfo.FaultType\x12\x13\n\x03msg\x18\x02 \x01(\tB\x06\x92?\x03p\xff\x01\x12\x11\n\tts_millis\x18\x03 \x01(\r\"\x94\x01\n\tFaultType\x12\x0b\n\x07UNKNOWN\x10\x00\x12\x08\n\x04NONE\x10\x01\x12\x1e\n\x1aINRUSH_CURRENT_NOT_SETTLED\x10\x02\x12\x16\n\x12SPLITFLAP_SHUTDOWN\x10\x03\x12\x10\n\x0cOUT_OF_RANGE\x10\x04\x12\x10\n\x0cOVER_CURRENT\x10\x05\x12\x14\n\x10UNEXPECTED_POWER\x10\x06\"\x84\x01\n\x05State\x12\x0b\n\x07UNKNOWN\x10\x00\x12\x1b\n\x17STARTING_VERIFY_PSU_OFF\x10\x01\x12\x1c\n\x18STARTING_VERIFY_VOLTAGES\x10\x02\x12\x1c\n\x18STARTING_ENABLE_CHANNELS\x10\x03\x12\n\n\x06NORMAL\x10\x04\x12\t\n\x05\x46\x41ULT\x10\x05\"\xfa\x01\n\x0cGeneralState\x12&\n\x17serial_protocol_version\x18\x01 \x01(\rB\x05\x92?\x02\x38\x10\x12\x15\n\ruptime_millis\x18\x02 \x01(\r\x12.\n\nbuild_info\x18\x03 \x01(\x0b\x32\x1a.PB.GeneralState.BuildInfo\x12!\n\x12\x66lap_character_set\x18\x04 \x01(\x0c\x42\x05\x92?\x02\x08P\x1aX\n\tBuildInfo\x12\x17\n\x08git_hash\x18\x01 \x01(\tB\x05\x92?\x02pZ\x12\x19\n\nbuild_date\x18\x02 \x01(\tB\x05\x92?\x02p\x0c\x12\x17\n\x08\x62uild_os\x18\x03 \x01(\tB\x05\x92?\x02p\x0c\"\xd5\x01\n\rFromSplitflap\x12-\n\x0fsplitflap_state\x18\x01 \x01(\x0b\x32\x12.PB.SplitflapStateH\x00\x12\x16\n\x03log\x18\x02 \x01(\x0b\x32\x07.PB.LogH\x00\x12\x16\n\x03\x61\x63k\x18\x03 \x01(\x0b\x32\x07.PB.AckH\x00\x12/\n\x10supervisor_state\x18\x04 \x01(\x0b\x32\x13.PB.SupervisorStateH\x00\x12)\n\rgeneral_state\x18\x05 \x01(\x0b\x32\x10.PB.GeneralStateH\x00\x42\t\n\x07payload\"\xca\x02\n\x10SplitflapCommand\x12;\n\x07modules\x18\x02 \x03(\x0b\x32\".PB.SplitflapCommand.ModuleCommandB\x06\x92?\x03\x10\xff\x01\x12\x18\n\x10save_all_offsets\x18\x03 \x01(\x08\x1a\xde\x01\n\rModuleCommand\x12\x39\n\x06\x61\x63tion\x18\x01 \x01(\x0e\x32).PB.SplitflapCommand.ModuleCommand.Action\x12\x14\n\x05param\x18\x02 \x01(\rB\x05\x92?\x02\x38\x08\"|\n\x06\x41\x63tion\x12\t\n\x05NO_OP\x10\x00\x12\x0e\n\nGO_TO_FLAP\x10\x01\x12\x12\n\x0eRESET_AND_HOME\x10\x02\x12\x19\n\x15INCREASE_OFFSET_TENTH\x10Z\x12\x18\n\x14INCREASE_OFFSET_HALF\x10[\x12\x0e\n\nSET_OFFSET\x10\\\"\xb9\x01\n\x0fSplitflapConfig\x12\x39\n\x07modules\x18\x01 \x03(\x0b\x32 .PB.SplitflapConfig.ModuleConfigB\x06\x92?\x03\x10\xff\x01\x1ak\n\x0cModuleConfig\x12 \n\x11target_flap_index\x18\x01 \x01(\rB\x05\x92?\x02\x38\x08\x12\x1d\n\x0emovement_nonce\x18\x02 \x01(\rB\x05\x92?\x02\x38\x08\x12\x1a\n\x0breset_nonce\x18\x03 \x01(\rB\x05\x92?\x02\x38\x08\"\x0e\n\x0cRequestState\"\xb6\x01\n\x0bToSplitflap\x12\r\n\x05nonce\x18\x01 \x01(\r\x12\x31\n\x11splitflap_command\x18\x02 \x01(\x0b\x32\x14.PB.SplitflapCommandH\x00\x12/\n\x10splitflap_config\x18\x03 \x01(\x0b\x32\x13.PB.SplitflapConfigH\x00\x12)\n\rrequest_state\x18\x04 \x01(\x0b\x32\x10.PB.RequestStateH\x00\x42\t\n\x07payload\"g\n\x17PersistentConfiguration\x12\x0f\n\x07version\x18\x01 \x01(\r\x12\x11\n\tnum_flaps\x18\x02 \x01(\r\x12(\n\x13module_offset_steps\x18\x03 \x03(\rB\x0b\x92?\x03\x10\xff\x01\x92?\x02\x38\x10\x62\x06proto3'
+  serialized_pb=b'\n\x0fsplitflap.proto\x12\x02PB\x1a\x0cnanopb.proto\"\xbe\x03\n\x0eSplitflapState\x12\x37\n\x07modules\x18\x01 \x03(\x0b\x32\x1e.PB.SplitflapState.ModuleStateB\x06\x92?\x03\x10\xff\x01\x12\x14\n\x0cloopbacks_ok\x18\x02 \x01(\x08\x12\x10\n\x08sequence\x18\x03 \x01(\r\x12\x10\n\x08is_delta\x18\x04 \x01(\x08\x1a\xb8\x02\n\x0bModuleState\x12\x33\n\x05state\x18\x01 \x01(\x0e\x32$.PB.SplitflapState.ModuleState.State\x12\x19\n\nflap_index\x18\x02 \x01(\rB\x05\x92?\x02\x38\x08\x12\x0e\n\x06moving\x18\x03 \x01(\x08\x12\x12\n\nhome_state\x18\x04 \x01(\x08\x12$\n\x15\x63ount_unexpected_home\x18\x05 \x01(\rB\x05\x92?\x02\x38\x08\x12 \n\x11\x63ount_missed_home\x18\x06 \x01(\rB\x05\x92?\x02\x38\x08\x12\x14\n\x05index\x18\x07 \x01(\rB\x05\x92?\x02\x38\x08\"W\n\x05State\x12\n\n\x06NORMAL\x10\x00\x12\x11\n\rLOOK_FOR_HOME\x10\x01\x12\x10\n\x0cSENSOR_ERROR\x10\x02\x12\t\n\x05PANIC\x10\x03\x12\x12\n\x0eSTATE_DISABLED\x10\x04\"\x1a\n\x03Log\x12\x13\n\x03msg\x18\x01 \x01(\tB\x06\x92?\x03p\xff\x01\"\x14\n\x03\x41\x63k\x12\r\n\x05nonce\x18\x01 \x01(\r\"\xa4\x05\n\x0fSupervisorState\x12\x15\n\ruptime_millis\x18\x01 \x01(\r\x12(\n\x05state\x18\x02 \x01(\x0e\x32\x19.PB.SupervisorState.State\x12\x44\n\x0epower_channels\x18\x03 \x03(\x0b\x32%.PB.SupervisorState.PowerChannelStateB\x05\x92?\x02\x10\x05\x12\x31\n\nfault_info\x18\x04 \x01(\x0b\x32\x1d.PB.SupervisorState.FaultInfo\x1aL\n\x11PowerChannelState\x12\x15\n\rvoltage_volts\x18\x01 \x01(\x02\x12\x14\n\x0c\x63urrent_amps\x18\x02 \x01(\x02\x12\n\n\x02on\x18\x03 \x01(\x08\x1a\x81\x02\n\tFaultInfo\x12\x35\n\x04type\x18\x01 \x01(\x0e\x32\'.PB.SupervisorState.FaultInfo.FaultType\x12\x13\n\x03msg\x18\x02 \x01(\tB\x06\x92?\x03p\xff\x01\x12\x11\n\tts_millis\x18\x03 \x01(\r\"\x94\x01\n\tFaultType\x12\x0b\n\x07UNKNOWN\x10\x00\x12\x08\n\x04NONE\x10\x01\x12\x1e\n\x1aINRUSH_CURRENT_NOT_SETTLED\x10\x02\x12\x16\n\x12SPLITFLAP_SHUTDOWN\x10\x03\x12\x10\n\x0cOUT_OF_RANGE\x10\x04\x12\x10\n\x0cOVER_CURRENT\x10\x05\x12\x14\n\x10UNEXPECTED_POWER\x10\x06\"\x84\x01\n\x05State\x12\x0b\n\x07UNKNOWN\x10\x00\x12\x1b\n\x17STARTING_VERIFY_PSU_OFF\x10\x01\x12\x1c\n\x18STARTING_VERIFY_VOLTAGES\x10\x02\x12\x1c\n\x18STARTING_ENABLE_CHANNELS\x10\x03\x12\n\n\x06NORMAL\x10\x04\x12\t\n\x05\x46\x41ULT\x10\x05\"\xea\x03\n\x0cGeneralState\x12&\n\x17serial_protocol_version\x18\x01 \x01(\rB\x05\x92?\x02\x38\x10\x12\x15\n\ruptime_millis\x18\x02 \x01(\r\x12.\n\nbuild_info\x18\x03 \x01(\x0b\x32\x1a.PB.GeneralState.BuildInfo\x12!\n\x12\x66lap_character_set\x18\x04 \x01(\x0c\x42\x05\x92?\x02\x08P\x12\x1a\n\x0bnum_modules\x18\x05 \x01(\rB\x05\x92?\x02\x38\x08\x12\x19\n\nack_window\x18\x06 \x01(\rB\x05\x92?\x02\x38\x08\x12\x36\n\x08tx_stats\x18\x07 \x03(\x0b\x32\x1d.PB.GeneralState.TxClassStatsB\x05\x92?\x02\x10\x04\x12\x11\n\tbaud_rate\x18\x08 \x01(\r\x12\x15\n\rmax_baud_rate\x18\t \x01(\r\x1aX\n\tBuildInfo\x12\x17\n\x08git_hash\x18\x01 \x01(\tB\x05\x92?\x02pZ\x12\x19\n\nbuild_date\x18\x02 \x01(\tB\x05\x92?\x02p\x0c\x12\x17\n\x08\x62uild_os\x18\x03 \x01(\tB\x05\x92?\x02p\x0c\x1aU\n\x0cTxClassStats\x12\r\n\x05\x62ytes\x18\x01 \x01(\r\x12\x10\n\x08messages\x18\x02 \x01(\r\x12\x11\n\theld_back\x18\x03 \x01(\r\x12\x11\n\tdiscarded\x18\x04 \x01(\r\"\x99\x01\n\x0c\x43ommandTrace\x12\r\n\x05nonce\x18\x01 \x01(\r\x12\x17\n\x0freceived_micros\x18\x02 \x01(\r\x12\x15\n\rposted_micros\x18\x03 \x01(\r\x12\x17\n\x0f\x64\x65queued_micros\x18\x04 \x01(\r\x12\x19\n\x11\x66irst_step_micros\x18\x05 \x01(\r\x12\x16\n\x0esettled_micros\x18\x06 \x01(\r\"N\n\tClockSync\x12\x13\n\x0bhost_micros\x18\x01 \x01(\x04\x12\x17\n\x0freceived_micros\x18\x02 \x01(\r\x12\x13\n\x0bsent_micros\x18\x03 \x01(\r\"\xa5\x02\n\rFromSplitflap\x12-\n\x0fsplitflap_state\x18\x01 \x01(\x0b\x32\x12.PB.SplitflapStateH\x00\x12\x16\n\x03log\x18\x02 \x01(\x0b\x32\x07.PB.LogH\x00\x12\x16\n\x03\x61\x63k\x18\x03 \x01(\x0b\x32\x07.PB.AckH\x00\x12/\n\x10supervisor_state\x18\x04 \x01(\x0b\x32\x13.PB.SupervisorStateH\x00\x12)\n\rgeneral_state\x18\x05 \x01(\x0b\x32\x10.PB.GeneralStateH\x00\x12)\n\rcommand_trace\x18\x06 \x01(\x0b\x32\x10.PB.CommandTraceH\x00\x12#\n\nclock_sync\x18\x07 \x01(\x0b\x32\r.PB.ClockSyncH\x00\x42\t\n\x07payload\"\xca\x02\n\x10SplitflapCommand\x12;\n\x07modules\x18\x02 \x03(\x0b\x32\".PB.SplitflapCommand.ModuleCommandB\x06\x92?\x03\x10\xff\x01\x12\x18\n\x10save_all_offsets\x18\x03 \x01(\x08\x1a\xde\x01\n\rModuleCommand\x12\x39\n\x06\x61\x63tion\x18\x01 \x01(\x0e\x32).PB.SplitflapCommand.ModuleCommand.Action\x12\x14\n\x05param\x18\x02 \x01(\rB\x05\x92?\x02\x38\x08\"|\n\x06\x41\x63tion\x12\t\n\x05NO_OP\x10\x00\x12\x0e\n\nGO_TO_FLAP\x10\x01\x12\x12\n\x0eRESET_AND_HOME\x10\x02\x12\x19\n\x15INCREASE_OFFSET_TENTH\x10Z\x12\x18\n\x14INCREASE_OFFSET_HALF\x10[\x12\x0e\n\nSET_OFFSET\x10\\\"\xb9\x01\n\x0fSplitflapConfig\x12\x39\n\x07modules\x18\x01 \x03(\x0b\x32 .PB.SplitflapConfig.ModuleConfigB\x06\x92?\x03\x10\xff\x01\x1ak\n\x0cModuleConfig\x12 \n\x11target_flap_index\x18\x01 \x01(\rB\x05\x92?\x02\x38\x08\x12\x1d\n\x0emovement_nonce\x18\x02 \x01(\rB\x05\x92?\x02\x38\x08\x12\x1a\n\x0breset_nonce\x18\x03 \x01(\rB\x05\x92?\x02\x38\x08\"h\n\x0eSplitflapFrame\x12\x1c\n\x0c\x66lap_indexes\x18\x01 \x01(\x0c\x42\x06\x92?\x03\x08\xc0\x01\x12\x1b\n\x0cstart_module\x18\x02 \x01(\rB\x05\x92?\x02\x38\x08\x12\x1b\n\x0cmodule_count\x18\x03 \x01(\rB\x05\x92?\x02\x38\x08\" \n\x0bSetBaudRate\x12\x11\n\tbaud_rate\x18\x01 \x01(\r\"<\n\x0cRequestState\x12\x14\n\x0cstate_deltas\x18\x01 \x01(\x08\x12\x16\n\x0e\x63ommand_traces\x18\x02 \x01(\x08\"\xb4\x02\n\x0bToSplitflap\x12\r\n\x05nonce\x18\x01 \x01(\r\x12\x31\n\x11splitflap_command\x18\x02 \x01(\x0b\x32\x14.PB.SplitflapCommandH\x00\x12/\n\x10splitflap_config\x18\x03 \x01(\x0b\x32\x13.PB.SplitflapConfigH\x00\x12)\n\rrequest_state\x18\x04 \x01(\x0b\x32\x10.PB.RequestStateH\x00\x12-\n\x0fsplitflap_frame\x18\x05 \x01(\x0b\x32\x12.PB.SplitflapFrameH\x00\x12(\n\rset_baud_rate\x18\x06 \x01(\x0b\x32\x0f.PB.SetBaudRateH\x00\x12#\n\nclock_sync\x18\x07 \x01(\x0b\x32\r.PB.ClockSyncH\x00\x42\t\n\x07payload\"g\n\x17PersistentConfiguration\x12\x0f\n\x07version\x18\x01 \x01(\r\x12\x11\n\tnum_flaps\x18\x02 \x01(\r\x12(\n\x13module_offset_steps\x18\x03 \x03(\rB\x0b\x92?\x03\x10\xff\x01\x92?\x02\x38\x10\x62\x06proto3'
   ,
   dependencies=[nanopb__pb2.DESCRIPTOR,])
 
@@ -61,8 +61,8 @@ _SPLITFLAPSTATE_MODULESTATE_STATE = _descriptor.EnumDescriptor(
   ],
   containing_type=None,
   serialized_options=None,
-  serialized_start=339,
-  serialized_end=426,
+  serialized_start=397,
+  serialized_end=484,
 )
 _sym_db.RegisterEnumDescriptor(_SPLITFLAPSTATE_MODULESTATE_STATE)
 
@@ -111,8 +111,8 @@ _SUPERVISORSTATE_FAULTINFO_FAULTTYPE = _descriptor.EnumDescriptor(
   ],
   containing_type=None,
   serialized_options=None,
-  serialized_start=872,
-  serialized_end=1020,
+  serialized_start=930,
+  serialized_end=1078,
 )
 _sym_db.RegisterEnumDescriptor(_SUPERVISORSTATE_FAULTINFO_FAULTTYPE)
 
@@ -156,8 +156,8 @@ _SUPERVISORSTATE_STATE = _descriptor.EnumDescriptor(
   ],
   containing_type=None,
   serialized_options=None,
-  serialized_start=1023,
-  serialized_end=1155,
+  serialized_start=1081,
+  serialized_end=1213,
 )
 _sym_db.RegisterEnumDescriptor(_SUPERVISORSTATE_STATE)
 
@@ -201,8 +201,8 @@ _SPLITFLAPCOMMAND_MODULECOMMAND_ACTION = _descriptor.EnumDescriptor(
   ],
   containing_type=None,
   serialized_options=None,
-  serialized_start=1833,
-  serialized_end=1957,
+  serialized_start=2447,
+  serialized_end=2571,
 )
 _sym_db.RegisterEnumDescriptor(_SPLITFLAPCOMMAND_MODULECOMMAND_ACTION)
 
@@ -257,6 +257,13 @@ _SPLITFLAPSTATE_MODULESTATE = _descriptor.Descriptor(
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=b'\222?\0028\010', file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='index', full_name='PB.SplitflapState.ModuleState.index', index=6,
+      number=7, type=13, cpp_type=3, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=b'\222?\0028\010', file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
   ],
   extensions=[
   ],
@@ -270,8 +277,8 @@ _SPLITFLAPSTATE_MODULESTATE = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=136,
-  serialized_end=426,
+  serialized_start=172,
+  serialized_end=484,
 )
 
 _SPLITFLAPSTATE = _descriptor.Descriptor(
@@ -296,6 +303,20 @@ _SPLITFLAPSTATE = _descriptor.Descriptor(
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='sequence', full_name='PB.SplitflapState.sequence', index=2,
+      number=3, type=13, cpp_type=3, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='is_delta', full_name='PB.SplitflapState.is_delta', index=3,
+      number=4, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
   ],
   extensions=[
   ],
@@ -309,7 +330,7 @@ _SPLITFLAPSTATE = _descriptor.Descriptor(
   oneofs=[
   ],
   serialized_start=38,
-  serialized_end=426,
+  serialized_end=484,
 )
 
 
@@ -340,8 +361,8 @@ _LOG = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=428,
-  serialized_end=454,
+  serialized_start=486,
+  serialized_end=512,
 )
 
 
@@ -372,8 +393,8 @@ _ACK = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=456,
-  serialized_end=476,
+  serialized_start=514,
+  serialized_end=534,
 )
 
 
@@ -418,8 +439,8 @@ _SUPERVISORSTATE_POWERCHANNELSTATE = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=684,
-  serialized_end=760,
+  serialized_start=742,
+  serialized_end=818,
 )
 
 _SUPERVISORSTATE_FAULTINFO = _descriptor.Descriptor(
@@ -464,8 +485,8 @@ _SUPERVISORSTATE_FAULTINFO = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=763,
-  serialized_end=1020,
+  serialized_start=821,
+  serialized_end=1078,
 )
 
 _SUPERVISORSTATE = _descriptor.Descriptor(
@@ -517,8 +538,8 @@ _SUPERVISORSTATE = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=479,
-  serialized_end=1155,
+  serialized_start=537,
+  serialized_end=1213,
 )
 
 
@@ -563,8 +584,60 @@ _GENERALSTATE_BUILDINFO = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=1320,
-  serialized_end=1408,
+  serialized_start=1531,
+  serialized_end=1619,
+)
+
+_GENERALSTATE_TXCLASSSTATS = _descriptor.Descriptor(
+  name='TxClassStats',
+  full_name='PB.GeneralState.TxClassStats',
+  filename=None,
+  file=DESCRIPTOR,
+  containing_type=None,
+  create_key=_descriptor._internal_create_key,
+  fields=[
+    _descriptor.FieldDescriptor(
+      name='bytes', full_name='PB.GeneralState.TxClassStats.bytes', index=0,
+      number=1, type=13, cpp_type=3, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='messages', full_name='PB.GeneralState.TxClassStats.messages', index=1,
+      number=2, type=13, cpp_type=3, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='held_back', full_name='PB.GeneralState.TxClassStats.held_back', index=2,
+      number=3, type=13, cpp_type=3, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='discarded', full_name='PB.GeneralState.TxClassStats.discarded', index=3,
+      number=4, type=13, cpp_type=3, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+  ],
+  extensions=[
+  ],
+  nested_types=[],
+  enum_types=[
+  ],
+  serialized_options=None,
+  is_extendable=False,
+  syntax='proto3',
+  extension_ranges=[],
+  oneofs=[
+  ],
+  serialized_start=1621,
+  serialized_end=1706,
 )
 
 _GENERALSTATE = _descriptor.Descriptor(
@@ -603,10 +676,112 @@ _GENERALSTATE = _descriptor.Descriptor(
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=b'\222?\002\010P', file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='num_modules', full_name='PB.GeneralState.num_modules', index=4,
+      number=5, type=13, cpp_type=3, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=b'\222?\0028\010', file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='ack_window', full_name='PB.GeneralState.ack_window', index=5,
+      number=6, type=13, cpp_type=3, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=b'\222?\0028\010', file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='tx_stats', full_name='PB.GeneralState.tx_stats', index=6,
+      number=7, type=11, cpp_type=10, label=3,
+      has_default_value=False, default_value=[],
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=b'\222?\002\020\004', file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='baud_rate', full_name='PB.GeneralState.baud_rate', index=7,
+      number=8, type=13, cpp_type=3, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='max_baud_rate', full_name='PB.GeneralState.max_baud_rate', index=8,
+      number=9, type=13, cpp_type=3, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+  ],
+  extensions=[
+  ],
+  nested_types=[_GENERALSTATE_BUILDINFO, _GENERALSTATE_TXCLASSSTATS, ],
+  enum_types=[
+  ],
+  serialized_options=None,
+  is_extendable=False,
+  syntax='proto3',
+  extension_ranges=[],
+  oneofs=[
+  ],
+  serialized_start=1216,
+  serialized_end=1706,
+)
+
+
+_COMMANDTRACE = _descriptor.Descriptor(
+  name='CommandTrace',
+  full_name='PB.CommandTrace',
+  filename=None,
+  file=DESCRIPTOR,
+  containing_type=None,
+  create_key=_descriptor._internal_create_key,
+  fields=[
+    _descriptor.FieldDescriptor(
+      name='nonce', full_name='PB.CommandTrace.nonce', index=0,
+      number=1, type=13, cpp_type=3, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='received_micros', full_name='PB.CommandTrace.received_micros', index=1,
+      number=2, type=13, cpp_type=3, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='posted_micros', full_name='PB.CommandTrace.posted_micros', index=2,
+      number=3, type=13, cpp_type=3, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='dequeued_micros', full_name='PB.CommandTrace.dequeued_micros', index=3,
+      number=4, type=13, cpp_type=3, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='first_step_micros', full_name='PB.CommandTrace.first_step_micros', index=4,
+      number=5, type=13, cpp_type=3, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='settled_micros', full_name='PB.CommandTrace.settled_micros', index=5,
+      number=6, type=13, cpp_type=3, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
   ],
   extensions=[
   ],
-  nested_types=[_GENERALSTATE_BUILDINFO, ],
+  nested_types=[],
   enum_types=[
   ],
   serialized_options=None,
@@ -615,8 +790,54 @@ _GENERALSTATE = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=1158,
-  serialized_end=1408,
+  serialized_start=1709,
+  serialized_end=1862,
+)
+
+
+_CLOCKSYNC = _descriptor.Descriptor(
+  name='ClockSync',
+  full_name='PB.ClockSync',
+  filename=None,
+  file=DESCRIPTOR,
+  containing_type=None,
+  create_key=_descriptor._internal_create_key,
+  fields=[
+    _descriptor.FieldDescriptor(
+      name='host_micros', full_name='PB.ClockSync.host_micros', index=0,
+      number=1, type=4, cpp_type=4, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='received_micros', full_name='PB.ClockSync.received_micros', index=1,
+      number=2, type=13, cpp_type=3, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='sent_micros', full_name='PB.ClockSync.sent_micros', index=2,
+      number=3, type=13, cpp_type=3, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+  ],
+  extensions=[
+  ],
+  nested_types=[],
+  enum_types=[
+  ],
+  serialized_options=None,
+  is_extendable=False,
+  syntax='proto3',
+  extension_ranges=[],
+  oneofs=[
+  ],
+  serialized_start=1864,
+  serialized_end=1942,
 )
 
 
@@ -663,6 +884,20 @@ _FROMSPLITFLAP = _descriptor.Descriptor(
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='command_trace', full_name='PB.FromSplitflap.command_trace', index=5,
+      number=6, type=11, cpp_type=10, label=1,
+      has_default_value=False, default_value=None,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='clock_sync', full_name='PB.FromSplitflap.clock_sync', index=6,
+      number=7, type=11, cpp_type=10, label=1,
+      has_default_value=False, default_value=None,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
   ],
   extensions=[
   ],
@@ -680,8 +915,8 @@ _FROMSPLITFLAP = _descriptor.Descriptor(
       create_key=_descriptor._internal_create_key,
     fields=[]),
   ],
-  serialized_start=1411,
-  serialized_end=1624,
+  serialized_start=1945,
+  serialized_end=2238,
 )
 
 
@@ -720,8 +955,8 @@ _SPLITFLAPCOMMAND_MODULECOMMAND = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=1735,
-  serialized_end=1957,
+  serialized_start=2349,
+  serialized_end=2571,
 )
 
 _SPLITFLAPCOMMAND = _descriptor.Descriptor(
@@ -758,8 +993,8 @@ _SPLITFLAPCOMMAND = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=1627,
-  serialized_end=1957,
+  serialized_start=2241,
+  serialized_end=2571,
 )
 
 
@@ -804,8 +1039,8 @@ _SPLITFLAPCONFIG_MODULECONFIG = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=2038,
-  serialized_end=2145,
+  serialized_start=2652,
+  serialized_end=2759,
 )
 
 _SPLITFLAPCONFIG = _descriptor.Descriptor(
@@ -835,8 +1070,86 @@ _SPLITFLAPCONFIG = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=1960,
-  serialized_end=2145,
+  serialized_start=2574,
+  serialized_end=2759,
+)
+
+
+_SPLITFLAPFRAME = _descriptor.Descriptor(
+  name='SplitflapFrame',
+  full_name='PB.SplitflapFrame',
+  filename=None,
+  file=DESCRIPTOR,
+  containing_type=None,
+  create_key=_descriptor._internal_create_key,
+  fields=[
+    _descriptor.FieldDescriptor(
+      name='flap_indexes', full_name='PB.SplitflapFrame.flap_indexes', index=0,
+      number=1, type=12, cpp_type=9, label=1,
+      has_default_value=False, default_value=b"",
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=b'\222?\003\010\300\001', file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='start_module', full_name='PB.SplitflapFrame.start_module', index=1,
+      number=2, type=13, cpp_type=3, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=b'\222?\0028\010', file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='module_count', full_name='PB.SplitflapFrame.module_count', index=2,
+      number=3, type=13, cpp_type=3, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=b'\222?\0028\010', file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+  ],
+  extensions=[
+  ],
+  nested_types=[],
+  enum_types=[
+  ],
+  serialized_options=None,
+  is_extendable=False,
+  syntax='proto3',
+  extension_ranges=[],
+  oneofs=[
+  ],
+  serialized_start=2761,
+  serialized_end=2865,
+)
+
+
+_SETBAUDRATE = _descriptor.Descriptor(
+  name='SetBaudRate',
+  full_name='PB.SetBaudRate',
+  filename=None,
+  file=DESCRIPTOR,
+  containing_type=None,
+  create_key=_descriptor._internal_create_key,
+  fields=[
+    _descriptor.FieldDescriptor(
+      name='baud_rate', full_name='PB.SetBaudRate.baud_rate', index=0,
+      number=1, type=13, cpp_type=3, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+  ],
+  extensions=[
+  ],
+  nested_types=[],
+  enum_types=[
+  ],
+  serialized_options=None,
+  is_extendable=False,
+  syntax='proto3',
+  extension_ranges=[],
+  oneofs=[
+  ],
+  serialized_start=2867,
+  serialized_end=2899,
 )
 
 
@@ -848,6 +1161,20 @@ _REQUESTSTATE = _descriptor.Descriptor(
   containing_type=None,
   create_key=_descriptor._internal_create_key,
   fields=[
+    _descriptor.FieldDescriptor(
+      name='state_deltas', full_name='PB.RequestState.state_deltas', index=0,
+      number=1, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='command_traces', full_name='PB.RequestState.command_traces', index=1,
+      number=2, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
   ],
   extensions=[
   ],
@@ -860,8 +1187,8 @@ _REQUESTSTATE = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=2147,
-  serialized_end=2161,
+  serialized_start=2901,
+  serialized_end=2961,
 )
 
 
@@ -901,6 +1228,27 @@ _TOSPLITFLAP = _descriptor.Descriptor(
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='splitflap_frame', full_name='PB.ToSplitflap.splitflap_frame', index=4,
+      number=5, type=11, cpp_type=10, label=1,
+      has_default_value=False, default_value=None,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='set_baud_rate', full_name='PB.ToSplitflap.set_baud_rate', index=5,
+      number=6, type=11, cpp_type=10, label=1,
+      has_default_value=False, default_value=None,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='clock_sync', full_name='PB.ToSplitflap.clock_sync', index=6,
+      number=7, type=11, cpp_type=10, label=1,
+      has_default_value=False, default_value=None,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
   ],
   extensions=[
   ],
@@ -918,8 +1266,8 @@ _TOSPLITFLAP = _descriptor.Descriptor(
       create_key=_descriptor._internal_create_key,
     fields=[]),
   ],
-  serialized_start=2164,
-  serialized_end=2346,
+  serialized_start=2964,
+  serialized_end=3272,
 )
 
 
@@ -964,8 +1312,8 @@ _PERSISTENTCONFIGURATION = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=2348,
-  serialized_end=2451,
+  serialized_start=3274,
+  serialized_end=3377,
 )
 
 _SPLITFLAPSTATE_MODULESTATE.fields_by_name['state'].enum_type = _SPLITFLAPSTATE_MODULESTATE_STATE
@@ -981,12 +1329,16 @@ _SUPERVISORSTATE.fields_by_name['power_channels'].message_type = _SUPERVISORSTAT
 _SUPERVISORSTATE.fields_by_name['fault_info'].message_type = _SUPERVISORSTATE_FAULTINFO
 _SUPERVISORSTATE_STATE.containing_type = _SUPERVISORSTATE
 _GENERALSTATE_BUILDINFO.containing_type = _GENERALSTATE
+_GENERALSTATE_TXCLASSSTATS.containing_type = _GENERALSTATE
 _GENERALSTATE.fields_by_name['build_info'].message_type = _GENERALSTATE_BUILDINFO
+_GENERALSTATE.fields_by_name['tx_stats'].message_type = _GENERALSTATE_TXCLASSSTATS
 _FROMSPLITFLAP.fields_by_name['splitflap_state'].message_type = _SPLITFLAPSTATE
 _FROMSPLITFLAP.fields_by_name['log'].message_type = _LOG
 _FROMSPLITFLAP.fields_by_name['ack'].message_type = _ACK
 _FROMSPLITFLAP.fields_by_name['supervisor_state'].message_type = _SUPERVISORSTATE
 _FROMSPLITFLAP.fields_by_name['general_state'].message_type = _GENERALSTATE
+_FROMSPLITFLAP.fields_by_name['command_trace'].message_type = _COMMANDTRACE
+_FROMSPLITFLAP.fields_by_name['clock_sync'].message_type = _CLOCKSYNC
 _FROMSPLITFLAP.oneofs_by_name['payload'].fields.append(
   _FROMSPLITFLAP.fields_by_name['splitflap_state'])
 _FROMSPLITFLAP.fields_by_name['splitflap_state'].containing_oneof = _FROMSPLITFLAP.oneofs_by_name['payload']
@@ -1002,6 +1354,12 @@ _FROMSPLITFLAP.fields_by_name['supervisor_state'].containing_oneof = _FROMSPLITF
 _FROMSPLITFLAP.oneofs_by_name['payload'].fields.append(
   _FROMSPLITFLAP.fields_by_name['general_state'])
 _FROMSPLITFLAP.fields_by_name['general_state'].containing_oneof = _FROMSPLITFLAP.oneofs_by_name['payload']
+_FROMSPLITFLAP.oneofs_by_name['payload'].fields.append(
+  _FROMSPLITFLAP.fields_by_name['command_trace'])
+_FROMSPLITFLAP.fields_by_name['command_trace'].containing_oneof = _FROMSPLITFLAP.oneofs_by_name['payload']
+_FROMSPLITFLAP.oneofs_by_name['payload'].fields.append(
+  _FROMSPLITFLAP.fields_by_name['clock_sync'])
+_FROMSPLITFLAP.fields_by_name['clock_sync'].containing_oneof = _FROMSPLITFLAP.oneofs_by_name['payload']
 _SPLITFLAPCOMMAND_MODULECOMMAND.fields_by_name['action'].enum_type = _SPLITFLAPCOMMAND_MODULECOMMAND_ACTION
 _SPLITFLAPCOMMAND_MODULECOMMAND.containing_type = _SPLITFLAPCOMMAND
 _SPLITFLAPCOMMAND_MODULECOMMAND_ACTION.containing_type = _SPLITFLAPCOMMAND_MODULECOMMAND
@@ -1011,6 +1369,9 @@ _SPLITFLAPCONFIG.fields_by_name['modules'].message_type = _SPLITFLAPCONFIG_MODUL
 _TOSPLITFLAP.fields_by_name['splitflap_command'].message_type = _SPLITFLAPCOMMAND
 _TOSPLITFLAP.fields_by_name['splitflap_config'].message_type = _SPLITFLAPCONFIG
 _TOSPLITFLAP.fields_by_name['request_state'].message_type = _REQUESTSTATE
+_TOSPLITFLAP.fields_by_name['splitflap_frame'].message_type = _SPLITFLAPFRAME
+_TOSPLITFLAP.fields_by_name['set_baud_rate'].message_type = _SETBAUDRATE
+_TOSPLITFLAP.fields_by_name['clock_sync'].message_type = _CLOCKSYNC
 _TOSPLITFLAP.oneofs_by_name['payload'].fields.append(
   _TOSPLITFLAP.fields_by_name['splitflap_command'])
 _TOSPLITFLAP.fields_by_name['splitflap_command'].containing_oneof = _TOSPLITFLAP.oneofs_by_name['payload']
@@ -1020,14 +1381,27 @@ _TOSPLITFLAP.fields_by_name['splitflap_config'].containing_oneof = _TOSPLITFLAP.
 _TOSPLITFLAP.oneofs_by_name['payload'].fields.append(
   _TOSPLITFLAP.fields_by_name['request_state'])
 _TOSPLITFLAP.fields_by_name['request_state'].containing_oneof = _TOSPLITFLAP.oneofs_by_name['payload']
+_TOSPLITFLAP.oneofs_by_name['payload'].fields.append(
+  _TOSPLITFLAP.fields_by_name['splitflap_frame'])
+_TOSPLITFLAP.fields_by_name['splitflap_frame'].containing_oneof = _TOSPLITFLAP.oneofs_by_name['payload']
+_TOSPLITFLAP.oneofs_by_name['payload'].fields.append(
+  _TOSPLITFLAP.fields_by_name['set_baud_rate'])
+_TOSPLITFLAP.fields_by_name['set_baud_rate'].containing_oneof = _TOSPLITFLAP.oneofs_by_name['payload']
+_TOSPLITFLAP.oneofs_by_name['payload'].fields.append(
+  _TOSPLITFLAP.fields_by_name['clock_sync'])
+_TOSPLITFLAP.fields_by_name['clock_sync'].containing_oneof = _TOSPLITFLAP.oneofs_by_name['payload']
 DESCRIPTOR.message_types_by_name['SplitflapState'] = _SPLITFLAPSTATE
 DESCRIPTOR.message_types_by_name['Log'] = _LOG
 DESCRIPTOR.message_types_by_name['Ack'] = _ACK
 DESCRIPTOR.message_types_by_name['SupervisorState'] = _SUPERVISORSTATE
 DESCRIPTOR.message_types_by_name['GeneralState'] = _GENERALSTATE
+DESCRIPTOR.message_types_by_name['CommandTrace'] = _COMMANDTRACE
+DESCRIPTOR.message_types_by_name['ClockSync'] = _CLOCKSYNC
 DESCRIPTOR.message_types_by_name['FromSplitflap'] = _FROMSPLITFLAP
 DESCRIPTOR.message_types_by_name['SplitflapCommand'] = _SPLITFLAPCOMMAND
 DESCRIPTOR.message_types_by_name['SplitflapConfig'] = _SPLITFLAPCONFIG
+DESCRIPTOR.message_types_by_name['SplitflapFrame'] = _SPLITFLAPFRAME
+DESCRIPTOR.message_types_by_name['SetBaudRate'] = _SETBAUDRATE
 DESCRIPTOR.message_types_by_name['RequestState'] = _REQUESTSTATE
 DESCRIPTOR.message_types_by_name['ToSplitflap'] = _TOSPLITFLAP
 DESCRIPTOR.message_types_by_name['PersistentConfiguration'] = _PERSISTENTCONFIGURATION
@@ -1093,12 +1467,34 @@ GeneralState = _reflection.GeneratedProtocolMessageType('GeneralState', (_messag
     # @@protoc_insertion_point(class_scope:PB.GeneralState.BuildInfo)
     })
   ,
+
+  'TxClassStats' : _reflection.GeneratedProtocolMessageType('TxClassStats', (_message.Message,), {
+    'DESCRIPTOR' : _GENERALSTATE_TXCLASSSTATS,
+    '__module__' : 'splitflap_pb2'
+    # @@protoc_insertion_point(class_scope:PB.GeneralState.TxClassStats)
+    })
+  ,
   'DESCRIPTOR' : _GENERALSTATE,
   '__module__' : 'splitflap_pb2'
   # @@protoc_insertion_point(class_scope:PB.GeneralState)
   })
 _sym_db.RegisterMessage(GeneralState)
 _sym_db.RegisterMessage(GeneralState.BuildInfo)
+_sym_db.RegisterMessage(GeneralState.TxClassStats)
+
+CommandTrace = _reflection.GeneratedProtocolMessageType('CommandTrace', (_message.Message,), {
+  'DESCRIPTOR' : _COMMANDTRACE,
+  '__module__' : 'splitflap_pb2'
+  # @@protoc_insertion_point(class_scope:PB.CommandTrace)
+  })
+_sym_db.RegisterMessage(CommandTrace)
+
+ClockSync = _reflection.GeneratedProtocolMessageType('ClockSync', (_message.Message,), {
+  'DESCRIPTOR' : _CLOCKSYNC,
+  '__module__' : 'splitflap_pb2'
+  # @@protoc_insertion_point(class_scope:PB.ClockSync)
+  })
+_sym_db.RegisterMessage(ClockSync)
 
 FromSplitflap = _reflection.GeneratedProtocolMessageType('FromSplitflap', (_message.Message,), {
   'DESCRIPTOR' : _FROMSPLITFLAP,
@@ -1137,6 +1533,20 @@ SplitflapConfig = _reflection.GeneratedProtocolMessageType('SplitflapConfig', (_
 _sym_db.RegisterMessage(SplitflapConfig)
 _sym_db.RegisterMessage(SplitflapConfig.ModuleConfig)
 
+SplitflapFrame = _reflection.GeneratedProtocolMessageType('SplitflapFrame', (_message.Message,), {
+  'DESCRIPTOR' : _SPLITFLAPFRAME,
+  '__module__' : 'splitflap_pb2'
+  # @@protoc_insertion_point(class_scope:PB.SplitflapFrame)
+  })
+_sym_db.RegisterMessage(SplitflapFrame)
+
+SetBaudRate = _reflection.GeneratedProtocolMessageType('SetBaudRate', (_message.Message,), {
+  'DESCRIPTOR' : _SETBAUDRATE,
+  '__module__' : 'splitflap_pb2'
+  # @@protoc_insertion_point(class_scope:PB.SetBaudRate)
+  })
+_sym_db.RegisterMessage(SetBaudRate)
+
 RequestState = _reflection.GeneratedProtocolMessageType('RequestState', (_message.Message,), {
   'DESCRIPTOR' : _REQUESTSTATE,
   '__module__' : 'splitflap_pb2'
@@ -1162,6 +1572,7 @@ _sym_db.RegisterMessage(PersistentConfiguration)
 _SPLITFLAPSTATE_MODULESTATE.fields_by_name['flap_index']._options = None
 _SPLITFLAPSTATE_MODULESTATE.fields_by_name['count_unexpected_home']._options = None
 _SPLITFLAPSTATE_MODULESTATE.fields_by_name['count_missed_home']._options = None
+_SPLITFLAPSTATE_MODULESTATE.fields_by_name['index']._options = None
 _SPLITFLAPSTATE.fields_by_name['modules']._options = None
 _LOG.fields_by_name['msg']._options = None
 _SUPERVISORSTATE_FAULTINFO.fields_by_name['msg']._options = None
@@ -1171,11 +1582,17 @@ _GENERALSTATE_BUILDINFO.fields_by_name['build_date']._options = None
 _GENERALSTATE_BUILDINFO.fields_by_name['build_os']._options = None
 _GENERALSTATE.fields_by_name['serial_protocol_version']._options = None
 _GENERALSTATE.fields_by_name['flap_character_set']._options = None
+_GENERALSTATE.fields_by_name['num_modules']._options = None
+_GENERALSTATE.fields_by_name['ack_window']._options = None
+_GENERALSTATE.fields_by_name['tx_stats']._options = None
 _SPLITFLAPCOMMAND_MODULECOMMAND.fields_by_name['param']._options = None
 _SPLITFLAPCOMMAND.fields_by_name['modules']._options = None
 _SPLITFLAPCONFIG_MODULECONFIG.fields_by_name['target_flap_index']._options = None
 _SPLITFLAPCONFIG_MODULECONFIG.fields_by_name['movement_nonce']._options = None
 _SPLITFLAPCONFIG_MODULECONFIG.fields_by_name['reset_nonce']._options = None
 _SPLITFLAPCONFIG.fields_by_name['modules']._options = None
+_SPLITFLAPFRAME.fields_by_name['flap_indexes']._options = None
+_SPLITFLAPFRAME.fields_by_name['start_module']._options = None
+_SPLITFLAPFRAME.fields_by_name['module_count']._options = None
 _PERSISTENTCONFIGURATION.fields_by_name['module_offset_steps']._options = None
 # @@protoc_insertion_point(module_scope)
@@ -2,6 +2,7 @@ import argparse
 from cobs import cobs
 from collections import (
     defaultdict,
+    OrderedDict,
 )
 from contextlib import contextmanager
 from enum import Enum
@@ -31,6 +32,9 @@ from proto_gen import splitflap_pb2
 
 SPLITFLAP_BAUD = 230400
 
+# SplitflapFrame flap index that leaves a module as it is
+FRAME_UNCHANGED = 0x3F
+
 
 class Splitflap(object):
 
@@ -41,6 +45,13 @@ class Splitflap(object):
 
     RETRY_TIMEOUT = 0.25
 
+    # Attempts at confirming a new baud rate before going back to the previous one
+    BAUD_RATE_VERIFY_ATTEMPTS = 4
+
+    # Consecutive corrupt packets after which the host falls back to the default baud rate (the splitflap does the
+    # same when it gets corrupt packets)
+    BAUD_RATE_FALLBACK_BAD_PACKETS = 3
+
     _LEGACY_ALPHABET = [
         ' ', 'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I',
         'J', 'K', 'L', 'M', 'N', 'O', 'P', 'Q', 'R', 'S',
@@ -48,7 +59,10 @@ class Splitflap(object):
         '3', '4', '5', '6', '7', '8', '9', '.', ',', "'",
     ]
 
-    def __init__(self, serial_instance):
+    # Number of recent clock sync samples the clock offset estimate is based on
+    CLOCK_SYNC_SAMPLES = 8
+
+    def __init__(self, serial_instance, state_deltas=True, command_traces=False):
         self._serial = serial_instance
         self._logger = logging.getLogger('splitflap')
         self._out_q = Queue()
@@ -62,9 +76,31 @@ class Splitflap(object):
         self._current_config = splitflap_pb2.SplitflapConfig()
         self._num_modules = None
 
+        # Full SplitflapState, reconstructed from keyframes and deltas
+        self._state_deltas = state_deltas
+        self._state = None
+        self._state_sequence = None
+        self._keyframe_requested = False
+
         self._alphabet = Splitflap._LEGACY_ALPHABET
         self._alphabet_received = False
 
+        # Max number of messages in flight at once, as advertised by the splitflap (firmware that doesn't advertise
+        # a window only de-duplicates retries of the latest message, so must be sent one message at a time)
+        self._ack_window = 1
+
+        # Highest baud rate the splitflap can switch to (0 if unknown or switching isn't supported)
+        self._max_baud_rate = 0
+        self._bad_packets = 0
+
+        # If enabled, the splitflap sends a CommandTrace for every command; _sent_micros keeps the host time each
+        # recent message was first sent, so traces can include the host-to-device latency
+        self._command_traces = command_traces
+        self._sent_micros = OrderedDict()
+
+        # Recent (delay, offset) clock sync samples; the offset is device micros - host micros, modulo 2^32
+        self._clock_samples = []
+
     def _read_loop(self):
         self._logger.debug('Read loop started')
         buffer = b''
@@ -88,9 +124,11 @@ class Splitflap(object):
         except cobs.DecodeError:
             self._logger.debug(f'Failed decode ({len(frame)} bytes)')
             self._logger.debug(frame)
+            self._bad_packet()
             return
 
         if len(decoded) < 4:
+            self._bad_packet()
             return
 
         payload = decoded[:-4]
@@ -102,8 +140,11 @@ class Splitflap(object):
         
         if expected_crc != provided_crc:
             self._logger.debug(f'Bad CRC. expected={hex(expected_crc)}, actual={hex(provided_crc)}')
+            self._bad_packet()
             return
 
+        self._bad_packets = 0
+
         message = splitflap_pb2.FromSplitflap()
         message.ParseFromString(payload)
         self._logger.debug(message)
@@ -115,6 +156,12 @@ class Splitflap(object):
             nonce = message.ack.nonce
             self._ack_q.put(nonce)
         elif payload_type == 'splitflap_state':
+            state = self._apply_state(message.splitflap_state)
+            if state is None:
+                return
+            # Handlers always get the full state, whether this was a keyframe or a delta
+            message.splitflap_state.CopyFrom(state)
+
             num_modules_reported = len(message.splitflap_state.modules)
             if self._num_modules is None:
                 self._num_modules = num_modules_reported
@@ -122,9 +169,14 @@ class Splitflap(object):
                     self._current_config.modules.append(splitflap_pb2.SplitflapConfig.ModuleConfig())
             else:
                 assert self._num_modules == num_modules_reported, f'Number of reported modules changed (was {self._num_modules}, now {num_modules_reported})'
-        elif payload_type == 'general_state' and not self._alphabet_received:
-            self._alphabet_received = True
-            self._alphabet = list(message.general_state.flap_character_set.decode('utf-8'))
+        elif payload_type == 'clock_sync':
+            self._add_clock_sample(message.clock_sync)
+        elif payload_type == 'general_state':
+            self._ack_window = max(1, message.general_state.ack_window)
+            self._max_baud_rate = message.general_state.max_baud_rate
+            if not self._alphabet_received:
+                self._alphabet_received = True
+                self._alphabet = list(message.general_state.flap_character_set.decode('utf-8'))
 
         with self._lock:
             for handler in self._message_handlers[payload_type] + self._message_handlers[None]:
@@ -133,41 +185,175 @@ class Splitflap(object):
                 except:
                     self._logger.warning(f'Unhandled exception in message handler ({payload_type})', exc_info=True)
     
+    @staticmethod
+    def _host_micros():
+        return int(time.monotonic() * 1000000)
+
+    def _add_clock_sample(self, clock_sync):
+        # As with NTP, assume the request and response took equally long
+        host_received = Splitflap._host_micros() & 0xffffffff
+        host_sent = clock_sync.host_micros & 0xffffffff
+        delay = ((host_received - host_sent) - (clock_sync.sent_micros - clock_sync.received_micros)) & 0xffffffff
+        # Average of the offsets seen in each direction (which only differ by about the delay, so their difference
+        # doesn't wrap even though the offsets themselves can be anything)
+        outbound = (clock_sync.received_micros - host_sent) & 0xffffffff
+        inbound = (clock_sync.sent_micros - host_received) & 0xffffffff
+        offset = (outbound + _signed32((inbound - outbound) & 0xffffffff) // 2) & 0xffffffff
+        self._clock_samples = (self._clock_samples + [(delay, offset)])[-Splitflap.CLOCK_SYNC_SAMPLES:]
+
+    def _clock_offset(self):
+        """Device micros - host micros (modulo 2^32), from the clock sync sample with the lowest delay."""
+        if not self._clock_samples:
+            return None
+        return min(self._clock_samples)[1]
+
+    def _bad_packet(self):
+        self._bad_packets += 1
+        if self._bad_packets >= Splitflap.BAUD_RATE_FALLBACK_BAD_PACKETS and self._serial.baudrate != SPLITFLAP_BAUD:
+            self._logger.warning(f'Too many corrupt packets at {self._serial.baudrate} baud; falling back to {SPLITFLAP_BAUD}')
+            self._serial.baudrate = SPLITFLAP_BAUD
+            self._bad_packets = 0
+
+    def _apply_state(self, update):
+        """Applies a SplitflapState keyframe or delta, returning the full state, or None if the delta couldn't be applied."""
+        expected_sequence = None if self._state_sequence is None else (self._state_sequence + 1) & 0xffffffff
+        self._state_sequence = update.sequence
+
+        if not update.is_delta:
+            self._state = splitflap_pb2.SplitflapState()
+            self._state.CopyFrom(update)
+            self._keyframe_requested = False
+            return self._state
+
+        if self._state is None or update.sequence != expected_sequence:
+            # Missed a message (or haven't had a keyframe yet), so the delta can't be applied; wait for a new keyframe
+            self._state = None
+            if not self._keyframe_requested:
+                self._logger.debug(f'Missed state update (expected sequence {expected_sequence}, got {update.sequence}); requesting keyframe')
+                self._keyframe_requested = True
+                self.request_state()
+            return None
+
+        for module in update.modules:
+            self._state.modules[module.index].CopyFrom(module)
+            self._state.modules[module.index].ClearField('index')
+        self._state.loopbacks_ok = update.loopbacks_ok
+        self._state.sequence = update.sequence
+        return self._state
+
     def _write_loop(self):
         self._logger.debug('Write loop started')
+
+        # Messages that have been sent but not acked yet, in the order they were sent: nonce -> [encoded_message, next_retry]
+        in_flight = OrderedDict()
+        # A baud rate change waiting for everything in flight to be acked first
+        baud_rate_change = None
         while True:
-            data = self._out_q.get()
-            # Check for shutdown
-            if not self._run:
-                self._logger.debug('Write loop exiting @ _out_q')
-                return
-            (nonce, encoded_message) = data
-
-            next_retry = 0
-            while True:
-                if time.time() >= next_retry:
-                    if next_retry > 0:
-                        self._logger.debug('Retry write...')
-                    self._serial.write(encoded_message)
-                    self._serial.write(b'\0')
-                    next_retry = time.time() + Splitflap.RETRY_TIMEOUT
-                
+            if baud_rate_change is not None and len(in_flight) == 0:
+                if not self._change_baud_rate(*baud_rate_change, in_flight):
+                    self._logger.debug('Write loop exiting @ baud rate change')
+                    return
+                baud_rate_change = None
+
+            # Send new messages until the window is full (only blocking for a new message if nothing is in flight)
+            while len(in_flight) < self._ack_window and baud_rate_change is None:
                 try:
-                    latest_ack_nonce = self._ack_q.get(timeout=next_retry - time.time())
+                    data = self._out_q.get(block=len(in_flight) == 0)
                 except Empty:
-                    latest_ack_nonce = None
-
+                    break
                 # Check for shutdown
                 if not self._run:
-                    self._logger.debug('Write loop exiting @ _ack_q')
+                    self._logger.debug('Write loop exiting @ _out_q')
                     return
-
-                if latest_ack_nonce == nonce:
+                (nonce, encoded_message, change) = data
+                if change is not None:
+                    baud_rate_change = (nonce, encoded_message) + change
                     break
-                else:
-                    self._logger.debug(f'Got unexpected nonce: {latest_ack_nonce}')
+                self._write_frame(encoded_message)
+                in_flight[nonce] = [encoded_message, time.time() + Splitflap.RETRY_TIMEOUT]
+                if self._command_traces:
+                    self._sent_micros[nonce] = Splitflap._host_micros()
+                    while len(self._sent_micros) > 256:
+                        self._sent_micros.popitem(last=False)
+
+            if len(in_flight) == 0:
+                continue
+
+            next_retry = min(retry for (_, retry) in in_flight.values())
+            try:
+                latest_ack_nonce = self._ack_q.get(timeout=max(0, next_retry - time.time()))
+            except Empty:
+                latest_ack_nonce = None
+
+            # Check for shutdown
+            if not self._run:
+                self._logger.debug('Write loop exiting @ _ack_q')
+                return
+
+            if latest_ack_nonce in in_flight:
+                del in_flight[latest_ack_nonce]
+            elif latest_ack_nonce is not None:
+                self._logger.debug(f'Got unexpected nonce: {latest_ack_nonce}')
+
+            # Retry anything that's timed out, oldest first
+            now = time.time()
+            for entry in in_flight.values():
+                if now >= entry[1]:
+                    self._logger.debug('Retry write...')
+                    self._write_frame(entry[0])
+                    entry[1] = now + Splitflap.RETRY_TIMEOUT
+
+    def _change_baud_rate(self, nonce, encoded_message, baud_rate, ping_nonce, encoded_ping, in_flight):
+        """Sends a SetBaudRate message and switches to the new rate once it's acked, then confirms the link works with a
+        ping (falling back to the previous rate if it doesn't). Must be called with nothing in flight. Returns False on
+        shutdown."""
+        while True:
+            acked = self._send_and_wait_for_ack(nonce, encoded_message)
+            if acked is None:
+                return False
+            if acked:
+                break
+
+        previous_baud_rate = self._serial.baudrate
+        self._serial.flush()
+        self._serial.baudrate = baud_rate
+        self._bad_packets = 0
+        for _ in range(Splitflap.BAUD_RATE_VERIFY_ATTEMPTS):
+            acked = self._send_and_wait_for_ack(ping_nonce, encoded_ping)
+            if acked is None:
+                return False
+            if acked:
+                self._logger.info(f'Changed baud rate to {baud_rate}')
+                return True
+
+        # The splitflap goes back to the previous rate too, either because it never got the ping or because of the
+        # corrupt packets it gets in the meantime; the ping is retried like any other message until it gets through
+        self._logger.warning(f'Failed to change baud rate to {baud_rate}; staying at {previous_baud_rate}')
+        self._serial.baudrate = previous_baud_rate
+        self._write_frame(encoded_ping)
+        in_flight[ping_nonce] = [encoded_ping, time.time() + Splitflap.RETRY_TIMEOUT]
+        return True
+
+    def _send_and_wait_for_ack(self, nonce, encoded_message):
+        """Sends a message and waits up to RETRY_TIMEOUT for its ack. Returns None on shutdown."""
+        self._write_frame(encoded_message)
+        deadline = time.time() + Splitflap.RETRY_TIMEOUT
+        while True:
+            try:
+                ack_nonce = self._ack_q.get(timeout=max(0, deadline - time.time()))
+            except Empty:
+                return False
+            if not self._run:
+                return None
+            if ack_nonce == nonce:
+                return True
+            self._logger.debug(f'Got unexpected nonce: {ack_nonce}')
+
+    def _write_frame(self, encoded_message):
+        self._serial.write(encoded_message)
+        self._serial.write(b'\0')
     
-    def _enqueue_message(self, message):
+    def _encode_message(self, message):
         nonce = self._next_nonce
         self._next_nonce += 1
 
@@ -181,9 +367,11 @@ class Splitflap(object):
         payload.append((crc >> 16) & 0xff)
         payload.append((crc >> 24) & 0xff)
 
-        encoded_message = cobs.encode(payload)
+        return (nonce, cobs.encode(payload))
 
-        self._out_q.put((nonce, encoded_message))
+    def _enqueue_message(self, message):
+        (nonce, encoded_message) = self._encode_message(message)
+        self._out_q.put((nonce, encoded_message, None))
 
         approx_q_length = self._out_q.qsize()
         self._logger.debug(f'Out q length: {approx_q_length}')
@@ -227,6 +415,41 @@ class Splitflap(object):
         message.splitflap_config.CopyFrom(self._current_config)
         self._enqueue_message(message)
 
+    def set_frame(self, positions, start_module=0):
+        """Sends flap indexes packed 6 bits per module, which is much smaller than a full config for big displays.
+
+        A position of None leaves that module as it is. Unlike set_positions, there's no way to force movement to the
+        same flap. Requires serial protocol version 6 or later."""
+        packed = 0
+        for i, position in enumerate(positions):
+            if position is None:
+                position = FRAME_UNCHANGED
+            else:
+                assert 0 <= position < FRAME_UNCHANGED, f'Bad flap index {position}'
+            packed |= position << (6 * i)
+
+        message = splitflap_pb2.ToSplitflap()
+        message.splitflap_frame.flap_indexes = packed.to_bytes((len(positions) * 6 + 7) // 8, 'little')
+        message.splitflap_frame.start_module = start_module
+        message.splitflap_frame.module_count = len(positions)
+        self._enqueue_message(message)
+
+    def set_baud_rate(self, baud_rate):
+        """Switches the serial link to a faster (or slower) baud rate, once everything already sent has been acked.
+        If the new rate doesn't work, both sides go back to the previous one. Requires serial protocol version 7 or
+        later; wait for a general_state message first."""
+        assert self._max_baud_rate > 0, 'Splitflap does not support changing baud rate (or has not reported it yet)'
+        assert baud_rate <= self._max_baud_rate, f'Baud rate {baud_rate} is higher than the maximum ({self._max_baud_rate})'
+
+        message = splitflap_pb2.ToSplitflap()
+        message.set_baud_rate.baud_rate = baud_rate
+        (nonce, encoded_message) = self._encode_message(message)
+
+        # Confirm the new rate with a state request, which also gets a GeneralState reporting the new rate
+        (ping_nonce, encoded_ping) = self._encode_message(self._request_state_message())
+
+        self._out_q.put((nonce, encoded_message, (baud_rate, ping_nonce, encoded_ping)))
+
     def start(self):
         self.read_thread = Thread(target=self._read_loop)
         self.write_thread = Thread(target=self._write_loop)
@@ -252,11 +475,43 @@ class Splitflap(object):
         with self._lock:
             self._message_handlers[message_type].remove(handler)
 
-    def request_state(self):
+    def _request_state_message(self):
         message = splitflap_pb2.ToSplitflap()
         message.request_state.SetInParent()
+        message.request_state.state_deltas = self._state_deltas
+        message.request_state.command_traces = self._command_traces
+        return message
+
+    def request_state(self):
+        self._enqueue_message(self._request_state_message())
+
+    def sync_clock(self):
+        """Sends a clock sync request; call a few times (e.g. once a second) to get a good estimate of the clock offset,
+        which trace_breakdown needs for host-to-device latency. Requires serial protocol version 8 or later."""
+        message = splitflap_pb2.ToSplitflap()
+        message.clock_sync.host_micros = Splitflap._host_micros()
         self._enqueue_message(message)
 
+    def trace_breakdown(self, trace):
+        """Given a CommandTrace (see add_handler('command_trace', ...)), returns the time spent in each stage in
+        milliseconds. Stages that didn't happen are omitted; host_to_device needs a clock sync first."""
+        stages = [
+            ('decode', trace.received_micros, trace.posted_micros),
+            ('queue', trace.posted_micros, trace.dequeued_micros),
+            ('start', trace.dequeued_micros, trace.first_step_micros),
+            ('motion', trace.first_step_micros, trace.settled_micros),
+        ]
+        breakdown = {name: ((end - start) & 0xffffffff) / 1000 for (name, start, end) in stages if start and end}
+
+        offset = self._clock_offset()
+        sent = self._sent_micros.get(trace.nonce)
+        if offset is not None and sent is not None:
+            sent_device_micros = (sent + offset) & 0xffffffff
+            breakdown['host_to_device'] = _signed32((trace.received_micros - sent_device_micros) & 0xffffffff) / 1000
+            if trace.settled_micros:
+                breakdown['total'] = ((trace.settled_micros - sent_device_micros) & 0xffffffff) / 1000
+        return breakdown
+
     def hard_reset(self):
         self._serial.setRTS(True)
         self._serial.setDTR(False)
@@ -271,7 +526,8 @@ class Splitflap(object):
 
 @contextmanager
 def splitflap_context(serial_port, default_logging=True, wait_for_comms=True):
-    with serial.Serial(serial_port, SPLITFLAP_BAUD, timeout=1.0) as ser:
+    # Also accepts pyserial URLs, e.g. socket://<host>:6970 for a splitflap with PROTO_SERVER enabled
+    with serial.serial_for_url(serial_port, SPLITFLAP_BAUD, timeout=1.0) as ser:
         s = Splitflap(ser)
         s.start()
 
@@ -299,6 +555,10 @@ def splitflap_context(serial_port, default_logging=True, wait_for_comms=True):
             s.shutdown()
 
 
+def _signed32(value):
+    return value - 0x100000000 if value & 0x80000000 else value
+
+
 def ask_for_serial_port():
     print('Available ports:')
     ports = sorted(
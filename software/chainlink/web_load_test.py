@@ -0,0 +1,86 @@
+#!/usr/bin/env python3
+
+"""Load test for the ESP32 web server: sends GET requests from several threads for a fixed time, then reports
+requests/sec and latency percentiles.
+
+The server closes the connection after every response (ESP Async WebServer doesn't support keep-alive), so each
+request pays for a new TCP connection; that's included in the latencies reported.
+"""
+
+import argparse
+import threading
+import time
+
+import requests
+
+
+def worker(url, auth, deadline, timeout, latencies, errors, lock):
+    session = requests.Session()
+    while time.monotonic() < deadline:
+        start = time.monotonic()
+        try:
+            response = session.get(url, auth=auth, timeout=timeout)
+            response.content  # Read the whole body, so the latency covers it
+            ok = response.status_code == 200
+            error = f"HTTP {response.status_code}"
+        except requests.RequestException as e:
+            ok = False
+            error = type(e).__name__
+        elapsed = time.monotonic() - start
+        with lock:
+            if ok:
+                latencies.append(elapsed)
+            else:
+                errors[error] = errors.get(error, 0) + 1
+
+
+def percentile(sorted_values, p):
+    index = min(len(sorted_values) - 1, int(round(p / 100 * (len(sorted_values) - 1))))
+    return sorted_values[index]
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Load test the ESP32 web server')
+    parser.add_argument('url', help='Device URL, e.g. http://192.168.1.100')
+    parser.add_argument('--path', action='append',
+                        help='Path to request (may be repeated to test several, one after another; default /status)')
+    parser.add_argument('--concurrency', type=int, default=4, help='Number of concurrent clients (default 4)')
+    parser.add_argument('--duration', type=float, default=10, help='Seconds to run each path for (default 10)')
+    parser.add_argument('--timeout', type=float, default=10, help='Per-request timeout in seconds (default 10)')
+    parser.add_argument('--username', help='Username, for paths that need authentication (e.g. /admin/status)')
+    parser.add_argument('--password', help='Password, for paths that need authentication')
+    args = parser.parse_args()
+
+    auth = (args.username, args.password) if args.username is not None else None
+    base_url = args.url.rstrip('/')
+
+    for path in args.path or ['/status']:
+        url = base_url + path
+        latencies = []
+        errors = {}
+        lock = threading.Lock()
+        deadline = time.monotonic() + args.duration
+        threads = [threading.Thread(target=worker, args=(url, auth, deadline, args.timeout, latencies, errors, lock))
+                   for _ in range(args.concurrency)]
+        start = time.monotonic()
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+        elapsed = time.monotonic() - start
+
+        print(f'{url} ({args.concurrency} concurrent clients, {elapsed:.1f}s)')
+        print(f'  Requests:     {len(latencies)} ok, {sum(errors.values())} failed')
+        for error, count in sorted(errors.items()):
+            print(f'    {error}: {count}')
+        print(f'  Requests/sec: {len(latencies) / elapsed:.1f}')
+        if latencies:
+            latencies.sort()
+            print(f'  Latency (ms): p50 {percentile(latencies, 50) * 1000:.1f}, '
+                  f'p90 {percentile(latencies, 90) * 1000:.1f}, '
+                  f'p99 {percentile(latencies, 99) * 1000:.1f}, '
+                  f'max {latencies[-1] * 1000:.1f}')
+
+
+if __name__ == '__main__':
+    main()